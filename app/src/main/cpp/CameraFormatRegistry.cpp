@@ -0,0 +1,309 @@
+// ==================== CameraFormatRegistry.cpp ====================
+// 按需註冊相機像素格式與每幀轉換緩存
+
+#include "CameraFormatRegistry.h"
+
+namespace VuforiaWrapper {
+
+    CameraFormatRegistry::CameraFormatRegistry()
+        : mDirty(false)
+        , mConversionCount(0)
+        , mCacheHitCount(0)
+        , mPassthroughCount(0) {
+        for (auto& state : mFormats) {
+            state.requestCount = 0;
+            state.registered = false;
+            state.unsupported = false;
+        }
+    }
+
+    int CameraFormatRegistry::formatIndex(VuImagePixelFormat format) {
+        const int index = static_cast<int>(format);
+        if (index <= static_cast<int>(VU_IMAGE_PIXEL_FORMAT_UNKNOWN) || index >= MAX_FORMAT_INDEX) {
+            return -1;
+        }
+        return index;
+    }
+
+    int32_t CameraFormatRegistry::bytesPerPixel(VuImagePixelFormat format) {
+        switch (format) {
+            case VU_IMAGE_PIXEL_FORMAT_RGB888:
+                return 3;
+            case VU_IMAGE_PIXEL_FORMAT_RGBA8888:
+                return 4;
+            case VU_IMAGE_PIXEL_FORMAT_GRAYSCALE:
+                return 1;
+            default:
+                return 0;  // wrapper 不支持轉換到該格式
+        }
+    }
+
+    // ==================== 消費者接口 ====================
+
+    bool CameraFormatRegistry::requestFormat(VuImagePixelFormat format) {
+        const int index = formatIndex(format);
+        if (index < 0) {
+            LOGW("⚠️ Invalid pixel format request: %d", static_cast<int>(format));
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFormats[index].requestCount++ == 0) {
+            mDirty.store(true, std::memory_order_release);
+            LOGI("📷 Pixel format 0x%x requested", static_cast<int>(format));
+        }
+        return true;
+    }
+
+    void CameraFormatRegistry::releaseFormat(VuImagePixelFormat format) {
+        const int index = formatIndex(format);
+        if (index < 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        FormatState& state = mFormats[index];
+        if (state.requestCount <= 0) {
+            LOGW("⚠️ Unbalanced release of pixel format 0x%x", static_cast<int>(format));
+            return;
+        }
+        if (--state.requestCount == 0) {
+            mDirty.store(true, std::memory_order_release);
+            // 沒有消費者了，轉換緩存也不再需要
+            mCaches[index].current.reset();
+            mCaches[index].pool.clear();
+            LOGI("📷 Pixel format 0x%x released", static_cast<int>(format));
+        }
+    }
+
+    bool CameraFormatRegistry::getImage(const CameraFrameData& frame, VuImagePixelFormat format,
+                                        FormatImageView& view) {
+        if (!frame.hasImage()) {
+            return false;
+        }
+
+        // 原生格式直接返回
+        if (frame.format == format) {
+            view.format = format;
+            view.data = frame.buffer;
+            view.width = frame.width;
+            view.height = frame.height;
+            view.stride = frame.stride;
+            view.converted = false;
+            view.keepAlive = frame.image;
+            return true;
+        }
+
+        // 相機已經提供該格式（已註冊）
+        const CameraImageView* registered = frame.findExtraImage(format);
+        if (registered != nullptr && registered->buffer != nullptr) {
+            view.format = format;
+            view.data = registered->buffer;
+            view.width = registered->width;
+            view.height = registered->height;
+            view.stride = registered->stride;
+            view.converted = false;
+            view.keepAlive = registered->image;
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mPassthroughCount;
+            return true;
+        }
+
+        const int index = formatIndex(format);
+        if (index < 0 || bytesPerPixel(format) == 0) {
+            return false;
+        }
+
+        // 鎖內只查緩存並從池中預留輸出圖像；轉換在鎖外進行，
+        // 其他格式的讀者和渲染線程的格式同步不會等待整幀轉換
+        std::shared_ptr<ConvertedImage> image;
+        bool cacheHit = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ConversionCache& cache = mCaches[index];
+            if (cache.current && cache.current->timestamp == frame.timestamp) {
+                ++mCacheHitCount;
+                image = cache.current;
+                cacheHit = true;
+            } else {
+                image = takeFreeImageLocked(cache);
+            }
+        }
+
+        if (!cacheHit) {
+            // 預留的圖像由本線程獨佔（池外多持有一個引用，不會再被預留）
+            if (!convert(frame, format, *image)) {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mConversionCount;
+            // 同一幀被多個讀者同時轉換時保留任意一份；不用舊幀覆蓋新幀
+            ConversionCache& cache = mCaches[index];
+            if (!cache.current || cache.current->timestamp <= frame.timestamp) {
+                cache.current = image;
+            }
+        }
+
+        view.format = format;
+        view.data = image->pixels.data();
+        view.width = image->width;
+        view.height = image->height;
+        view.stride = image->stride;
+        view.converted = true;
+        view.keepAlive = image;
+        return true;
+    }
+
+    std::shared_ptr<CameraFormatRegistry::ConvertedImage> CameraFormatRegistry::takeFreeImageLocked(
+        ConversionCache& cache) {
+        // 只被池持有的對象可以重用（當前結果由 cache.current 額外持有）
+        for (auto& image : cache.pool) {
+            if (image.use_count() == 1) {
+                return image;
+            }
+        }
+        cache.pool.push_back(std::make_shared<ConvertedImage>());
+        return cache.pool.back();
+    }
+
+    bool CameraFormatRegistry::convert(const CameraFrameData& frame, VuImagePixelFormat format,
+                                       ConvertedImage& image) {
+        ImageConversion::YuvPlanes planes;
+        if (!frame.getYuvPlanes(planes)) {
+            return false;
+        }
+
+        const size_t rowBytes = static_cast<size_t>(frame.width) * bytesPerPixel(format);
+        const int32_t stride = static_cast<int32_t>(
+            (rowBytes + ImageConversion::IMAGE_BUFFER_ALIGNMENT - 1) &
+            ~(ImageConversion::IMAGE_BUFFER_ALIGNMENT - 1));
+        image.timestamp = -1;
+        if (!image.pixels.resize(static_cast<size_t>(stride) * frame.height)) {
+            return false;
+        }
+
+        bool converted = false;
+        switch (format) {
+            case VU_IMAGE_PIXEL_FORMAT_RGB888:
+                converted = ImageConversion::convertYuvToRgb(planes, image.pixels.data(), stride);
+                break;
+            case VU_IMAGE_PIXEL_FORMAT_RGBA8888:
+                converted = ImageConversion::convertYuvToRgba(planes, image.pixels.data(), stride);
+                break;
+            case VU_IMAGE_PIXEL_FORMAT_GRAYSCALE:
+                converted = ImageConversion::convertYuvToGray(planes, image.pixels.data(), stride);
+                break;
+            default:
+                break;
+        }
+        if (!converted) {
+            return false;
+        }
+
+        image.format = format;
+        image.timestamp = frame.timestamp;
+        image.width = frame.width;
+        image.height = frame.height;
+        image.stride = stride;
+        return true;
+    }
+
+    // ==================== 渲染線程接口 ====================
+
+    void CameraFormatRegistry::applyPending(VuController* cameraController) {
+        if (cameraController == nullptr || !mDirty.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        // 讀取相機控制器當前實際註冊的格式
+        bool active[MAX_FORMAT_INDEX] = {};
+        VuImagePixelFormatList* list = nullptr;
+        if (vuImagePixelFormatListCreate(&list) == VU_SUCCESS && list != nullptr) {
+            if (vuCameraControllerGetRegisteredImageFormats(cameraController, list) == VU_SUCCESS) {
+                int32_t size = 0;
+                vuImagePixelFormatListGetSize(list, &size);
+                for (int32_t i = 0; i < size; ++i) {
+                    VuImagePixelFormat format = VU_IMAGE_PIXEL_FORMAT_UNKNOWN;
+                    vuImagePixelFormatListGetElement(list, i, &format);
+                    const int index = formatIndex(format);
+                    if (index >= 0) {
+                        active[index] = true;
+                    }
+                }
+            }
+            vuImagePixelFormatListDestroy(list);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (int index = 0; index < MAX_FORMAT_INDEX; ++index) {
+            FormatState& state = mFormats[index];
+            const VuImagePixelFormat format = static_cast<VuImagePixelFormat>(index);
+            const bool wanted = state.requestCount > 0;
+
+            if (wanted && !active[index] && !state.unsupported) {
+                VuResult result = vuCameraControllerRegisterImageFormat(cameraController, format);
+                if (result == VU_SUCCESS) {
+                    state.registered = true;
+                    LOGI("✅ Registered camera pixel format 0x%x", index);
+                } else {
+                    // 相機無法提供該格式，之後由 wrapper 轉換
+                    state.unsupported = true;
+                    LOGW("⚠️ Camera cannot deliver pixel format 0x%x (%d), converting on demand",
+                         index, result);
+                }
+            } else if (wanted && active[index]) {
+                state.registered = true;
+            } else if (!wanted && active[index] && state.registered) {
+                // 只註銷我們註冊的格式
+                vuCameraControllerUnregisterImageFormat(cameraController, format);
+                state.registered = false;
+                LOGI("📷 Unregistered camera pixel format 0x%x", index);
+            } else if (!wanted) {
+                state.registered = false;
+            }
+        }
+    }
+
+    void CameraFormatRegistry::invalidateRegistrations() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& state : mFormats) {
+            state.unsupported = false;
+        }
+        mDirty.store(true, std::memory_order_release);
+    }
+
+    void CameraFormatRegistry::clearCache() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& cache : mCaches) {
+            cache.current.reset();
+            cache.pool.clear();
+        }
+    }
+
+    std::string CameraFormatRegistry::getStatus() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::ostringstream status;
+        status << "Requested Formats:";
+        bool any = false;
+        for (int index = 0; index < MAX_FORMAT_INDEX; ++index) {
+            const FormatState& state = mFormats[index];
+            if (state.requestCount <= 0) {
+                continue;
+            }
+            any = true;
+            status << " 0x" << std::hex << index << std::dec << "(x" << state.requestCount
+                   << (state.registered ? ", registered" : "")
+                   << (state.unsupported ? ", converted" : "") << ")";
+        }
+        if (!any) {
+            status << " none";
+        }
+        status << "\n";
+        status << "Format Conversions: " << mConversionCount << ", cache hits " << mCacheHitCount
+               << ", passthrough " << mPassthroughCount << "\n";
+        return status.str();
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef CAMERA_FORMAT_REGISTRY_H
+#define CAMERA_FORMAT_REGISTRY_H
+
+// ==================== 相機像素格式登記表 ====================
+// 由消費者驅動的格式註冊：
+//  - 消費者通過 requestFormat / releaseFormat 聲明需要的格式（引用計數）
+//  - 渲染線程在下一幀把變化同步到相機控制器，只註冊被聲明的格式，
+//    不再需要的格式會被註銷
+//  - 請求未註冊（或相機不支持註冊）的格式時，每幀轉換一次並緩存結果；
+//    轉換在 mMutex 之外進行，同一幀被多個讀者同時請求時可能各轉換一次
+//  - 沒有任何消費者時，既不註冊也不轉換
+
+#include "VuforiaWrapper.h"
+#include "ImageConversion.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VuforiaWrapper {
+
+    // 指定格式的圖像視圖；keepAlive 持有底層緩衝區（相機圖像或轉換結果）
+    struct FormatImageView {
+        VuImagePixelFormat format;
+        const uint8_t* data;
+        int32_t width;
+        int32_t height;
+        int32_t stride;
+        bool converted;  // true = 由 wrapper 轉換，false = 相機直接提供
+        std::shared_ptr<const void> keepAlive;
+
+        FormatImageView() : format(VU_IMAGE_PIXEL_FORMAT_UNKNOWN), data(nullptr),
+                            width(0), height(0), stride(0), converted(false) {}
+    };
+
+    class CameraFormatRegistry {
+    public:
+        CameraFormatRegistry();
+
+        // ==================== 消費者接口（任意線程） ====================
+
+        // 聲明需要某個格式；返回 false 表示格式無效
+        bool requestFormat(VuImagePixelFormat format);
+
+        // 撤銷聲明，引用計數歸零後下一幀註銷
+        void releaseFormat(VuImagePixelFormat format);
+
+        /**
+         * 取得幀的指定格式圖像
+         * 已註冊的格式直接返回相機圖像，否則從原生 NV12 / NV21 轉換（每幀只轉換一次）
+         * @return 不支持的格式或轉換失敗時返回 false
+         */
+        bool getImage(const CameraFrameData& frame, VuImagePixelFormat format, FormatImageView& view);
+
+        // ==================== 渲染線程接口 ====================
+
+        // 是否有待同步到相機控制器的變化
+        bool needsSync() const { return mDirty.load(std::memory_order_acquire); }
+
+        // 把聲明同步到相機控制器（只能在引擎運行時調用）
+        void applyPending(VuController* cameraController);
+
+        // 引擎重新啟動後需要重新核對註冊狀態
+        void invalidateRegistrations();
+
+        // 釋放所有緩存的轉換結果
+        void clearCache();
+
+        std::string getStatus() const;
+
+    private:
+        // 像素格式值都很小（見 VuImagePixelFormat），直接用作索引
+        static constexpr int MAX_FORMAT_INDEX = 16;
+
+        struct FormatState {
+            int32_t requestCount;
+            bool registered;      // 當前已在相機控制器註冊（由我們註冊）
+            bool unsupported;     // 註冊失敗，改為轉換提供
+        };
+
+        struct ConvertedImage {
+            VuImagePixelFormat format;
+            int64_t timestamp;
+            int32_t width;
+            int32_t height;
+            int32_t stride;
+            ImageConversion::AlignedImageBuffer pixels;
+
+            ConvertedImage() : format(VU_IMAGE_PIXEL_FORMAT_UNKNOWN), timestamp(-1),
+                               width(0), height(0), stride(0) {}
+        };
+
+        struct ConversionCache {
+            std::shared_ptr<ConvertedImage> current;
+            std::vector<std::shared_ptr<ConvertedImage>> pool;
+        };
+
+        static int formatIndex(VuImagePixelFormat format);
+        static int32_t bytesPerPixel(VuImagePixelFormat format);
+
+        // 不加鎖：image 必須是調用者從池中預留、獨佔的對象
+        static bool convert(const CameraFrameData& frame, VuImagePixelFormat format, ConvertedImage& image);
+        // 預留一個只被池持有的對象；返回的引用使它在歸還前不會再被預留
+        std::shared_ptr<ConvertedImage> takeFreeImageLocked(ConversionCache& cache);
+
+        mutable std::mutex mMutex;
+        FormatState mFormats[MAX_FORMAT_INDEX];
+        ConversionCache mCaches[MAX_FORMAT_INDEX];
+        std::atomic<bool> mDirty;
+
+        uint64_t mConversionCount;
+        uint64_t mCacheHitCount;
+        uint64_t mPassthroughCount;
+    };
+}
+
+#endif // CAMERA_FORMAT_REGISTRY_H
@@ -0,0 +1,198 @@
+// ==================== FrameArena.cpp ====================
+// 每幀線性分配器與調試用堆分配統計
+
+#include "FrameArena.h"
+#include "WrapperLog.h"
+#include <cstdlib>
+#include <new>
+
+namespace VuforiaWrapper {
+
+    static inline size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    FrameArena::FrameArena(size_t blockSize)
+        : mCurrentBlock(0)
+        , mOffset(0)
+        , mBlockSize(blockSize)
+        , mBytesUsed(0)
+        , mHighWaterMark(0)
+        , mOverflowCount(0) {
+        mBlocks.reserve(4);
+    }
+
+    FrameArena::~FrameArena() {
+        for (auto& block : mBlocks) {
+            ::operator delete(block.data);
+        }
+        mBlocks.clear();
+    }
+
+    bool FrameArena::addBlock(size_t minSize) {
+        size_t size = mBlockSize > minSize ? mBlockSize : minSize;
+        // 經 operator new 分配，塊增長同樣計入幀內堆分配統計
+        uint8_t* data = static_cast<uint8_t*>(::operator new(size, std::nothrow));
+        if (data == nullptr) {
+            LOGE("❌ FrameArena failed to allocate %zu bytes", size);
+            return false;
+        }
+        mBlocks.push_back({data, size});
+        return true;
+    }
+
+    void* FrameArena::allocate(size_t size, size_t alignment) {
+        if (size == 0) {
+            size = 1;
+        }
+
+        // 先嘗試當前塊，再嘗試之後已經存在的塊
+        while (mCurrentBlock < mBlocks.size()) {
+            Block& block = mBlocks[mCurrentBlock];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            const size_t offset = alignUp(base + mOffset, alignment) - base;
+            if (offset + size <= block.size) {
+                mBytesUsed += (offset - mOffset) + size;
+                mOffset = offset + size;
+                return block.data + offset;
+            }
+            ++mCurrentBlock;
+            mOffset = 0;
+        }
+
+        // 所有塊都不夠 - 追加溢出塊（reset 時合併）
+        if (!mBlocks.empty()) {
+            ++mOverflowCount;
+        }
+        if (!addBlock(size + alignment)) {
+            throw std::bad_alloc();
+        }
+        mCurrentBlock = mBlocks.size() - 1;
+        Block& block = mBlocks[mCurrentBlock];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        const size_t offset = alignUp(base, alignment) - base;
+        mBytesUsed += offset + size;
+        mOffset = offset + size;
+        return block.data + offset;
+    }
+
+    void FrameArena::reset() {
+        if (mBytesUsed > mHighWaterMark) {
+            mHighWaterMark = mBytesUsed;
+        }
+
+        // 本幀用到了多個塊：合併成一個覆蓋峰值用量的塊，避免下一幀再溢出
+        if (mBlocks.size() > 1) {
+            const size_t total = getCapacity();
+            for (auto& block : mBlocks) {
+                ::operator delete(block.data);
+            }
+            mBlocks.clear();
+            if (mBlockSize < total) {
+                mBlockSize = total;
+            }
+            addBlock(mBlockSize);
+            LOGD("FrameArena grown to %zu bytes", mBlockSize);
+        }
+
+        mCurrentBlock = 0;
+        mOffset = 0;
+        mBytesUsed = 0;
+    }
+
+    size_t FrameArena::getCapacity() const {
+        size_t total = 0;
+        for (const auto& block : mBlocks) {
+            total += block.size;
+        }
+        return total;
+    }
+}
+
+// ==================== 幀內堆分配統計 ====================
+#if defined(ENABLE_FRAME_ALLOC_CHECK)
+
+namespace {
+    thread_local uint64_t tFrameAllocationCount = 0;
+    thread_local int tFrameAllocationDepth = 0;
+
+    inline void countAllocation() {
+        if (tFrameAllocationDepth > 0) {
+            ++tFrameAllocationCount;
+        }
+    }
+
+    inline void* countedMalloc(size_t size) {
+        countAllocation();
+        return malloc(size == 0 ? 1 : size);
+    }
+}
+
+// 替換全局 operator new / delete（只在調試統計構建中）
+void* operator new(size_t size) {
+    void* p = countedMalloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p = countedMalloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return countedMalloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return countedMalloc(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+
+namespace VuforiaWrapper {
+
+    FrameAllocationScope::FrameAllocationScope() : mStartCount(tFrameAllocationCount) {
+        ++tFrameAllocationDepth;
+    }
+
+    FrameAllocationScope::~FrameAllocationScope() {
+        --tFrameAllocationDepth;
+    }
+
+    uint64_t FrameAllocationScope::getAllocationCount() const {
+        return tFrameAllocationCount - mStartCount;
+    }
+
+    bool FrameAllocationScope::isEnabled() {
+        return true;
+    }
+}
+
+#else
+
+namespace VuforiaWrapper {
+
+    FrameAllocationScope::FrameAllocationScope() : mStartCount(0) {}
+    FrameAllocationScope::~FrameAllocationScope() = default;
+
+    uint64_t FrameAllocationScope::getAllocationCount() const {
+        return 0;
+    }
+
+    bool FrameAllocationScope::isEnabled() {
+        return false;
+    }
+}
+
+#endif // ENABLE_FRAME_ALLOC_CHECK
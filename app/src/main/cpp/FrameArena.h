@@ -0,0 +1,112 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+// ==================== 每幀線性分配器 ====================
+// 渲染 / 追蹤熱路徑使用的 bump 分配器：
+//  - 幀內只做指針前移，不逐個釋放，幀結束時 reset() 一次性回收
+//  - 當前塊不足時追加溢出塊；reset() 會把所有塊合併成一個足夠大的塊，
+//    因此預熱幾幀後穩態下不再向系統申請內存
+//  - ArenaVector 等容器只能在同一幀內使用，不能跨越 reset()
+//
+// 調試構建（ENABLE_FRAME_ALLOC_CHECK）會替換全局 operator new，
+// 統計 FrameAllocationScope 範圍內發生的堆分配次數
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VuforiaWrapper {
+
+    class FrameArena {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // 分配 size 字節（alignment 必須是 2 的冪），內存在 reset() 前有效
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        T* allocateArray(size_t count) {
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // 回收本幀所有分配；有溢出時合併成單塊供下一幀使用
+        void reset();
+
+        size_t getBytesUsed() const { return mBytesUsed; }
+        size_t getCapacity() const;
+        size_t getHighWaterMark() const { return mHighWaterMark; }
+        uint64_t getOverflowCount() const { return mOverflowCount; }
+
+    private:
+        struct Block {
+            uint8_t* data;
+            size_t size;
+        };
+
+        bool addBlock(size_t minSize);
+
+        std::vector<Block> mBlocks;
+        size_t mCurrentBlock;
+        size_t mOffset;
+        size_t mBlockSize;
+        size_t mBytesUsed;
+        size_t mHighWaterMark;
+        uint64_t mOverflowCount;
+    };
+
+    // 標準分配器適配 - 讓 std 容器從 FrameArena 取內存，deallocate 為空操作
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(FrameArena* arena) noexcept : mArena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : mArena(other.getArena()) {}
+
+        T* allocate(size_t count) { return mArena->allocateArray<T>(count); }
+        void deallocate(T*, size_t) noexcept {}
+
+        FrameArena* getArena() const noexcept { return mArena; }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept { return mArena == other.getArena(); }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept { return mArena != other.getArena(); }
+
+    private:
+        FrameArena* mArena;
+    };
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    // ==================== 幀內堆分配統計 ====================
+    // 只統計當前線程在作用域內的分配；未啟用 ENABLE_FRAME_ALLOC_CHECK 時為空操作
+    class FrameAllocationScope {
+    public:
+        FrameAllocationScope();
+        ~FrameAllocationScope();
+
+        FrameAllocationScope(const FrameAllocationScope&) = delete;
+        FrameAllocationScope& operator=(const FrameAllocationScope&) = delete;
+
+        // 作用域開始以來的堆分配次數
+        uint64_t getAllocationCount() const;
+
+        // 是否編譯了分配統計
+        static bool isEnabled();
+
+    private:
+        uint64_t mStartCount;
+    };
+}
+
+#endif // FRAME_ARENA_H
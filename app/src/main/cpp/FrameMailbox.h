@@ -0,0 +1,163 @@
+#ifndef FRAME_MAILBOX_H
+#define FRAME_MAILBOX_H
+
+// ==================== 無鎖幀郵箱 ====================
+// 單生產者 / 多讀者的多緩衝郵箱：
+//  - 生產者（渲染線程）永遠不會阻塞：找不到空閒槽位時直接丟棄該幀
+//  - 讀者只拿到最新已完成的幀，通過引用讀取，不做拷貝
+//  - 每個已發佈的幀都帶有遞增的序號，讀者可以跳過已經看過的幀
+//
+// 槽位回收依賴每槽位的讀者計數：讀者先增加計數，再確認槽位仍是
+// 已發佈槽位；生產者只會寫入「未發佈且讀者計數為 0」的槽位。
+// 兩側都使用 seq_cst 原子操作，保證這對檢查不會交錯出錯。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace VuforiaWrapper {
+
+    template <typename T, size_t N = 3>
+    class FrameMailbox {
+        static_assert(N >= 2, "FrameMailbox needs at least two slots");
+
+    private:
+        struct Slot {
+            T value;
+            std::atomic<uint32_t> readers{0};
+            uint64_t sequence = 0;  // 只在發佈前由生產者寫入
+        };
+
+    public:
+        // 讀取守衛 - 持有期間槽位不會被生產者覆寫
+        class ReadGuard {
+        public:
+            ReadGuard() : mSlot(nullptr) {}
+            ~ReadGuard() { release(); }
+
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            ReadGuard(ReadGuard&& other) noexcept : mSlot(other.mSlot) { other.mSlot = nullptr; }
+            ReadGuard& operator=(ReadGuard&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    mSlot = other.mSlot;
+                    other.mSlot = nullptr;
+                }
+                return *this;
+            }
+
+            explicit operator bool() const { return mSlot != nullptr; }
+            const T& operator*() const { return mSlot->value; }
+            const T* operator->() const { return &mSlot->value; }
+            const T* get() const { return mSlot != nullptr ? &mSlot->value : nullptr; }
+            uint64_t sequence() const { return mSlot != nullptr ? mSlot->sequence : 0; }
+
+            void release() {
+                if (mSlot != nullptr) {
+                    mSlot->readers.fetch_sub(1, std::memory_order_release);
+                    mSlot = nullptr;
+                }
+            }
+
+        private:
+            friend class FrameMailbox;
+            explicit ReadGuard(Slot* slot) : mSlot(slot) {}
+            Slot* mSlot;
+        };
+
+        FrameMailbox() : mPublished(-1), mWriteIndex(-1), mNextSequence(1), mDroppedFrames(0) {}
+
+        FrameMailbox(const FrameMailbox&) = delete;
+        FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+        // ==================== 生產者接口（單線程） ====================
+
+        // 取得一個可寫槽位；所有槽位都被讀者佔用時返回 nullptr（該幀丟棄）
+        T* beginWrite() {
+            const int32_t published = mPublished.load();
+            for (size_t i = 0; i < N; ++i) {
+                if (static_cast<int32_t>(i) == published) {
+                    continue;
+                }
+                if (mSlots[i].readers.load() == 0) {
+                    mWriteIndex = static_cast<int32_t>(i);
+                    return &mSlots[i].value;
+                }
+            }
+            mWriteIndex = -1;
+            mDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        // 發佈 beginWrite 取得的槽位，返回該幀序號
+        uint64_t commitWrite() {
+            if (mWriteIndex < 0) {
+                return 0;
+            }
+            Slot& slot = mSlots[mWriteIndex];
+            slot.sequence = mNextSequence.load(std::memory_order_relaxed);
+            mPublished.store(mWriteIndex);
+            mNextSequence.store(slot.sequence + 1, std::memory_order_release);
+            mWriteIndex = -1;
+            return slot.sequence;
+        }
+
+        // 放棄本次寫入（槽位保持未發佈）
+        void abortWrite() { mWriteIndex = -1; }
+
+        // 撤銷發佈並重置所有空閒槽位，只應在沒有讀者時調用（例如引擎清理）
+        void clear() {
+            mPublished.store(-1);
+            for (size_t i = 0; i < N; ++i) {
+                if (mSlots[i].readers.load() == 0) {
+                    mSlots[i].value = T();
+                    mSlots[i].sequence = 0;
+                }
+            }
+            mWriteIndex = -1;
+        }
+
+        // ==================== 讀者接口（任意線程） ====================
+
+        // 取得最新幀；序號不大於 lastSeenSequence 時返回空守衛
+        ReadGuard acquireLatest(uint64_t lastSeenSequence = 0) const {
+            for (;;) {
+                const int32_t index = mPublished.load();
+                if (index < 0) {
+                    return ReadGuard();
+                }
+                Slot* slot = &mSlots[index];
+                slot->readers.fetch_add(1);
+                if (mPublished.load() == index) {
+                    if (slot->sequence <= lastSeenSequence) {
+                        slot->readers.fetch_sub(1, std::memory_order_release);
+                        return ReadGuard();
+                    }
+                    return ReadGuard(slot);
+                }
+                // 生產者在此期間發佈了新幀，重試
+                slot->readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // 最新已發佈幀的序號（0 表示尚無幀）
+        uint64_t latestSequence() const {
+            return mNextSequence.load(std::memory_order_acquire) - 1;
+        }
+
+        bool hasFrame() const { return mPublished.load() >= 0; }
+
+        uint64_t getDroppedFrameCount() const { return mDroppedFrames.load(std::memory_order_relaxed); }
+
+    private:
+        mutable Slot mSlots[N];
+        std::atomic<int32_t> mPublished;
+        int32_t mWriteIndex;  // 只由生產者訪問
+        std::atomic<uint64_t> mNextSequence;
+        std::atomic<uint64_t> mDroppedFrames;
+    };
+}
+
+#endif // FRAME_MAILBOX_H
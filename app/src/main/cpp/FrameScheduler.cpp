@@ -0,0 +1,294 @@
+// ==================== FrameScheduler.cpp ====================
+// 由垂直同步驅動的渲染幀節拍
+
+#include "FrameScheduler.h"
+#include "WrapperLog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __ANDROID__
+#include <android/choreographer.h>
+#include <android/looper.h>
+#endif
+
+namespace VuforiaWrapper {
+
+    // 144 / 120 / 90 / 60Hz 的一個週期，以及 60Hz 的 1.5、2、3、4、6、12 個週期
+    const float FrameScheduler::BUCKET_LIMITS_MS[BUCKET_COUNT - 1] = {
+        7.5f, 9.5f, 12.0f, 17.5f, 25.0f, 34.0f, 50.5f, 67.5f, 100.0f, 200.0f
+    };
+
+    // 超過這個值的 vsync 間隔視為來源停頓（屏幕關閉、應用切到後台），不計入週期估計
+    static const int64_t kMaxVsyncGapNs = 100000000LL;
+
+    FrameScheduler::FrameScheduler()
+#ifdef __ANDROID__
+        : mLooper(nullptr)
+        , mRunning(false)
+#else
+        : mRunning(false)
+#endif
+        , mStopRequested(false)
+        , mUsingChoreographer(false)
+        , mTargetFps(0)
+        , mVsyncCount(0)
+        , mLatestVsyncNs(0)
+        , mVsyncPeriodNs(DEFAULT_VSYNC_PERIOD_NS)
+        , mPeriodSampleCount(0)
+        , mLastFrameVsync(0)
+        , mLastFrameNs(0) {
+        memset(mPeriodSamples, 0, sizeof(mPeriodSamples));
+        memset(mBuckets, 0, sizeof(mBuckets));
+    }
+
+    FrameScheduler::~FrameScheduler() {
+        stop();
+    }
+
+    int64_t FrameScheduler::steadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    size_t FrameScheduler::bucketFor(float milliseconds) {
+        for (size_t i = 0; i < BUCKET_COUNT - 1; ++i) {
+            if (milliseconds < BUCKET_LIMITS_MS[i]) {
+                return i;
+            }
+        }
+        return BUCKET_COUNT - 1;
+    }
+
+    bool FrameScheduler::start() {
+        std::lock_guard<std::mutex> lifecycle(mLifecycleMutex);
+        if (mThread.joinable()) {
+            return true;
+        }
+
+        mStopRequested.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mLastFrameVsync = 0;
+            mLastFrameNs = 0;
+        }
+        try {
+            mThread = std::thread(&FrameScheduler::threadMain, this);
+        } catch (const std::exception& e) {
+            LOGE("❌ Failed to start frame scheduler: %s", e.what());
+            return false;
+        }
+        mRunning.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void FrameScheduler::stop() {
+        std::lock_guard<std::mutex> lifecycle(mLifecycleMutex);
+        if (!mThread.joinable()) {
+            return;
+        }
+        mStopRequested.store(true, std::memory_order_release);
+#ifdef __ANDROID__
+        ALooper* looper = static_cast<ALooper*>(mLooper.load(std::memory_order_acquire));
+        if (looper != nullptr) {
+            ALooper_wake(looper);
+        }
+#endif
+        mThread.join();
+#ifdef __ANDROID__
+        looper = static_cast<ALooper*>(mLooper.exchange(nullptr, std::memory_order_acq_rel));
+        if (looper != nullptr) {
+            ALooper_release(looper);
+        }
+#endif
+        mRunning.store(false, std::memory_order_release);
+        // 喚醒仍在等待的渲染線程，讓它重新檢查狀態（經過 mMutex，避免喚醒丟失）
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+        }
+        mCondition.notify_all();
+        LOGI("Frame scheduler stopped");
+    }
+
+    void FrameScheduler::setTargetFrameRate(int fps) {
+        mTargetFps.store(std::max(fps, 0), std::memory_order_relaxed);
+        LOGI("Frame scheduler target: %d fps", std::max(fps, 0));
+    }
+
+    void FrameScheduler::threadMain() {
+#ifdef __ANDROID__
+        // Choreographer 只能在有 looper 的線程上使用，回調也在這個線程上執行
+        ALooper* looper = ALooper_prepare(0);
+        AChoreographer* choreographer = looper != nullptr ? AChoreographer_getInstance() : nullptr;
+        if (choreographer != nullptr) {
+            ALooper_acquire(looper);
+            mLooper.store(looper, std::memory_order_release);
+            mUsingChoreographer.store(true, std::memory_order_release);
+            LOGI("✅ Frame scheduler started (AChoreographer)");
+
+            AChoreographer_postFrameCallback(choreographer, &FrameScheduler::choreographerCallback, this);
+            while (!mStopRequested.load(std::memory_order_acquire)) {
+                ALooper_pollOnce(WAIT_TIMEOUT_MS, nullptr, nullptr, nullptr);
+            }
+            mUsingChoreographer.store(false, std::memory_order_release);
+            return;
+        }
+        LOGW("⚠️ AChoreographer unavailable, frame scheduler falls back to timer");
+#endif
+        LOGI("✅ Frame scheduler started (timer)");
+        runTimerLoop();
+    }
+
+#ifdef __ANDROID__
+    void FrameScheduler::choreographerCallback(long frameTimeNanos, void* data) {
+        FrameScheduler* scheduler = static_cast<FrameScheduler*>(data);
+        // 32 位 ABI 上 long 只有 32 位，時間戳會被截斷，改用回調時間
+        const int64_t frameTimeNs = sizeof(long) >= sizeof(int64_t) ?
+                                    static_cast<int64_t>(frameTimeNanos) : steadyNowNs();
+        scheduler->onVsync(frameTimeNs);
+
+        // 幀回調是一次性的，每次都需要重新登記
+        if (!scheduler->mStopRequested.load(std::memory_order_acquire)) {
+            AChoreographer_postFrameCallback(AChoreographer_getInstance(),
+                                             &FrameScheduler::choreographerCallback, data);
+        }
+    }
+#endif
+
+    void FrameScheduler::runTimerLoop() {
+        // 沒有真實 vsync 時按固定 60Hz 週期對齊的計時器
+        int64_t nextNs = steadyNowNs();
+        while (!mStopRequested.load(std::memory_order_acquire)) {
+            const int64_t periodNs = DEFAULT_VSYNC_PERIOD_NS;
+            nextNs += periodNs;
+            const int64_t nowNs = steadyNowNs();
+            if (nextNs < nowNs) {
+                // 線程被延遲超過一個週期，對齊到下一個週期邊界
+                nextNs += ((nowNs - nextNs) / periodNs + 1) * periodNs;
+            }
+            std::this_thread::sleep_for(std::chrono::nanoseconds(nextNs - nowNs));
+            onVsync(nextNs);
+        }
+    }
+
+    void FrameScheduler::onVsync(int64_t frameTimeNs) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const int64_t deltaNs = frameTimeNs - mLatestVsyncNs;
+            if (mLatestVsyncNs > 0 && deltaNs > 0 && deltaNs < kMaxVsyncGapNs) {
+                // 取最近幾個間隔的中位數：偶爾漏掉的回調不影響估計，刷新率切換幾幀內就能跟上
+                mPeriodSamples[mPeriodSampleCount % PERIOD_SAMPLES] = deltaNs;
+                ++mPeriodSampleCount;
+                const size_t count = std::min(mPeriodSampleCount, PERIOD_SAMPLES);
+                int64_t sorted[PERIOD_SAMPLES];
+                std::copy(mPeriodSamples, mPeriodSamples + count, sorted);
+                std::nth_element(sorted, sorted + count / 2, sorted + count);
+                mVsyncPeriodNs = sorted[count / 2];
+            }
+            mLatestVsyncNs = frameTimeNs;
+            ++mVsyncCount;
+            ++mStats.vsyncs;
+        }
+        mCondition.notify_all();
+    }
+
+    int FrameScheduler::computeInterval() const {
+        const int fps = mTargetFps.load(std::memory_order_relaxed);
+        if (fps <= 0 || mVsyncPeriodNs <= 0) {
+            return 1;
+        }
+        // 不低於目標幀率的最大 vsync 間隔：120Hz 上 60fps 取 2，90Hz 上 60fps 取 1
+        const double refreshRate = 1e9 / static_cast<double>(mVsyncPeriodNs);
+        const int interval = static_cast<int>(std::floor(refreshRate / fps + 0.1));
+        return std::max(interval, 1);
+    }
+
+    bool FrameScheduler::waitForNextFrame(int64_t& frameTimeNs) {
+        // 節拍只由 startRenderingLoop 啟動；停止後不再自動重啟，由調用者決定是否退出循環
+        if (!isRunning()) {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        const uint64_t interval = static_cast<uint64_t>(computeInterval());
+        const uint64_t targetVsync = mLastFrameVsync == 0 ? mVsyncCount + 1 : mLastFrameVsync + interval;
+
+        // 上一幀沒能在目標 vsync 前完成：不再等待，直接對齊最新的 vsync
+        if (mLastFrameVsync != 0 && mVsyncCount >= targetVsync) {
+            recordFrameLocked(mLatestVsyncNs, mVsyncCount - targetVsync, true);
+            frameTimeNs = mLatestVsyncNs;
+            return true;
+        }
+
+        const bool ready = mCondition.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS), [&] {
+            return mVsyncCount >= targetVsync || mStopRequested.load(std::memory_order_acquire);
+        });
+        if (!ready || mStopRequested.load(std::memory_order_acquire)) {
+            // vsync 停頓後重新開始計數，恢復時的第一幀不算錯過
+            mLastFrameVsync = 0;
+            mLastFrameNs = 0;
+            return false;
+        }
+
+        recordFrameLocked(mLatestVsyncNs, mVsyncCount - targetVsync, false);
+        frameTimeNs = mLatestVsyncNs;
+        return true;
+    }
+
+    void FrameScheduler::recordFrameLocked(int64_t frameTimeNs, uint64_t skipped, bool missed) {
+        ++mStats.frames;
+        mStats.skippedVsyncs += skipped;
+        if (missed) {
+            ++mStats.missedDeadlines;
+        }
+
+        if (mLastFrameNs > 0 && frameTimeNs > mLastFrameNs) {
+            const float frameMs = static_cast<float>(frameTimeNs - mLastFrameNs) / 1e6f;
+            ++mBuckets[bucketFor(frameMs)];
+            mStats.averageFrameMs = mStats.averageFrameMs <= 0.0f ?
+                                    frameMs : mStats.averageFrameMs * 0.9f + frameMs * 0.1f;
+        }
+        mLastFrameVsync = mVsyncCount;
+        mLastFrameNs = frameTimeNs;
+    }
+
+    FrameSchedulerStats FrameScheduler::getStats() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        FrameSchedulerStats stats = mStats;
+        stats.vsyncPeriodMs = static_cast<float>(mVsyncPeriodNs) / 1e6f;
+        stats.targetFps = getTargetFrameRate();
+        stats.choreographer = mUsingChoreographer.load(std::memory_order_acquire);
+        return stats;
+    }
+
+    void FrameScheduler::getHistogram(uint32_t* counts) const {
+        if (counts == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::copy(mBuckets, mBuckets + BUCKET_COUNT, counts);
+    }
+
+    std::string FrameScheduler::getStatus() const {
+        const FrameSchedulerStats stats = getStats();
+        std::ostringstream status;
+        status << (isRunning() ? (stats.choreographer ? "vsync" : "timer") : "stopped")
+               << std::fixed << std::setprecision(1)
+               << ", period " << stats.vsyncPeriodMs << " ms"
+               << ", target " << (stats.targetFps > 0 ? std::to_string(stats.targetFps) : std::string("every vsync"))
+               << ", frame " << stats.averageFrameMs << " ms"
+               << ", missed " << stats.missedDeadlines << "/" << stats.frames
+               << " (" << stats.skippedVsyncs << " vsyncs skipped)";
+        return status.str();
+    }
+
+    void FrameScheduler::resetStats() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const uint64_t vsyncs = mStats.vsyncs;
+        mStats = FrameSchedulerStats();
+        mStats.vsyncs = vsyncs;
+        memset(mBuckets, 0, sizeof(mBuckets));
+    }
+}
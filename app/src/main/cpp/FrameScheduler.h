@@ -0,0 +1,130 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+// ==================== 垂直同步幀節拍 ====================
+// 渲染線程（GLSurfaceView 的 GL 線程）不再用固定 sleep 控制幀率，而是在每幀開始前調用 waitForNextFrame()，
+// 等到下一個（按目標幀率取整的）垂直同步信號再渲染：
+//  - Android 上由專用線程的 AChoreographer 幀回調提供 vsync 時間
+//  - 其他平台（或 Choreographer 不可用時）用按刷新週期對齊的計時器代替
+//
+// 目標幀率按整數個 vsync 換算，例如 120Hz 面板上 60fps = 每 2 個 vsync 一幀，
+// 避免固定 16ms 與面板刷新率不一致造成的拍頻抖動。
+// 渲染線程準備好時目標 vsync 已經過去，記為錯過截止時間，並直接對齊最新的 vsync。
+// 相鄰兩幀開始時間之差計入幀時間直方圖。
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace VuforiaWrapper {
+
+    // 幀節拍統計
+    struct FrameSchedulerStats {
+        uint64_t frames;            // waitForNextFrame 成功返回的次數
+        uint64_t vsyncs;            // 收到的 vsync 數
+        uint64_t missedDeadlines;   // 目標 vsync 已過去才準備好的幀數
+        uint64_t skippedVsyncs;     // 因遲到而跳過的 vsync 數
+        float vsyncPeriodMs;        // 估計的刷新週期
+        float averageFrameMs;       // 幀間隔的指數移動平均
+        int targetFps;              // 0 表示每個 vsync 一幀
+        bool choreographer;         // vsync 來源是否為 AChoreographer
+
+        FrameSchedulerStats() : frames(0), vsyncs(0), missedDeadlines(0), skippedVsyncs(0),
+                                vsyncPeriodMs(0.0f), averageFrameMs(0.0f), targetFps(0),
+                                choreographer(false) {}
+    };
+
+    class FrameScheduler {
+    public:
+        // 沒有測得刷新週期前按 60Hz 計算
+        static constexpr int64_t DEFAULT_VSYNC_PERIOD_NS = 16666667;
+        // vsync 來源停頓（例如屏幕關閉）時 waitForNextFrame 的最長等待
+        static constexpr int WAIT_TIMEOUT_MS = 100;
+        // 幀時間直方圖：桶上界略高於常見刷新率的整數倍週期（毫秒），最後一個桶收集更大的值
+        static constexpr size_t BUCKET_COUNT = 11;
+        static const float BUCKET_LIMITS_MS[BUCKET_COUNT - 1];
+
+        FrameScheduler();
+        ~FrameScheduler();
+
+        FrameScheduler(const FrameScheduler&) = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        // 啟動 vsync 來源線程（已啟動時直接返回 true）；與 stop() 可在不同線程調用
+        bool start();
+
+        // 停止並等待線程退出，同時喚醒等待中的渲染線程
+        void stop();
+
+        bool isRunning() const { return mRunning.load(std::memory_order_acquire); }
+
+        /**
+         * 設置目標幀率（任意線程，下一幀生效）
+         * @param fps 0 或大於刷新率時每個 vsync 渲染一幀
+         */
+        void setTargetFrameRate(int fps);
+        int getTargetFrameRate() const { return mTargetFps.load(std::memory_order_relaxed); }
+
+        /**
+         * 等待下一幀的 vsync（只由渲染線程調用）
+         * @param frameTimeNs 輸出本幀對齊的 vsync 時間（CLOCK_MONOTONIC）
+         * @return 未啟動 / 已停止（立即返回）或等待超時時返回 false，調用者應重新檢查渲染狀態
+         */
+        bool waitForNextFrame(int64_t& frameTimeNs);
+
+        // ==================== 查詢（任意線程） ====================
+
+        FrameSchedulerStats getStats() const;
+
+        // 幀時間直方圖，counts 至少 BUCKET_COUNT 個元素
+        void getHistogram(uint32_t* counts) const;
+
+        std::string getStatus() const;
+
+        void resetStats();
+
+    private:
+        void threadMain();
+        void runTimerLoop();
+        void onVsync(int64_t frameTimeNs);
+        int computeInterval() const;
+        void recordFrameLocked(int64_t frameTimeNs, uint64_t skipped, bool missed);
+
+        static int64_t steadyNowNs();
+        static size_t bucketFor(float milliseconds);
+
+#ifdef __ANDROID__
+        static void choreographerCallback(long frameTimeNanos, void* data);
+        std::atomic<void*> mLooper;     // 節拍線程的 ALooper*（持有引用），stop() 時喚醒
+#endif
+
+        std::mutex mLifecycleMutex;     // 串行化 start / stop 對 mThread 的訪問
+        std::thread mThread;
+        std::atomic<bool> mRunning;
+        std::atomic<bool> mStopRequested;
+        std::atomic<bool> mUsingChoreographer;
+        std::atomic<int> mTargetFps;
+
+        // vsync 來源寫入，渲染線程等待（受 mMutex 保護）
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        static constexpr size_t PERIOD_SAMPLES = 8;
+        uint64_t mVsyncCount;
+        int64_t mLatestVsyncNs;
+        int64_t mVsyncPeriodNs;         // 最近 PERIOD_SAMPLES 個 vsync 間隔的中位數
+        int64_t mPeriodSamples[PERIOD_SAMPLES];
+        size_t mPeriodSampleCount;
+
+        // 渲染線程側狀態與統計（受 mMutex 保護）
+        uint64_t mLastFrameVsync;       // 上一幀對齊的 vsync 序號，0 表示尚未開始
+        int64_t mLastFrameNs;
+        FrameSchedulerStats mStats;
+        uint32_t mBuckets[BUCKET_COUNT];
+    };
+}
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,184 @@
+// ==================== GLStateTracker.cpp ====================
+// 過濾冗餘 GL 狀態切換的每上下文狀態記錄
+
+#include "GLStateTracker.h"
+#include "VuforiaRenderingJNI.h"
+#include <sstream>
+
+namespace VuforiaRendering {
+
+    GLStateTracker::GLStateTracker() {
+    }
+
+    void GLStateTracker::reset() {
+        for (Binding& capability : mCapabilities) {
+            capability = Binding();
+        }
+        mBlendSource = Binding();
+        mBlendDestination = Binding();
+        mProgram = Binding();
+        mVertexArray = Binding();
+        mArrayBuffer = Binding();
+        invalidateTextures();
+        mStats.resets++;
+    }
+
+    void GLStateTracker::invalidateTextures() {
+        mActiveTexture = Binding();
+        for (auto& unit : mTextures) {
+            for (Binding& texture : unit) {
+                texture = Binding();
+            }
+        }
+    }
+
+    int GLStateTracker::capabilityIndex(GLenum capability) {
+        switch (capability) {
+            case GL_DEPTH_TEST:   return CAP_DEPTH_TEST;
+            case GL_CULL_FACE:    return CAP_CULL_FACE;
+            case GL_BLEND:        return CAP_BLEND;
+            case GL_SCISSOR_TEST: return CAP_SCISSOR_TEST;
+            case GL_STENCIL_TEST: return CAP_STENCIL_TEST;
+            default:              return -1;
+        }
+    }
+
+    int GLStateTracker::textureTargetIndex(GLenum target) {
+        switch (target) {
+            case GL_TEXTURE_2D:           return TEXTURE_TARGET_2D;
+            case GL_TEXTURE_EXTERNAL_OES: return TEXTURE_TARGET_EXTERNAL;
+            default:                      return -1;
+        }
+    }
+
+    bool GLStateTracker::update(Binding& binding, GLuint value) {
+        if (binding.known && binding.value == value) {
+            mStats.avoided++;
+            return false;
+        }
+        binding.known = true;
+        binding.value = value;
+        mStats.applied++;
+        return true;
+    }
+
+    // ==================== 狀態設置 ====================
+
+    void GLStateTracker::setEnabled(GLenum capability, bool enabled) {
+        const int index = capabilityIndex(capability);
+        if (index >= 0) {
+            if (!update(mCapabilities[index], enabled ? 1 : 0)) {
+                return;
+            }
+        } else {
+            mStats.applied++;
+        }
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+    }
+
+    void GLStateTracker::blendFunc(GLenum sourceFactor, GLenum destinationFactor) {
+        const bool sourceMatches = mBlendSource.known && mBlendSource.value == sourceFactor;
+        const bool destinationMatches = mBlendDestination.known && mBlendDestination.value == destinationFactor;
+        if (sourceMatches && destinationMatches) {
+            mStats.avoided++;
+            return;
+        }
+        mBlendSource.known = true;
+        mBlendSource.value = sourceFactor;
+        mBlendDestination.known = true;
+        mBlendDestination.value = destinationFactor;
+        mStats.applied++;
+        glBlendFunc(sourceFactor, destinationFactor);
+    }
+
+    void GLStateTracker::useProgram(GLuint program) {
+        if (update(mProgram, program)) {
+            glUseProgram(program);
+        }
+    }
+
+    void GLStateTracker::activeTexture(GLenum unit) {
+        if (update(mActiveTexture, unit)) {
+            glActiveTexture(unit);
+        }
+    }
+
+    void GLStateTracker::bindTexture(GLenum target, GLuint texture) {
+        const int targetIndex = textureTargetIndex(target);
+        const size_t unit = mActiveTexture.known ? static_cast<size_t>(mActiveTexture.value - GL_TEXTURE0) : TEXTURE_UNITS;
+        if (targetIndex < 0 || unit >= TEXTURE_UNITS) {
+            // 未跟蹤的目標或活動單元未知：直接綁定
+            mStats.applied++;
+            glBindTexture(target, texture);
+            return;
+        }
+        if (update(mTextures[unit][targetIndex], texture)) {
+            glBindTexture(target, texture);
+        }
+    }
+
+    void GLStateTracker::bindVertexArray(GLuint vertexArray) {
+        if (update(mVertexArray, vertexArray)) {
+            glBindVertexArray(vertexArray);
+        }
+    }
+
+    void GLStateTracker::bindArrayBuffer(GLuint buffer) {
+        if (update(mArrayBuffer, buffer)) {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        }
+    }
+
+    // ==================== 對象刪除 ====================
+
+    void GLStateTracker::onProgramDeleted(GLuint program) {
+        // 正在使用的程序被刪除後仍保持綁定，直到切換到其他程序；記錄為未知最安全
+        if (mProgram.known && mProgram.value == program) {
+            mProgram = Binding();
+        }
+    }
+
+    void GLStateTracker::onTextureDeleted(GLuint texture) {
+        for (auto& unit : mTextures) {
+            for (Binding& binding : unit) {
+                if (binding.known && binding.value == texture) {
+                    binding.value = 0;
+                }
+            }
+        }
+    }
+
+    void GLStateTracker::onVertexArrayDeleted(GLuint vertexArray) {
+        if (mVertexArray.known && mVertexArray.value == vertexArray) {
+            mVertexArray.value = 0;
+        }
+    }
+
+    void GLStateTracker::onBufferDeleted(GLuint buffer) {
+        if (mArrayBuffer.known && mArrayBuffer.value == buffer) {
+            mArrayBuffer.value = 0;
+        }
+    }
+
+    // ==================== 統計 ====================
+
+    void GLStateTracker::resetStats() {
+        mStats.applied = 0;
+        mStats.avoided = 0;
+    }
+
+    std::string GLStateTracker::getStatus() const {
+        const uint64_t total = mStats.applied + mStats.avoided;
+        std::ostringstream status;
+        status << mStats.applied << " applied, " << mStats.avoided << " avoided";
+        if (total > 0) {
+            status << " (" << (mStats.avoided * 100 / total) << "%)";
+        }
+        status << ", " << mStats.resets << " context resets";
+        return status.str();
+    }
+}
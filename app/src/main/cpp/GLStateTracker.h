@@ -0,0 +1,110 @@
+#ifndef GL_STATE_TRACKER_H
+#define GL_STATE_TRACKER_H
+
+// ==================== GL 狀態跟蹤 ====================
+// 記錄當前上下文中由渲染模塊設置的狀態（開關、混合函數、程序、紋理、VAO、VBO），
+// 目標值與記錄值相同時不調用 GL，並統計實際發出和被過濾掉的狀態切換次數。
+//
+// 每個 GL 上下文一份記錄：
+//  - 新上下文（onSurfaceCreated、上下文丟失後重建）必須調用 reset()，所有狀態變為未知
+//  - 未經跟蹤器修改 GL 狀態的代碼（例如 Vuforia 更新相機紋理）之後調用對應的 invalidate
+// 未知狀態的第一次設置總是發出 GL 調用。
+// 只在 GL 線程使用，不加鎖。
+
+#include <GLES3/gl3.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace VuforiaRendering {
+
+    struct GLStateStats {
+        uint64_t applied;   // 實際發出的狀態切換
+        uint64_t avoided;   // 與記錄相同而跳過的切換
+        uint64_t resets;    // reset() 次數（上下文重建）
+
+        GLStateStats() : applied(0), avoided(0), resets(0) {}
+    };
+
+    class GLStateTracker {
+    public:
+        static constexpr size_t TEXTURE_UNITS = 8;
+
+        GLStateTracker();
+
+        // 新上下文：所有狀態變為未知（統計保留）
+        void reset();
+
+        // 外部代碼可能改動了紋理綁定或活動紋理單元
+        void invalidateTextures();
+
+        // ==================== 狀態設置 ====================
+
+        // 只跟蹤 DEPTH_TEST / CULL_FACE / BLEND / SCISSOR_TEST / STENCIL_TEST，其他開關直接透傳
+        void setEnabled(GLenum capability, bool enabled);
+        void blendFunc(GLenum sourceFactor, GLenum destinationFactor);
+        void useProgram(GLuint program);
+        // unit 為 GL_TEXTURE0 + n
+        void activeTexture(GLenum unit);
+        // 作用於當前活動紋理單元；只跟蹤 TEXTURE_2D 與 TEXTURE_EXTERNAL_OES
+        void bindTexture(GLenum target, GLuint texture);
+        void bindVertexArray(GLuint vertexArray);
+        // ELEMENT_ARRAY_BUFFER 屬於 VAO 狀態，不在這裡跟蹤
+        void bindArrayBuffer(GLuint buffer);
+
+        // ==================== 對象刪除 ====================
+        // 刪除已綁定的對象時 GL 會把綁定恢復為 0，記錄需要同步
+
+        void onProgramDeleted(GLuint program);
+        void onTextureDeleted(GLuint texture);
+        void onVertexArrayDeleted(GLuint vertexArray);
+        void onBufferDeleted(GLuint buffer);
+
+        // ==================== 統計 ====================
+
+        const GLStateStats& getStats() const { return mStats; }
+        void resetStats();
+        std::string getStatus() const;
+
+    private:
+        // 已知狀態值；known 為 false 時 value 無意義
+        struct Binding {
+            bool known;
+            GLuint value;
+            Binding() : known(false), value(0) {}
+        };
+
+        enum Capability {
+            CAP_DEPTH_TEST = 0,
+            CAP_CULL_FACE,
+            CAP_BLEND,
+            CAP_SCISSOR_TEST,
+            CAP_STENCIL_TEST,
+            CAP_COUNT
+        };
+
+        enum TextureTarget {
+            TEXTURE_TARGET_2D = 0,
+            TEXTURE_TARGET_EXTERNAL,
+            TEXTURE_TARGET_COUNT
+        };
+
+        static int capabilityIndex(GLenum capability);
+        static int textureTargetIndex(GLenum target);
+
+        // 記錄值與目標相同時計入 avoided 並返回 false，否則更新記錄並返回 true
+        bool update(Binding& binding, GLuint value);
+
+        Binding mCapabilities[CAP_COUNT];
+        Binding mBlendSource;
+        Binding mBlendDestination;
+        Binding mProgram;
+        Binding mActiveTexture;
+        Binding mTextures[TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+        Binding mVertexArray;
+        Binding mArrayBuffer;
+        GLStateStats mStats;
+    };
+}
+
+#endif // GL_STATE_TRACKER_H
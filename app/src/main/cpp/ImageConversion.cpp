@@ -0,0 +1,452 @@
+// ==================== ImageConversion.cpp ====================
+// NV12 / NV21 相機圖像轉換核心（標量參考 + NEON / SSE4.1 / AVX2）
+
+#include "ImageConversion.h"
+#include "WrapperLog.h"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IMAGE_CONVERSION_HAS_NEON 1
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IMAGE_CONVERSION_HAS_X86 1
+#endif
+
+#if defined(__arm__) && !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+namespace VuforiaWrapper {
+namespace ImageConversion {
+
+    // ==================== 定點係數 ====================
+    static constexpr int COEF_Y = 74;
+    static constexpr int COEF_VR = 102;
+    static constexpr int COEF_UG = 25;
+    static constexpr int COEF_VG = 52;
+    static constexpr int COEF_UB = 129;
+    static constexpr int COEF_SHIFT = 6;
+    static constexpr int COEF_ROUND = 1 << (COEF_SHIFT - 1);
+
+    // 單行轉換函數：從像素 startX 開始處理到 width
+    typedef void (*YuvRowKernel)(const uint8_t* yRow, const uint8_t* uvRow, uint8_t* dstRow,
+                                 int32_t startX, int32_t width, bool vuOrder);
+
+    // ==================== 標量參考實現 ====================
+    static inline uint8_t clampToByte(int value) {
+        return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+    }
+
+    template <int CHANNELS>
+    static void yuvRowScalar(const uint8_t* yRow, const uint8_t* uvRow, uint8_t* dstRow,
+                             int32_t startX, int32_t width, bool vuOrder) {
+        const int uIndex = vuOrder ? 1 : 0;
+        const int vIndex = vuOrder ? 0 : 1;
+
+        for (int32_t x = startX; x < width; ++x) {
+            const uint8_t* uv = uvRow + (x & ~1);
+            const int u = static_cast<int>(uv[uIndex]) - 128;
+            const int v = static_cast<int>(uv[vIndex]) - 128;
+            const int y = COEF_Y * (static_cast<int>(yRow[x]) - 16) + COEF_ROUND;
+
+            uint8_t* dst = dstRow + x * CHANNELS;
+            dst[0] = clampToByte((y + COEF_VR * v) >> COEF_SHIFT);
+            dst[1] = clampToByte((y - COEF_UG * u - COEF_VG * v) >> COEF_SHIFT);
+            dst[2] = clampToByte((y + COEF_UB * u) >> COEF_SHIFT);
+            if (CHANNELS == 4) {
+                dst[3] = 255;
+            }
+        }
+    }
+
+    // ==================== NEON 實現 ====================
+    // 16 位中間值使用飽和加法：只有在真實結果遠超 255 << 6 時才會飽和，
+    // 最終夾取後與標量版本一致
+#if defined(IMAGE_CONVERSION_HAS_NEON)
+    template <int CHANNELS>
+    static void yuvRowNeon(const uint8_t* yRow, const uint8_t* uvRow, uint8_t* dstRow,
+                           int32_t startX, int32_t width, bool vuOrder) {
+        const int16x8_t offset128 = vdupq_n_s16(128);
+        const int16x8_t offset16 = vdupq_n_s16(16);
+        const int16x8_t round = vdupq_n_s16(COEF_ROUND);
+
+        int32_t x = startX;
+        for (; x + 16 <= width; x += 16) {
+            const uint8x8x2_t uv = vld2_u8(uvRow + x);
+            const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uv.val[vuOrder ? 1 : 0])), offset128);
+            const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uv.val[vuOrder ? 0 : 1])), offset128);
+
+            // 色度項（每個值對應兩個水平相鄰像素）
+            const int16x8x2_t rC = vzipq_s16(vmulq_n_s16(v, COEF_VR), vmulq_n_s16(v, COEF_VR));
+            const int16x8_t gTerm = vaddq_s16(vmulq_n_s16(u, COEF_UG), vmulq_n_s16(v, COEF_VG));
+            const int16x8x2_t gC = vzipq_s16(gTerm, gTerm);
+            const int16x8x2_t bC = vzipq_s16(vmulq_n_s16(u, COEF_UB), vmulq_n_s16(u, COEF_UB));
+
+            const uint8x16_t yv = vld1q_u8(yRow + x);
+            const int16x8_t yLo = vaddq_s16(vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(yv))), offset16), COEF_Y), round);
+            const int16x8_t yHi = vaddq_s16(vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(yv))), offset16), COEF_Y), round);
+
+            const uint8x16_t r = vcombine_u8(vqshrun_n_s16(vqaddq_s16(yLo, rC.val[0]), COEF_SHIFT),
+                                             vqshrun_n_s16(vqaddq_s16(yHi, rC.val[1]), COEF_SHIFT));
+            const uint8x16_t g = vcombine_u8(vqshrun_n_s16(vsubq_s16(yLo, gC.val[0]), COEF_SHIFT),
+                                             vqshrun_n_s16(vsubq_s16(yHi, gC.val[1]), COEF_SHIFT));
+            const uint8x16_t b = vcombine_u8(vqshrun_n_s16(vqaddq_s16(yLo, bC.val[0]), COEF_SHIFT),
+                                             vqshrun_n_s16(vqaddq_s16(yHi, bC.val[1]), COEF_SHIFT));
+
+            if (CHANNELS == 4) {
+                uint8x16x4_t rgba;
+                rgba.val[0] = r;
+                rgba.val[1] = g;
+                rgba.val[2] = b;
+                rgba.val[3] = vdupq_n_u8(255);
+                vst4q_u8(dstRow + x * 4, rgba);
+            } else {
+                uint8x16x3_t rgb;
+                rgb.val[0] = r;
+                rgb.val[1] = g;
+                rgb.val[2] = b;
+                vst3q_u8(dstRow + x * 3, rgb);
+            }
+        }
+
+        yuvRowScalar<CHANNELS>(yRow, uvRow, dstRow, x, width, vuOrder);
+    }
+#endif
+
+    // ==================== SSE4.1 / AVX2 實現 ====================
+#if defined(IMAGE_CONVERSION_HAS_X86)
+    // 16 個像素的 R/G/B 交錯寫出
+    __attribute__((target("sse4.1")))
+    static inline void storeRgb16(uint8_t* dst, __m128i r, __m128i g, __m128i b) {
+        const __m128i r0 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+        const __m128i g0 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+        const __m128i b0 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+        const __m128i r1 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+        const __m128i g1 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+        const __m128i b1 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+        const __m128i r2 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+        const __m128i g2 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+        const __m128i b2 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+
+        const __m128i out0 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(r, r0), _mm_shuffle_epi8(g, g0)), _mm_shuffle_epi8(b, b0));
+        const __m128i out1 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(r, r1), _mm_shuffle_epi8(g, g1)), _mm_shuffle_epi8(b, b1));
+        const __m128i out2 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(r, r2), _mm_shuffle_epi8(g, g2)), _mm_shuffle_epi8(b, b2));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), out1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), out2);
+    }
+
+    // 16 個像素的 R/G/B/A 交錯寫出
+    __attribute__((target("sse4.1")))
+    static inline void storeRgba16(uint8_t* dst, __m128i r, __m128i g, __m128i b) {
+        const __m128i a = _mm_set1_epi8(static_cast<char>(0xFF));
+        const __m128i rgLo = _mm_unpacklo_epi8(r, g);
+        const __m128i rgHi = _mm_unpackhi_epi8(r, g);
+        const __m128i baLo = _mm_unpacklo_epi8(b, a);
+        const __m128i baHi = _mm_unpackhi_epi8(b, a);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(rgLo, baLo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(rgLo, baLo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(rgHi, baHi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(rgHi, baHi));
+    }
+
+    template <int CHANNELS>
+    __attribute__((target("sse4.1")))
+    static void yuvRowSse41(const uint8_t* yRow, const uint8_t* uvRow, uint8_t* dstRow,
+                            int32_t startX, int32_t width, bool vuOrder) {
+        const __m128i offset128 = _mm_set1_epi16(128);
+        const __m128i offset16 = _mm_set1_epi16(16);
+        const __m128i round = _mm_set1_epi16(COEF_ROUND);
+        const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+
+        int32_t x = startX;
+        for (; x + 16 <= width; x += 16) {
+            const __m128i uvBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uvRow + x));
+            const __m128i first = _mm_sub_epi16(_mm_and_si128(uvBytes, lowByteMask), offset128);
+            const __m128i second = _mm_sub_epi16(_mm_srli_epi16(uvBytes, 8), offset128);
+            const __m128i u = vuOrder ? second : first;
+            const __m128i v = vuOrder ? first : second;
+
+            const __m128i rTerm = _mm_mullo_epi16(v, _mm_set1_epi16(COEF_VR));
+            const __m128i gTerm = _mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(COEF_UG)),
+                                                _mm_mullo_epi16(v, _mm_set1_epi16(COEF_VG)));
+            const __m128i bTerm = _mm_mullo_epi16(u, _mm_set1_epi16(COEF_UB));
+
+            const __m128i yBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + x));
+            const __m128i yLo = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_cvtepu8_epi16(yBytes), offset16),
+                                                              _mm_set1_epi16(COEF_Y)), round);
+            const __m128i yHi = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(yBytes, 8)), offset16),
+                                                              _mm_set1_epi16(COEF_Y)), round);
+
+            const __m128i r = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_adds_epi16(yLo, _mm_unpacklo_epi16(rTerm, rTerm)), COEF_SHIFT),
+                _mm_srai_epi16(_mm_adds_epi16(yHi, _mm_unpackhi_epi16(rTerm, rTerm)), COEF_SHIFT));
+            const __m128i g = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_sub_epi16(yLo, _mm_unpacklo_epi16(gTerm, gTerm)), COEF_SHIFT),
+                _mm_srai_epi16(_mm_sub_epi16(yHi, _mm_unpackhi_epi16(gTerm, gTerm)), COEF_SHIFT));
+            const __m128i b = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_adds_epi16(yLo, _mm_unpacklo_epi16(bTerm, bTerm)), COEF_SHIFT),
+                _mm_srai_epi16(_mm_adds_epi16(yHi, _mm_unpackhi_epi16(bTerm, bTerm)), COEF_SHIFT));
+
+            if (CHANNELS == 4) {
+                storeRgba16(dstRow + x * 4, r, g, b);
+            } else {
+                storeRgb16(dstRow + x * 3, r, g, b);
+            }
+        }
+
+        yuvRowScalar<CHANNELS>(yRow, uvRow, dstRow, x, width, vuOrder);
+    }
+
+    template <int CHANNELS>
+    __attribute__((target("avx2")))
+    static void yuvRowAvx2(const uint8_t* yRow, const uint8_t* uvRow, uint8_t* dstRow,
+                           int32_t startX, int32_t width, bool vuOrder) {
+        const __m256i offset128 = _mm256_set1_epi16(128);
+        const __m256i offset16 = _mm256_set1_epi16(16);
+        const __m256i round = _mm256_set1_epi16(COEF_ROUND);
+        const __m256i lowByteMask = _mm256_set1_epi16(0x00FF);
+        // unpacklo/hi 只在 128 位通道內工作，先重排 64 位塊，讓複製後的色度按像素順序排列
+        constexpr int LANE_ORDER = 0xD8;  // (0, 2, 1, 3)
+
+        int32_t x = startX;
+        for (; x + 32 <= width; x += 32) {
+            const __m256i uvBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uvRow + x));
+            const __m256i first = _mm256_sub_epi16(_mm256_and_si256(uvBytes, lowByteMask), offset128);
+            const __m256i second = _mm256_sub_epi16(_mm256_srli_epi16(uvBytes, 8), offset128);
+            const __m256i u = vuOrder ? second : first;
+            const __m256i v = vuOrder ? first : second;
+
+            const __m256i rTerm = _mm256_permute4x64_epi64(_mm256_mullo_epi16(v, _mm256_set1_epi16(COEF_VR)), LANE_ORDER);
+            const __m256i gTerm = _mm256_permute4x64_epi64(
+                _mm256_add_epi16(_mm256_mullo_epi16(u, _mm256_set1_epi16(COEF_UG)),
+                                 _mm256_mullo_epi16(v, _mm256_set1_epi16(COEF_VG))), LANE_ORDER);
+            const __m256i bTerm = _mm256_permute4x64_epi64(_mm256_mullo_epi16(u, _mm256_set1_epi16(COEF_UB)), LANE_ORDER);
+
+            const __m256i yBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(yRow + x));
+            const __m256i yLo = _mm256_add_epi16(_mm256_mullo_epi16(
+                _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(yBytes)), offset16),
+                _mm256_set1_epi16(COEF_Y)), round);
+            const __m256i yHi = _mm256_add_epi16(_mm256_mullo_epi16(
+                _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(yBytes, 1)), offset16),
+                _mm256_set1_epi16(COEF_Y)), round);
+
+            // packus 同樣按通道打包，打包後再重排回像素順序
+            const __m256i r = _mm256_permute4x64_epi64(_mm256_packus_epi16(
+                _mm256_srai_epi16(_mm256_adds_epi16(yLo, _mm256_unpacklo_epi16(rTerm, rTerm)), COEF_SHIFT),
+                _mm256_srai_epi16(_mm256_adds_epi16(yHi, _mm256_unpackhi_epi16(rTerm, rTerm)), COEF_SHIFT)), LANE_ORDER);
+            const __m256i g = _mm256_permute4x64_epi64(_mm256_packus_epi16(
+                _mm256_srai_epi16(_mm256_sub_epi16(yLo, _mm256_unpacklo_epi16(gTerm, gTerm)), COEF_SHIFT),
+                _mm256_srai_epi16(_mm256_sub_epi16(yHi, _mm256_unpackhi_epi16(gTerm, gTerm)), COEF_SHIFT)), LANE_ORDER);
+            const __m256i b = _mm256_permute4x64_epi64(_mm256_packus_epi16(
+                _mm256_srai_epi16(_mm256_adds_epi16(yLo, _mm256_unpacklo_epi16(bTerm, bTerm)), COEF_SHIFT),
+                _mm256_srai_epi16(_mm256_adds_epi16(yHi, _mm256_unpackhi_epi16(bTerm, bTerm)), COEF_SHIFT)), LANE_ORDER);
+
+            if (CHANNELS == 4) {
+                storeRgba16(dstRow + x * 4, _mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b));
+                storeRgba16(dstRow + (x + 16) * 4, _mm256_extracti128_si256(r, 1),
+                            _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1));
+            } else {
+                storeRgb16(dstRow + x * 3, _mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b));
+                storeRgb16(dstRow + (x + 16) * 3, _mm256_extracti128_si256(r, 1),
+                           _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1));
+            }
+        }
+
+        yuvRowSse41<CHANNELS>(yRow, uvRow, dstRow, x, width, vuOrder);
+    }
+#endif
+
+    // ==================== CPU 特性檢測 ====================
+    static SimdLevel detectSimdLevelUncached() {
+#if defined(__aarch64__)
+        // arm64-v8a 保證支持 NEON
+        return SimdLevel::NEON;
+#elif defined(IMAGE_CONVERSION_HAS_NEON)
+        unsigned long hwcap = getauxval(AT_HWCAP);
+        return (hwcap & HWCAP_NEON) != 0 ? SimdLevel::NEON : SimdLevel::SCALAR;
+#elif defined(IMAGE_CONVERSION_HAS_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return SimdLevel::SSE41;
+        }
+        return SimdLevel::SCALAR;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    SimdLevel detectSimdLevel() {
+        static const SimdLevel detected = []() {
+            SimdLevel level = detectSimdLevelUncached();
+            LOGI("🧮 Image conversion SIMD level: %s", simdLevelName(level));
+            return level;
+        }();
+        return detected;
+    }
+
+    const char* simdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AUTO:
+                return "AUTO";
+            case SimdLevel::SCALAR:
+                return "SCALAR";
+            case SimdLevel::NEON:
+                return "NEON";
+            case SimdLevel::SSE41:
+                return "SSE4.1";
+            case SimdLevel::AVX2:
+                return "AVX2";
+        }
+        return "UNKNOWN";
+    }
+
+    // 選擇指定等級的行轉換函數；要求的等級不可用時退回到可用的最高等級
+    template <int CHANNELS>
+    static YuvRowKernel selectRowKernel(SimdLevel level) {
+        const SimdLevel available = detectSimdLevel();
+        if (level == SimdLevel::AUTO || static_cast<int>(level) > static_cast<int>(available)) {
+            level = available;
+        }
+
+        switch (level) {
+#if defined(IMAGE_CONVERSION_HAS_NEON)
+            case SimdLevel::NEON:
+                return &yuvRowNeon<CHANNELS>;
+#endif
+#if defined(IMAGE_CONVERSION_HAS_X86)
+            case SimdLevel::AVX2:
+                return &yuvRowAvx2<CHANNELS>;
+            case SimdLevel::SSE41:
+                return &yuvRowSse41<CHANNELS>;
+#endif
+            default:
+                return &yuvRowScalar<CHANNELS>;
+        }
+    }
+
+    static bool validateConversion(const YuvPlanes& src, const uint8_t* dst, int32_t dstStride, int32_t bytesPerPixel) {
+        if (src.y == nullptr || src.uv == nullptr || dst == nullptr) {
+            return false;
+        }
+        if (src.width <= 0 || src.height <= 0) {
+            return false;
+        }
+        if (src.yStride < src.width || src.uvStride < ((src.width + 1) & ~1)) {
+            return false;
+        }
+        return dstStride >= src.width * bytesPerPixel;
+    }
+
+    template <int CHANNELS>
+    static bool convertYuv(const YuvPlanes& src, uint8_t* dst, int32_t dstStride, SimdLevel level) {
+        if (!validateConversion(src, dst, dstStride, CHANNELS)) {
+            return false;
+        }
+
+        const YuvRowKernel kernel = selectRowKernel<CHANNELS>(level);
+        for (int32_t row = 0; row < src.height; ++row) {
+            kernel(src.y + static_cast<size_t>(row) * src.yStride,
+                   src.uv + static_cast<size_t>(row / 2) * src.uvStride,
+                   dst + static_cast<size_t>(row) * dstStride,
+                   0, src.width, src.vuOrder);
+        }
+        return true;
+    }
+
+    // ==================== 公開接口 ====================
+    bool convertYuvToRgb(const YuvPlanes& src, uint8_t* dst, int32_t dstStride, SimdLevel level) {
+        return convertYuv<3>(src, dst, dstStride, level);
+    }
+
+    bool convertYuvToRgba(const YuvPlanes& src, uint8_t* dst, int32_t dstStride, SimdLevel level) {
+        return convertYuv<4>(src, dst, dstStride, level);
+    }
+
+    bool convertYuvToGray(const YuvPlanes& src, uint8_t* dst, int32_t dstStride) {
+        if (!validateConversion(src, dst, dstStride, 1)) {
+            return false;
+        }
+
+        // 亮度平面即灰度圖，步長相同時一次複製
+        if (dstStride == src.yStride) {
+            memcpy(dst, src.y, static_cast<size_t>(src.yStride) * src.height);
+            return true;
+        }
+        for (int32_t row = 0; row < src.height; ++row) {
+            memcpy(dst + static_cast<size_t>(row) * dstStride,
+                   src.y + static_cast<size_t>(row) * src.yStride,
+                   static_cast<size_t>(src.width));
+        }
+        return true;
+    }
+
+    // ==================== AlignedImageBuffer ====================
+    AlignedImageBuffer::AlignedImageBuffer(size_t size) : mData(nullptr), mSize(0), mCapacity(0) {
+        resize(size);
+    }
+
+    AlignedImageBuffer::~AlignedImageBuffer() {
+        release();
+    }
+
+    AlignedImageBuffer::AlignedImageBuffer(AlignedImageBuffer&& other) noexcept
+        : mData(other.mData), mSize(other.mSize), mCapacity(other.mCapacity) {
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mCapacity = 0;
+    }
+
+    AlignedImageBuffer& AlignedImageBuffer::operator=(AlignedImageBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            mData = other.mData;
+            mSize = other.mSize;
+            mCapacity = other.mCapacity;
+            other.mData = nullptr;
+            other.mSize = 0;
+            other.mCapacity = 0;
+        }
+        return *this;
+    }
+
+    bool AlignedImageBuffer::resize(size_t size) {
+        if (size <= mCapacity) {
+            mSize = size;
+            return true;
+        }
+
+        void* memory = nullptr;
+        const size_t rounded = (size + IMAGE_BUFFER_ALIGNMENT - 1) & ~(IMAGE_BUFFER_ALIGNMENT - 1);
+        if (posix_memalign(&memory, IMAGE_BUFFER_ALIGNMENT, rounded) != 0 || memory == nullptr) {
+            LOGE("❌ Failed to allocate %zu byte image buffer", rounded);
+            return false;
+        }
+
+        free(mData);
+        mData = static_cast<uint8_t*>(memory);
+        mSize = size;
+        mCapacity = rounded;
+        return true;
+    }
+
+    void AlignedImageBuffer::release() {
+        free(mData);
+        mData = nullptr;
+        mSize = 0;
+        mCapacity = 0;
+    }
+
+} // namespace ImageConversion
+} // namespace VuforiaWrapper
@@ -0,0 +1,105 @@
+#ifndef IMAGE_CONVERSION_H
+#define IMAGE_CONVERSION_H
+
+// ==================== 相機圖像格式轉換 ====================
+// NV12 / NV21 → RGB888 / RGBA8888 / 灰度 的轉換核心
+//  - 標量版本是參考實現，所有 SIMD 版本必須與其逐位元一致
+//  - SIMD 版本：NEON (arm64-v8a / armeabi-v7a)、SSE4.1 / AVX2 (x86_64)
+//  - 運行時檢測 CPU 特性，選擇可用的最快版本
+//  - 輸出寫入調用方提供的緩衝區（建議使用 AlignedImageBuffer 分配）
+//  - 不依賴 JNI / Vuforia，主機端測試（tests/）直接編譯本模塊
+//
+// 色彩轉換使用 BT.601 有限範圍係數，6 位定點：
+//   R = (74 * (Y - 16) + 102 * (V - 128) + 32) >> 6
+//   G = (74 * (Y - 16) -  25 * (U - 128) - 52 * (V - 128) + 32) >> 6
+//   B = (74 * (Y - 16) + 129 * (U - 128) + 32) >> 6
+
+#include <cstddef>
+#include <cstdint>
+
+namespace VuforiaWrapper {
+namespace ImageConversion {
+
+    // 輸出緩衝區建議對齊（AVX2 寬度）
+    static constexpr size_t IMAGE_BUFFER_ALIGNMENT = 32;
+
+    // 可用的指令集等級
+    enum class SimdLevel {
+        AUTO = -1,   // 使用運行時檢測結果
+        SCALAR = 0,
+        NEON = 1,
+        SSE41 = 2,
+        AVX2 = 3
+    };
+
+    // 半平面 YUV 4:2:0 圖像描述（NV12 / NV21 共用）
+    struct YuvPlanes {
+        const uint8_t* y;
+        int32_t yStride;
+        const uint8_t* uv;
+        int32_t uvStride;
+        int32_t width;
+        int32_t height;
+        bool vuOrder;  // true = NV21 (V 在前)，false = NV12 (U 在前)
+
+        YuvPlanes() : y(nullptr), yStride(0), uv(nullptr), uvStride(0),
+                      width(0), height(0), vuOrder(false) {}
+    };
+
+    // 對齊的圖像緩衝區 - 只在容量不足時重新分配
+    class AlignedImageBuffer {
+    public:
+        AlignedImageBuffer() : mData(nullptr), mSize(0), mCapacity(0) {}
+        explicit AlignedImageBuffer(size_t size);
+        ~AlignedImageBuffer();
+
+        AlignedImageBuffer(const AlignedImageBuffer&) = delete;
+        AlignedImageBuffer& operator=(const AlignedImageBuffer&) = delete;
+        AlignedImageBuffer(AlignedImageBuffer&& other) noexcept;
+        AlignedImageBuffer& operator=(AlignedImageBuffer&& other) noexcept;
+
+        bool resize(size_t size);
+        void release();
+
+        uint8_t* data() { return mData; }
+        const uint8_t* data() const { return mData; }
+        size_t size() const { return mSize; }
+        size_t capacity() const { return mCapacity; }
+
+    private:
+        uint8_t* mData;
+        size_t mSize;
+        size_t mCapacity;
+    };
+
+    /**
+     * 檢測當前 CPU 支持的最高指令集等級（結果會被緩存）
+     */
+    SimdLevel detectSimdLevel();
+
+    /**
+     * 指令集等級名稱，用於日誌
+     */
+    const char* simdLevelName(SimdLevel level);
+
+    /**
+     * YUV → RGB888，dstStride 以字節為單位（至少 width * 3）
+     */
+    bool convertYuvToRgb(const YuvPlanes& src, uint8_t* dst, int32_t dstStride,
+                         SimdLevel level = SimdLevel::AUTO);
+
+    /**
+     * YUV → RGBA8888（alpha = 255），dstStride 至少 width * 4
+     */
+    bool convertYuvToRgba(const YuvPlanes& src, uint8_t* dst, int32_t dstStride,
+                          SimdLevel level = SimdLevel::AUTO);
+
+    /**
+     * YUV → 灰度（直接取亮度平面），dstStride 至少 width
+     */
+    bool convertYuvToGray(const YuvPlanes& src, uint8_t* dst, int32_t dstStride);
+
+} // namespace ImageConversion
+} // namespace VuforiaWrapper
+
+#endif // IMAGE_CONVERSION_H
@@ -0,0 +1,151 @@
+// ==================== JniRegistry.cpp ====================
+// JNI_OnLoad / JNI_OnUnload、native 方法註冊與類 / 方法 ID 緩存
+
+#include "JniRegistry.h"
+#include "VuforiaWrapper.h"
+#include <cstring>
+
+extern JavaVM* gJavaVM;
+
+namespace VuforiaWrapper {
+
+    static JniRegistry gJniRegistry = {};
+
+    const JniRegistry& getJniRegistry() {
+        return gJniRegistry;
+    }
+
+    // 查找類並建立全局引用；失敗時清除異常返回 nullptr
+    static jclass findGlobalClass(JNIEnv* env, const char* name) {
+        jclass localClass = env->FindClass(name);
+        if (localClass == nullptr) {
+            env->ExceptionClear();
+            LOGE("❌ JNI class not found: %s", name);
+            return nullptr;
+        }
+        jclass globalClass = static_cast<jclass>(env->NewGlobalRef(localClass));
+        env->DeleteLocalRef(localClass);
+        return globalClass;
+    }
+
+    static jmethodID findMethod(JNIEnv* env, jclass clazz, const char* name, const char* signature) {
+        if (clazz == nullptr) {
+            return nullptr;
+        }
+        jmethodID method = env->GetMethodID(clazz, name, signature);
+        if (method == nullptr) {
+            env->ExceptionClear();
+            LOGE("❌ JNI method not found: %s%s", name, signature);
+        }
+        return method;
+    }
+
+    bool registerNativeMethods(JNIEnv* env, jclass clazz, const JNINativeMethod* methods,
+                               size_t count, const char* label) {
+        if (env == nullptr || clazz == nullptr) {
+            return false;
+        }
+        if (env->RegisterNatives(clazz, methods, static_cast<jint>(count)) != JNI_OK) {
+            env->ExceptionClear();
+            LOGE("❌ RegisterNatives failed for %s", label);
+            return false;
+        }
+        LOGD("Registered %zu natives for %s", count, label);
+        return true;
+    }
+
+    static void releaseRegistry(JNIEnv* env) {
+        jclass* classes[] = {
+            &gJniRegistry.coreManagerClass,
+            &gJniRegistry.initializationClass,
+            &gJniRegistry.targetCallbackClass,
+            &gJniRegistry.stringClass,
+            &gJniRegistry.activityClass
+        };
+        for (jclass* clazz : classes) {
+            if (*clazz != nullptr && env != nullptr) {
+                env->DeleteGlobalRef(*clazz);
+            }
+            *clazz = nullptr;
+        }
+        memset(&gJniRegistry, 0, sizeof(gJniRegistry));
+    }
+
+    static bool buildRegistry(JNIEnv* env) {
+        gJniRegistry.coreManagerClass =
+            findGlobalClass(env, "com/example/ibm_ai_weather_art_android/VuforiaCoreManager");
+        gJniRegistry.initializationClass =
+            findGlobalClass(env, "com/example/ibm_ai_weather_art_android/initialization/VuforiaInitialization");
+        gJniRegistry.targetCallbackClass =
+            findGlobalClass(env, "com/example/ibm_ai_weather_art_android/VuforiaCoreManager$TargetEventBatchCallback");
+        gJniRegistry.stringClass = findGlobalClass(env, "java/lang/String");
+        gJniRegistry.activityClass = findGlobalClass(env, "android/app/Activity");
+
+        gJniRegistry.onTargetNamesRegistered = findMethod(env, gJniRegistry.targetCallbackClass,
+                                                          "onTargetNamesRegistered", "([I[Ljava/lang/String;)V");
+        gJniRegistry.onTargetEventBatch = findMethod(env, gJniRegistry.targetCallbackClass,
+                                                     "onTargetEventBatch", "(I[I[I[J[F)V");
+
+        jclass contextClass = env->FindClass("android/content/Context");
+        if (contextClass != nullptr) {
+            gJniRegistry.contextCheckSelfPermission = findMethod(env, contextClass,
+                "checkSelfPermission", "(Ljava/lang/String;)I");
+            env->DeleteLocalRef(contextClass);
+        } else {
+            env->ExceptionClear();
+        }
+
+        jclass classClass = env->FindClass("java/lang/Class");
+        if (classClass != nullptr) {
+            gJniRegistry.classGetName = findMethod(env, classClass, "getName", "()Ljava/lang/String;");
+            env->DeleteLocalRef(classClass);
+        } else {
+            env->ExceptionClear();
+        }
+
+        return gJniRegistry.coreManagerClass != nullptr && gJniRegistry.targetCallbackClass != nullptr;
+    }
+}
+
+// ==================== 動態庫生命週期 ====================
+
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
+    using namespace VuforiaWrapper;
+
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK || env == nullptr) {
+        LOGE("❌ JNI_OnLoad: failed to get JNIEnv");
+        return JNI_ERR;
+    }
+
+    gJavaVM = vm;
+    gJniRegistry.vm = vm;
+
+    if (!buildRegistry(env)) {
+        LOGE("❌ JNI_OnLoad: class cache incomplete, cannot register natives");
+        releaseRegistry(env);
+        return JNI_ERR;
+    }
+
+    // 任一方法表註冊失敗都視為致命錯誤：RegisterNatives 在第一個失敗條目處中止，
+    // 其後的條目不會被綁定，繼續加載只會在調用時才暴露問題
+    if (!registerWrapperNatives(env, gJniRegistry.coreManagerClass, gJniRegistry.initializationClass) ||
+        !registerRenderingNatives(env, gJniRegistry.coreManagerClass)) {
+        LOGE("❌ JNI_OnLoad: native registration failed");
+        releaseRegistry(env);
+        return JNI_ERR;
+    }
+
+    gJniRegistry.valid = true;
+    LOGI("✅ JNI_OnLoad: registry ready, natives registered");
+    return JNI_VERSION_1_6;
+}
+
+extern "C" JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void* reserved) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        env = nullptr;
+    }
+    VuforiaWrapper::releaseRegistry(env);
+    LOGI("JNI_OnUnload: registry released");
+}
@@ -0,0 +1,48 @@
+#ifndef JNI_REGISTRY_H
+#define JNI_REGISTRY_H
+
+// ==================== JNI 註冊表 ====================
+// JNI_OnLoad 中一次性完成：
+//  - 通過 RegisterNatives 綁定所有 native 方法（不再依賴符號動態查找）
+//  - 緩存 native 代碼用到的類（全局引用）與方法 ID
+// JNI_OnUnload 時釋放全局引用並使註冊表失效。
+// 註冊表在 JNI_OnLoad 之後只讀，任意線程可以直接使用。
+
+#include <jni.h>
+#include <cstddef>
+
+namespace VuforiaWrapper {
+
+    struct JniRegistry {
+        JavaVM* vm;
+        bool valid;                      // JNI_OnLoad 成功且尚未卸載
+
+        // 應用類（全局引用）
+        jclass coreManagerClass;         // VuforiaCoreManager
+        jclass initializationClass;      // initialization.VuforiaInitialization
+        jclass targetCallbackClass;      // VuforiaCoreManager$TargetEventBatchCallback
+
+        // TargetEventBatchCallback
+        jmethodID onTargetNamesRegistered;  // ([I[Ljava/lang/String;)V
+        jmethodID onTargetEventBatch;       // (I[I[I[J[F)V
+
+        // 系統類
+        jclass stringClass;              // java.lang.String
+        jclass activityClass;            // android.app.Activity
+        jmethodID contextCheckSelfPermission;  // Context.checkSelfPermission(String)
+        jmethodID classGetName;          // Class.getName()
+    };
+
+    // 只讀訪問；未加載時 valid 為 false，所有 ID 為 nullptr
+    const JniRegistry& getJniRegistry();
+
+    // 註冊一組 native 方法；失敗時清除異常並返回 false
+    bool registerNativeMethods(JNIEnv* env, jclass clazz, const JNINativeMethod* methods,
+                               size_t count, const char* label);
+
+    // 各模塊的 native 方法表，定義在實現這些方法的源文件中
+    bool registerWrapperNatives(JNIEnv* env, jclass coreManagerClass, jclass initializationClass);
+    bool registerRenderingNatives(JNIEnv* env, jclass coreManagerClass);
+}
+
+#endif // JNI_REGISTRY_H
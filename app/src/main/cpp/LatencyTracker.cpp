@@ -0,0 +1,283 @@
+// ==================== LatencyTracker.cpp ====================
+// 相機到畫面延遲打點與滾動直方圖
+
+#include "LatencyTracker.h"
+#include "VuforiaWrapper.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace VuforiaWrapper {
+
+    const float FrameLatencyTracker::BUCKET_LIMITS_MS[BUCKET_COUNT - 1] = {
+        2.0f, 4.0f, 8.0f, 12.0f, 16.7f, 25.0f, 33.3f, 50.0f, 66.7f, 100.0f, 200.0f
+    };
+
+    // 超過這個值的樣本視為掛起 / 暫停造成的異常，不計入統計
+    static const int64_t kMaxSampleNs = 2000000000LL;
+
+    static const size_t kStageCount = static_cast<size_t>(LatencyStage::COUNT);
+    static const size_t kMetricCount = static_cast<size_t>(LatencyMetric::COUNT);
+
+    static int64_t clockNowNs(clockid_t clock) {
+        timespec ts;
+        clock_gettime(clock, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+
+    FrameLatencyTracker::FrameLatencyTracker()
+        : mFrameOpen(false)
+        , mCameraClock(CameraClock::UNKNOWN)
+        , mFrameCount(0)
+        , mLastLogNs(0)
+        , mLogInterval(std::chrono::milliseconds(5000)) {
+        std::fill(std::begin(mStamps), std::end(mStamps), -1);
+        for (auto& window : mWindows) {
+            window.next = 0;
+            window.size = 0;
+            std::fill(std::begin(window.buckets), std::end(window.buckets), 0u);
+        }
+    }
+
+    int64_t FrameLatencyTracker::steadyNowNs() {
+        return clockNowNs(CLOCK_MONOTONIC);
+    }
+
+    size_t FrameLatencyTracker::bucketFor(float milliseconds) {
+        for (size_t i = 0; i < BUCKET_COUNT - 1; ++i) {
+            if (milliseconds < BUCKET_LIMITS_MS[i]) {
+                return i;
+            }
+        }
+        return BUCKET_COUNT - 1;
+    }
+
+    const char* FrameLatencyTracker::metricName(LatencyMetric metric) {
+        switch (metric) {
+            case LatencyMetric::CAPTURE_TO_STATE:
+                return "capture->state";
+            case LatencyMetric::STATE_TO_OBSERVATIONS:
+                return "state->observations";
+            case LatencyMetric::OBSERVATIONS_TO_BACKGROUND:
+                return "observations->background";
+            case LatencyMetric::BACKGROUND_TO_SWAP:
+                return "background->swap";
+            case LatencyMetric::END_TO_END:
+                return "capture->swap";
+            default:
+                return "unknown";
+        }
+    }
+
+    // ==================== 渲染線程打點 ====================
+
+    void FrameLatencyTracker::beginFrame() {
+        std::fill(std::begin(mStamps), std::end(mStamps), -1);
+        mFrameOpen = true;
+    }
+
+    void FrameLatencyTracker::stampCapture(const VuState* state) {
+        if (!mFrameOpen || state == nullptr || mCameraClock == CameraClock::UNUSABLE) {
+            return;
+        }
+
+        VuCameraFrame* cameraFrame = nullptr;
+        if (vuStateGetCameraFrame(state, &cameraFrame) != VU_SUCCESS || cameraFrame == nullptr) {
+            return;
+        }
+
+        int64_t cameraTimestamp = 0;
+        if (vuCameraFrameGetTimestamp(cameraFrame, &cameraTimestamp) != VU_SUCCESS || cameraTimestamp <= 0) {
+            return;
+        }
+
+        const int64_t monotonicNow = steadyNowNs();
+        const int64_t boottimeNow = clockNowNs(CLOCK_BOOTTIME);
+
+        // 第一次收到時間戳時判斷相機使用的時鐘源
+        if (mCameraClock == CameraClock::UNKNOWN) {
+            const int64_t monotonicAge = monotonicNow - cameraTimestamp;
+            const int64_t boottimeAge = boottimeNow - cameraTimestamp;
+            if (monotonicAge >= 0 && monotonicAge < kMaxSampleNs) {
+                mCameraClock = CameraClock::MONOTONIC;
+            } else if (boottimeAge >= 0 && boottimeAge < kMaxSampleNs) {
+                mCameraClock = CameraClock::BOOTTIME;
+            } else {
+                mCameraClock = CameraClock::UNUSABLE;
+                LOGW("⚠️ Camera timestamp %lld matches no known clock, capture latency disabled",
+                     static_cast<long long>(cameraTimestamp));
+                return;
+            }
+            LOGI("⏱️ Camera timestamps use %s",
+                 mCameraClock == CameraClock::MONOTONIC ? "CLOCK_MONOTONIC" : "CLOCK_BOOTTIME");
+        }
+
+        // 換算到 CLOCK_MONOTONIC（兩者差值在設備休眠後會變化，每幀重新計算）
+        int64_t captureNs = cameraTimestamp;
+        if (mCameraClock == CameraClock::BOOTTIME) {
+            captureNs -= (boottimeNow - monotonicNow);
+        }
+        mStamps[static_cast<size_t>(LatencyStage::CAPTURE)] = captureNs;
+    }
+
+    void FrameLatencyTracker::stamp(LatencyStage stage) {
+        if (!mFrameOpen || stage == LatencyStage::COUNT) {
+            return;
+        }
+        mStamps[static_cast<size_t>(stage)] = steadyNowNs();
+    }
+
+    void FrameLatencyTracker::endFrame() {
+        if (!mFrameOpen) {
+            return;
+        }
+        mFrameOpen = false;
+        // 沒有繪製背景的幀（例如沒有取得狀態）不參與統計
+        if (mStamps[static_cast<size_t>(LatencyStage::BACKGROUND)] < 0) {
+            return;
+        }
+        mStamps[static_cast<size_t>(LatencyStage::SWAPPED)] = steadyNowNs();
+        recordFrame();
+    }
+
+    void FrameLatencyTracker::discardFrame() {
+        mFrameOpen = false;
+    }
+
+    // ==================== 統計 ====================
+
+    void FrameLatencyTracker::recordFrame() {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // 區間 i = 階段 i+1 減去它之前最近一個已打點的階段；
+        // 缺失的階段（例如 GL 路徑不提取觀察結果）併入下一個區間
+        int64_t previous = mStamps[0];
+        for (size_t stage = 1; stage < kStageCount; ++stage) {
+            const int64_t current = mStamps[stage];
+            if (current < 0) {
+                continue;
+            }
+            if (previous >= 0) {
+                const int64_t delta = current - previous;
+                if (delta >= 0 && delta < kMaxSampleNs) {
+                    addSampleLocked(static_cast<LatencyMetric>(stage - 1), delta / 1.0e6f);
+                }
+            }
+            previous = current;
+        }
+
+        const int64_t capture = mStamps[static_cast<size_t>(LatencyStage::CAPTURE)];
+        const int64_t swapped = mStamps[static_cast<size_t>(LatencyStage::SWAPPED)];
+        if (capture >= 0 && swapped >= capture && swapped - capture < kMaxSampleNs) {
+            addSampleLocked(LatencyMetric::END_TO_END, (swapped - capture) / 1.0e6f);
+        }
+
+        ++mFrameCount;
+        maybeLogLocked(swapped);
+    }
+
+    void FrameLatencyTracker::addSampleLocked(LatencyMetric metric, float milliseconds) {
+        MetricWindow& window = mWindows[static_cast<size_t>(metric)];
+
+        // 窗口已滿時移除最舊的樣本
+        if (window.size == WINDOW_SIZE) {
+            uint32_t& evicted = window.buckets[bucketFor(window.samples[window.next])];
+            if (evicted > 0) {
+                --evicted;
+            }
+        } else {
+            ++window.size;
+        }
+
+        window.samples[window.next] = milliseconds;
+        window.next = (window.next + 1) % WINDOW_SIZE;
+        ++window.buckets[bucketFor(milliseconds)];
+    }
+
+    LatencySummary FrameLatencyTracker::summarizeLocked(LatencyMetric metric) const {
+        LatencySummary summary;
+        const MetricWindow& window = mWindows[static_cast<size_t>(metric)];
+        if (window.size == 0) {
+            return summary;
+        }
+
+        // 在棧上排序副本，不分配堆內存
+        float sorted[WINDOW_SIZE];
+        std::copy(window.samples, window.samples + window.size, sorted);
+        std::sort(sorted, sorted + window.size);
+
+        auto percentile = [&](float p) {
+            size_t index = static_cast<size_t>(p * static_cast<float>(window.size - 1) + 0.5f);
+            return sorted[std::min(index, window.size - 1)];
+        };
+
+        summary.count = static_cast<uint32_t>(window.size);
+        summary.p50 = percentile(0.50f);
+        summary.p90 = percentile(0.90f);
+        summary.p99 = percentile(0.99f);
+        summary.max = sorted[window.size - 1];
+        return summary;
+    }
+
+    void FrameLatencyTracker::maybeLogLocked(int64_t nowNs) {
+        const int64_t intervalNs = static_cast<int64_t>(mLogInterval.count()) * 1000000LL;
+        if (intervalNs <= 0 || nowNs - mLastLogNs < intervalNs) {
+            return;
+        }
+        mLastLogNs = nowNs;
+
+        const LatencySummary endToEnd = summarizeLocked(LatencyMetric::END_TO_END);
+        const LatencySummary state = summarizeLocked(LatencyMetric::CAPTURE_TO_STATE);
+        const LatencySummary swap = summarizeLocked(LatencyMetric::BACKGROUND_TO_SWAP);
+        LOGI("⏱️ Latency ms (p50/p99): capture->swap %.1f/%.1f | capture->state %.1f/%.1f | "
+             "background->swap %.1f/%.1f | frames %llu",
+             endToEnd.p50, endToEnd.p99, state.p50, state.p99, swap.p50, swap.p99,
+             static_cast<unsigned long long>(mFrameCount));
+    }
+
+    // ==================== 查詢 ====================
+
+    LatencySummary FrameLatencyTracker::getSummary(LatencyMetric metric) const {
+        if (metric == LatencyMetric::COUNT) {
+            return LatencySummary();
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        return summarizeLocked(metric);
+    }
+
+    void FrameLatencyTracker::getHistogram(LatencyMetric metric, uint32_t* counts) const {
+        if (counts == nullptr || metric == LatencyMetric::COUNT) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        const MetricWindow& window = mWindows[static_cast<size_t>(metric)];
+        std::copy(window.buckets, window.buckets + BUCKET_COUNT, counts);
+    }
+
+    std::string FrameLatencyTracker::getReport() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::ostringstream report;
+        report << "=== Camera-to-Photon Latency (last " << WINDOW_SIZE << " frames) ===\n";
+        report << std::fixed << std::setprecision(1);
+        for (size_t i = 0; i < kMetricCount; ++i) {
+            const LatencyMetric metric = static_cast<LatencyMetric>(i);
+            const LatencySummary summary = summarizeLocked(metric);
+            report << metricName(metric) << ": n=" << summary.count
+                   << " p50=" << summary.p50 << " p90=" << summary.p90
+                   << " p99=" << summary.p99 << " max=" << summary.max << " ms\n";
+        }
+        report << "Frames recorded: " << mFrameCount << "\n";
+        return report.str();
+    }
+
+    void FrameLatencyTracker::reset() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& window : mWindows) {
+            window.next = 0;
+            window.size = 0;
+            std::fill(std::begin(window.buckets), std::end(window.buckets), 0u);
+        }
+        mFrameCount = 0;
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+// ==================== 相機到畫面延遲統計 ====================
+// 每幀在以下時間點打點，統計各階段與端到端的滾動直方圖：
+//   CAPTURE        相機曝光時間（vuCameraFrameGetTimestamp）
+//   STATE_ACQUIRED vuEngineAcquireLatestState 返回
+//   OBSERVATIONS   目標觀察結果提取完成
+//   BACKGROUND     視頻背景繪製完成
+//   SWAPPED        本幀繪製完成、交給 swap
+//
+// GLSurfaceView 在 onDrawFrame 返回後立即 eglSwapBuffers，native 側無法在 swap
+// 之後打點，因此 SWAPPED 在渲染函數結束（endFrame）時打點並立即結算本幀。
+// 不能推遲到下一幀入口：節拍降頻或渲染暫停時兩幀之間的空閒時間會被算進延遲。
+// 所有打點只由渲染線程調用，查詢可以在任意線程進行。
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "VuforiaEngine/VuforiaEngine.h"
+
+namespace VuforiaWrapper {
+
+    enum class LatencyStage {
+        CAPTURE = 0,
+        STATE_ACQUIRED = 1,
+        OBSERVATIONS = 2,
+        BACKGROUND = 3,
+        SWAPPED = 4,
+        COUNT = 5
+    };
+
+    // 統計的區間：相鄰階段之間，加上端到端
+    enum class LatencyMetric {
+        CAPTURE_TO_STATE = 0,
+        STATE_TO_OBSERVATIONS = 1,
+        OBSERVATIONS_TO_BACKGROUND = 2,
+        BACKGROUND_TO_SWAP = 3,
+        END_TO_END = 4,
+        COUNT = 5
+    };
+
+    // 單個區間的統計摘要（毫秒）
+    struct LatencySummary {
+        uint32_t count;
+        float p50;
+        float p90;
+        float p99;
+        float max;
+
+        LatencySummary() : count(0), p50(0.0f), p90(0.0f), p99(0.0f), max(0.0f) {}
+    };
+
+    class FrameLatencyTracker {
+    public:
+        // 滾動窗口大小（樣本數）
+        static constexpr size_t WINDOW_SIZE = 512;
+        // 直方圖桶上界（毫秒），最後一個桶收集更大的值
+        static constexpr size_t BUCKET_COUNT = 12;
+        static const float BUCKET_LIMITS_MS[BUCKET_COUNT - 1];
+
+        FrameLatencyTracker();
+
+        // ==================== 渲染線程打點 ====================
+
+        // 幀入口：開始新的一幀
+        void beginFrame();
+
+        // 從 VuState 的相機幀讀取曝光時間戳
+        void stampCapture(const VuState* state);
+
+        void stamp(LatencyStage stage);
+
+        // 本幀的相機曝光時間（CLOCK_MONOTONIC），沒有可用時間戳時返回 -1
+        int64_t getCaptureTimeNs() const {
+            return mFrameOpen ? mStamps[static_cast<size_t>(LatencyStage::CAPTURE)] : -1;
+        }
+
+        // 本幀繪製結束：打點 SWAPPED 並結算（沒有繪製背景的幀不參與統計）
+        void endFrame();
+
+        // 丟棄未完成的幀（例如 surface 銷毀、引擎暫停）
+        void discardFrame();
+
+        // ==================== 查詢（任意線程） ====================
+
+        LatencySummary getSummary(LatencyMetric metric) const;
+
+        // 直方圖桶計數，counts 至少 BUCKET_COUNT 個元素
+        void getHistogram(LatencyMetric metric, uint32_t* counts) const;
+
+        std::string getReport() const;
+
+        // 清空統計窗口（不影響渲染線程正在打點的幀）
+        void reset();
+
+        // 週期日誌間隔
+        void setLogInterval(std::chrono::milliseconds interval) { mLogInterval = interval; }
+
+        static const char* metricName(LatencyMetric metric);
+
+    private:
+        struct MetricWindow {
+            float samples[WINDOW_SIZE];
+            uint32_t buckets[BUCKET_COUNT];
+            size_t next;
+            size_t size;
+        };
+
+        void recordFrame();
+        void addSampleLocked(LatencyMetric metric, float milliseconds);
+        LatencySummary summarizeLocked(LatencyMetric metric) const;
+        void maybeLogLocked(int64_t nowNs);
+
+        static int64_t steadyNowNs();
+        static size_t bucketFor(float milliseconds);
+
+        // 渲染線程私有的當前幀打點（-1 表示未打點）
+        int64_t mStamps[static_cast<size_t>(LatencyStage::COUNT)];
+        bool mFrameOpen;
+
+        // 相機時間戳與 CLOCK_MONOTONIC 的偏移（相機可能使用 CLOCK_BOOTTIME）
+        enum class CameraClock { UNKNOWN, MONOTONIC, BOOTTIME, UNUSABLE };
+        CameraClock mCameraClock;
+
+        mutable std::mutex mMutex;
+        MetricWindow mWindows[static_cast<size_t>(LatencyMetric::COUNT)];
+        uint64_t mFrameCount;
+        int64_t mLastLogNs;
+        std::chrono::milliseconds mLogInterval;
+    };
+}
+
+#endif // LATENCY_TRACKER_H
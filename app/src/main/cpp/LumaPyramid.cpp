@@ -0,0 +1,148 @@
+// ==================== LumaPyramid.cpp ====================
+// 每幀共享的亮度金字塔與對象池
+
+#include "LumaPyramid.h"
+#include <algorithm>
+
+namespace VuforiaWrapper {
+
+    // 2x2 均值降採樣（四捨五入）
+    static void downsample2x(const LumaPyramidLevel& src, uint8_t* dst, int32_t dstStride,
+                             int32_t dstWidth, int32_t dstHeight) {
+        for (int32_t y = 0; y < dstHeight; ++y) {
+            const uint8_t* row0 = src.data + static_cast<size_t>(y * 2) * src.stride;
+            const uint8_t* row1 = row0 + src.stride;
+            uint8_t* out = dst + static_cast<size_t>(y) * dstStride;
+            for (int32_t x = 0; x < dstWidth; ++x) {
+                const int sum = row0[x * 2] + row0[x * 2 + 1] + row1[x * 2] + row1[x * 2 + 1];
+                out[x] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    // ==================== LumaPyramid ====================
+    bool LumaPyramid::build(const CameraFrameData& frame, int levelCount) {
+        if (!frame.hasImage() || levelCount <= 0) {
+            return false;
+        }
+
+        // 第 0 層：NV12 / NV21 的亮度平面或灰度圖本身
+        LumaPyramidLevel base;
+        if (frame.format == VU_IMAGE_PIXEL_FORMAT_GRAYSCALE) {
+            base.data = frame.buffer;
+            base.stride = frame.stride;
+        } else {
+            ImageConversion::YuvPlanes planes;
+            if (!frame.getYuvPlanes(planes)) {
+                return false;
+            }
+            base.data = planes.y;
+            base.stride = planes.yStride;
+        }
+        base.width = frame.width;
+        base.height = frame.height;
+
+        // resize 只在容量不足時分配，穩態下不觸發
+        mLevels.resize(1);
+        mLevels[0] = base;
+        if (mBuffers.size() < static_cast<size_t>(levelCount - 1)) {
+            mBuffers.resize(levelCount - 1);
+        }
+
+        for (int level = 1; level < levelCount; ++level) {
+            const LumaPyramidLevel& parent = mLevels[level - 1];
+            const int32_t width = parent.width / 2;
+            const int32_t height = parent.height / 2;
+            if (width <= 0 || height <= 0) {
+                break;
+            }
+
+            // 每行按對齊寬度排列，方便 SIMD 消費者
+            const int32_t stride = static_cast<int32_t>(
+                (static_cast<size_t>(width) + ImageConversion::IMAGE_BUFFER_ALIGNMENT - 1) &
+                ~(ImageConversion::IMAGE_BUFFER_ALIGNMENT - 1));
+            ImageConversion::AlignedImageBuffer& buffer = mBuffers[level - 1];
+            if (!buffer.resize(static_cast<size_t>(stride) * height)) {
+                return false;
+            }
+
+            downsample2x(parent, buffer.data(), stride, width, height);
+
+            LumaPyramidLevel current;
+            current.data = buffer.data();
+            current.width = width;
+            current.height = height;
+            current.stride = stride;
+            mLevels.push_back(current);
+        }
+
+        mSource = frame.image;
+        mTimestamp = frame.timestamp;
+        return true;
+    }
+
+    void LumaPyramid::reset() {
+        mSource.reset();
+        mLevels.clear();
+        mTimestamp = -1;
+    }
+
+    // ==================== LumaPyramidCache ====================
+    void LumaPyramidCache::setLevelCount(int levelCount) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLevelCount = std::min(std::max(levelCount, 0), MAX_LEVELS);
+        // 層數變化後舊金字塔不再符合要求
+        mCurrent.reset();
+        LOGI("🔺 Luma pyramid levels set to %d", mLevelCount);
+    }
+
+    int LumaPyramidCache::getLevelCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLevelCount;
+    }
+
+    std::shared_ptr<const LumaPyramid> LumaPyramidCache::acquire(const CameraFrameData& frame) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mLevelCount <= 0) {
+            return nullptr;
+        }
+
+        // 同一幀已經構建過，直接共享
+        if (mCurrent && mCurrent->getTimestamp() == frame.timestamp) {
+            return mCurrent;
+        }
+
+        std::shared_ptr<LumaPyramid> pyramid = takeFreePyramid();
+        if (!pyramid->build(frame, mLevelCount)) {
+            pyramid->reset();
+            return nullptr;
+        }
+
+        mCurrent = pyramid;
+        return mCurrent;
+    }
+
+    std::shared_ptr<LumaPyramid> LumaPyramidCache::takeFreePyramid() {
+        // 只被池持有（use_count == 1）的對象可以重用；當前金字塔由 mCurrent 額外持有
+        for (auto& pyramid : mPool) {
+            if (pyramid.use_count() == 1) {
+                return pyramid;
+            }
+        }
+
+        mPool.push_back(std::make_shared<LumaPyramid>());
+        LOGD("Luma pyramid pool grew to %zu", mPool.size());
+        return mPool.back();
+    }
+
+    void LumaPyramidCache::clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCurrent.reset();
+        for (auto& pyramid : mPool) {
+            if (pyramid.use_count() == 1) {
+                pyramid->reset();
+            }
+        }
+    }
+}
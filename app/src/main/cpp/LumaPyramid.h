@@ -0,0 +1,79 @@
+#ifndef LUMA_PYRAMID_H
+#define LUMA_PYRAMID_H
+
+// ==================== 亮度金字塔 ====================
+// 每個相機幀最多構建一次的 2 倍降採樣灰度金字塔：
+//  - 以 VuCameraFrame 時間戳為鍵，第一個請求者觸發構建，後續請求者共享結果
+//  - 第 0 層直接引用相機亮度平面（零拷貝），其餘層為 2x2 均值降採樣
+//  - 金字塔對象和各層緩衝區來自可重用的池，穩態下不做內存分配
+
+#include "VuforiaWrapper.h"
+#include "ImageConversion.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace VuforiaWrapper {
+
+    // 金字塔單層視圖
+    struct LumaPyramidLevel {
+        const uint8_t* data;
+        int32_t width;
+        int32_t height;
+        int32_t stride;
+
+        LumaPyramidLevel() : data(nullptr), width(0), height(0), stride(0) {}
+    };
+
+    class LumaPyramid {
+    public:
+        LumaPyramid() : mTimestamp(-1) {}
+
+        int64_t getTimestamp() const { return mTimestamp; }
+        int getLevelCount() const { return static_cast<int>(mLevels.size()); }
+        const LumaPyramidLevel& getLevel(int index) const { return mLevels[index]; }
+
+    private:
+        friend class LumaPyramidCache;
+
+        // 從相機幀構建指定層數（包含第 0 層）
+        bool build(const CameraFrameData& frame, int levelCount);
+        void reset();
+
+        int64_t mTimestamp;
+        CameraImageRef mSource;  // 保持第 0 層引用的相機緩衝區有效
+        std::vector<LumaPyramidLevel> mLevels;
+        std::vector<ImageConversion::AlignedImageBuffer> mBuffers;
+    };
+
+    class LumaPyramidCache {
+    public:
+        // 最多保留的金字塔層數上限
+        static constexpr int MAX_LEVELS = 8;
+
+        LumaPyramidCache() : mLevelCount(0) {}
+
+        // 設置層數（包含第 0 層），0 表示停用
+        void setLevelCount(int levelCount);
+        int getLevelCount() const;
+
+        /**
+         * 取得指定幀的金字塔，同一時間戳只構建一次
+         * @return 停用、格式不支持或構建失敗時返回 nullptr
+         */
+        std::shared_ptr<const LumaPyramid> acquire(const CameraFrameData& frame);
+
+        // 釋放當前金字塔與池中所有空閒對象（引擎清理時調用）
+        void clear();
+
+    private:
+        std::shared_ptr<LumaPyramid> takeFreePyramid();
+
+        mutable std::mutex mMutex;
+        int mLevelCount;
+        std::shared_ptr<LumaPyramid> mCurrent;
+        std::vector<std::shared_ptr<LumaPyramid>> mPool;
+    };
+}
+
+#endif // LUMA_PYRAMID_H
@@ -0,0 +1,255 @@
+// ==================== PoseExtrapolator.cpp ====================
+// 每目標運動模型與批量姿態外推
+
+#include "PoseExtrapolator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VuforiaWrapper {
+
+    // 列主序旋轉矩陣 → 單位四元數（x, y, z, w）
+    static void matrixToQuaternion(const VuMatrix44F& m, float q[4]) {
+        const float r00 = m.data[0], r10 = m.data[1], r20 = m.data[2];
+        const float r01 = m.data[4], r11 = m.data[5], r21 = m.data[6];
+        const float r02 = m.data[8], r12 = m.data[9], r22 = m.data[10];
+        const float trace = r00 + r11 + r22;
+        if (trace > 0.0f) {
+            const float s = std::sqrt(trace + 1.0f) * 2.0f;
+            q[3] = 0.25f * s;
+            q[0] = (r21 - r12) / s;
+            q[1] = (r02 - r20) / s;
+            q[2] = (r10 - r01) / s;
+        } else if (r00 > r11 && r00 > r22) {
+            const float s = std::sqrt(1.0f + r00 - r11 - r22) * 2.0f;
+            q[3] = (r21 - r12) / s;
+            q[0] = 0.25f * s;
+            q[1] = (r01 + r10) / s;
+            q[2] = (r02 + r20) / s;
+        } else if (r11 > r22) {
+            const float s = std::sqrt(1.0f + r11 - r00 - r22) * 2.0f;
+            q[3] = (r02 - r20) / s;
+            q[0] = (r01 + r10) / s;
+            q[1] = 0.25f * s;
+            q[2] = (r12 + r21) / s;
+        } else {
+            const float s = std::sqrt(1.0f + r22 - r00 - r11) * 2.0f;
+            q[3] = (r10 - r01) / s;
+            q[0] = (r02 + r20) / s;
+            q[1] = (r12 + r21) / s;
+            q[2] = 0.25f * s;
+        }
+    }
+
+    static void quaternionToMatrix(float x, float y, float z, float w,
+                                   float px, float py, float pz, VuMatrix44F& m) {
+        m.data[0] = 1.0f - 2.0f * (y * y + z * z);
+        m.data[1] = 2.0f * (x * y + z * w);
+        m.data[2] = 2.0f * (x * z - y * w);
+        m.data[3] = 0.0f;
+        m.data[4] = 2.0f * (x * y - z * w);
+        m.data[5] = 1.0f - 2.0f * (x * x + z * z);
+        m.data[6] = 2.0f * (y * z + x * w);
+        m.data[7] = 0.0f;
+        m.data[8] = 2.0f * (x * z + y * w);
+        m.data[9] = 2.0f * (y * z - x * w);
+        m.data[10] = 1.0f - 2.0f * (x * x + y * y);
+        m.data[11] = 0.0f;
+        m.data[12] = px;
+        m.data[13] = py;
+        m.data[14] = pz;
+        m.data[15] = 1.0f;
+    }
+
+    static inline bool isTrackedStatus(int32_t poseStatus) {
+        return poseStatus == VU_OBSERVATION_POSE_STATUS_TRACKED ||
+               poseStatus == VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED;
+    }
+
+    PoseExtrapolator::PoseExtrapolator() : mEnabled(true) {
+        resetAll();
+    }
+
+    void PoseExtrapolator::resetAll() {
+        for (size_t i = 0; i < MAX_TARGETS; ++i) {
+            reset(static_cast<int32_t>(i));
+            mStatus[i] = 0;
+            mPx[i] = mPy[i] = mPz[i] = 0.0f;
+            mQx[i] = mQy[i] = mQz[i] = 0.0f;
+            mQw[i] = 1.0f;
+            mSampleTime[i] = 0;
+            mOutPx[i] = mOutPy[i] = mOutPz[i] = 0.0f;
+            mOutQx[i] = mOutQy[i] = mOutQz[i] = 0.0f;
+            mOutQw[i] = 1.0f;
+            mOutDt[i] = 0.0f;
+        }
+    }
+
+    void PoseExtrapolator::reset(int32_t targetId) {
+        if (targetId < 0 || static_cast<size_t>(targetId) >= MAX_TARGETS) {
+            return;
+        }
+        const size_t i = static_cast<size_t>(targetId);
+        mHistNext[i] = 0;
+        mHistCount[i] = 0;
+        mVx[i] = mVy[i] = mVz[i] = 0.0f;
+        mWx[i] = mWy[i] = mWz[i] = 0.0f;
+        mConfidence[i] = 0.0f;
+        mGain[i] = 0.0f;
+    }
+
+    void PoseExtrapolator::pushHistory(size_t index, const float position[3], const float rotation[4],
+                                       int64_t timestampNs) {
+        const size_t slot = mHistNext[index];
+        mHistPx[slot][index] = position[0];
+        mHistPy[slot][index] = position[1];
+        mHistPz[slot][index] = position[2];
+        mHistQx[slot][index] = rotation[0];
+        mHistQy[slot][index] = rotation[1];
+        mHistQz[slot][index] = rotation[2];
+        mHistQw[slot][index] = rotation[3];
+        mHistTime[slot][index] = timestampNs;
+        mHistNext[index] = static_cast<uint32_t>((slot + 1) % HISTORY);
+        mHistCount[index] = std::min<uint32_t>(mHistCount[index] + 1, HISTORY);
+    }
+
+    void PoseExtrapolator::addSample(int32_t targetId, int32_t poseStatus, const VuMatrix44F& pose,
+                                     int64_t timestampNs) {
+        if (targetId < 0 || static_cast<size_t>(targetId) >= MAX_TARGETS) {
+            return;
+        }
+        const size_t i = static_cast<size_t>(targetId);
+
+        // 狀態變化時運動不連續（例如從直接追蹤切換到擴展追蹤），重新開始
+        if (poseStatus != mStatus[i]) {
+            reset(targetId);
+            mStatus[i] = poseStatus;
+        }
+
+        // 渲染快於相機時同一相機幀會被觀察多次，重複的曝光時間不是新樣本
+        if (mHistCount[i] > 0 && timestampNs <= mSampleTime[i]) {
+            return;
+        }
+
+        const float position[3] = {pose.data[12], pose.data[13], pose.data[14]};
+        float rotation[4];
+        matrixToQuaternion(pose, rotation);
+
+        // 保持四元數符號連續，q 與 -q 表示同一旋轉
+        if (mHistCount[i] > 0 &&
+            rotation[0] * mQx[i] + rotation[1] * mQy[i] + rotation[2] * mQz[i] + rotation[3] * mQw[i] < 0.0f) {
+            for (float& component : rotation) {
+                component = -component;
+            }
+        }
+
+        // 用上一個模型預測本樣本，偏差越大置信度越低
+        float fit = 0.0f;
+        if (mHistCount[i] >= 2) {
+            const float dt = static_cast<float>(timestampNs - mSampleTime[i]) * 1e-9f;
+            const float ex = mPx[i] + mVx[i] * dt - position[0];
+            const float ey = mPy[i] + mVy[i] * dt - position[1];
+            const float ez = mPz[i] + mVz[i] * dt - position[2];
+            const float error = std::sqrt(ex * ex + ey * ey + ez * ez);
+            fit = 1.0f / (1.0f + error / mConfig.residualScale);
+        }
+
+        pushHistory(i, position, rotation, timestampNs);
+        mPx[i] = position[0];
+        mPy[i] = position[1];
+        mPz[i] = position[2];
+        mQx[i] = rotation[0];
+        mQy[i] = rotation[1];
+        mQz[i] = rotation[2];
+        mQw[i] = rotation[3];
+        mSampleTime[i] = timestampNs;
+
+        // 由窗口內最新與最舊樣本估計速度（窗口平均，抑制單幀抖動）
+        const uint32_t count = mHistCount[i];
+        mVx[i] = mVy[i] = mVz[i] = 0.0f;
+        mWx[i] = mWy[i] = mWz[i] = 0.0f;
+        if (count >= 2) {
+            const size_t oldest = (mHistNext[i] + HISTORY - count) % HISTORY;
+            const float span = static_cast<float>(timestampNs - mHistTime[oldest][i]) * 1e-9f;
+            if (span > 0.0f) {
+                const float inv = 1.0f / span;
+                mVx[i] = (position[0] - mHistPx[oldest][i]) * inv;
+                mVy[i] = (position[1] - mHistPy[oldest][i]) * inv;
+                mVz[i] = (position[2] - mHistPz[oldest][i]) * inv;
+
+                // dq = q_new * conj(q_old)，轉成軸角後除以時間
+                const float ox = -mHistQx[oldest][i], oy = -mHistQy[oldest][i];
+                const float oz = -mHistQz[oldest][i], ow = mHistQw[oldest][i];
+                float dx = rotation[3] * ox + rotation[0] * ow + rotation[1] * oz - rotation[2] * oy;
+                float dy = rotation[3] * oy - rotation[0] * oz + rotation[1] * ow + rotation[2] * ox;
+                float dz = rotation[3] * oz + rotation[0] * oy - rotation[1] * ox + rotation[2] * ow;
+                float dw = rotation[3] * ow - rotation[0] * ox - rotation[1] * oy - rotation[2] * oz;
+                if (dw < 0.0f) {
+                    dx = -dx; dy = -dy; dz = -dz; dw = -dw;
+                }
+                const float sinHalf = std::sqrt(dx * dx + dy * dy + dz * dz);
+                const float angle = 2.0f * std::atan2(sinHalf, dw);
+                const float scale = sinHalf > 1e-6f ? angle / sinHalf * inv : 2.0f * inv;
+                mWx[i] = dx * scale;
+                mWy[i] = dy * scale;
+                mWz[i] = dz * scale;
+            }
+        }
+
+        const float linearSpeed = std::sqrt(mVx[i] * mVx[i] + mVy[i] * mVy[i] + mVz[i] * mVz[i]);
+        const float angularSpeed = std::sqrt(mWx[i] * mWx[i] + mWy[i] * mWy[i] + mWz[i] * mWz[i]);
+        if (linearSpeed > mConfig.maxLinearSpeed || angularSpeed > mConfig.maxAngularSpeed) {
+            // 姿態跳變（重新定位或誤檢），只保留當前樣本重新累積
+            reset(targetId);
+            pushHistory(i, position, rotation, timestampNs);
+        } else if (count >= 2 && isTrackedStatus(poseStatus)) {
+            const float warmup = static_cast<float>(count - 1) / static_cast<float>(HISTORY - 1);
+            mConfidence[i] = warmup * fit;
+        } else {
+            mConfidence[i] = 0.0f;
+        }
+
+        mGain[i] = (isEnabled() && mConfidence[i] >= mConfig.minConfidence) ? 1.0f : 0.0f;
+    }
+
+    void PoseExtrapolator::predict(int64_t displayTimeNs) {
+        const float horizon = mConfig.maxHorizonMs * 1e-3f;
+
+        // 無分支遍歷全部槽位：沒有模型的目標 gain 為 0，結果就是最新樣本
+        for (size_t i = 0; i < MAX_TARGETS; ++i) {
+            float dt = static_cast<float>(displayTimeNs - mSampleTime[i]) * 1e-9f;
+            dt = std::min(std::max(dt, 0.0f), horizon) * mGain[i];
+            mOutDt[i] = dt;
+
+            mOutPx[i] = mPx[i] + mVx[i] * dt;
+            mOutPy[i] = mPy[i] + mVy[i] * dt;
+            mOutPz[i] = mPz[i] + mVz[i] * dt;
+
+            // 一階四元數積分 q' = q + dt/2 * (ω ⊗ q)，再歸一化
+            const float h = 0.5f * dt;
+            const float qx = mQx[i] + h * (mWx[i] * mQw[i] + mWy[i] * mQz[i] - mWz[i] * mQy[i]);
+            const float qy = mQy[i] + h * (mWy[i] * mQw[i] + mWz[i] * mQx[i] - mWx[i] * mQz[i]);
+            const float qz = mQz[i] + h * (mWz[i] * mQw[i] + mWx[i] * mQy[i] - mWy[i] * mQx[i]);
+            const float qw = mQw[i] - h * (mWx[i] * mQx[i] + mWy[i] * mQy[i] + mWz[i] * mQz[i]);
+            const float norm = 1.0f / std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+            mOutQx[i] = qx * norm;
+            mOutQy[i] = qy * norm;
+            mOutQz[i] = qz * norm;
+            mOutQw[i] = qw * norm;
+        }
+    }
+
+    bool PoseExtrapolator::getPredicted(int32_t targetId, VuMatrix44F& pose, int64_t& timestampNs,
+                                        float& confidence) const {
+        if (targetId < 0 || static_cast<size_t>(targetId) >= MAX_TARGETS ||
+            mHistCount[targetId] == 0) {
+            return false;
+        }
+        const size_t i = static_cast<size_t>(targetId);
+        quaternionToMatrix(mOutQx[i], mOutQy[i], mOutQz[i], mOutQw[i],
+                           mOutPx[i], mOutPy[i], mOutPz[i], pose);
+        timestampNs = mSampleTime[i] + static_cast<int64_t>(mOutDt[i] * 1e9f);
+        confidence = mConfidence[i];
+        return true;
+    }
+}
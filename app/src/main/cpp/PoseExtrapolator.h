@@ -0,0 +1,100 @@
+#ifndef POSE_EXTRAPOLATOR_H
+#define POSE_EXTRAPOLATOR_H
+
+// ==================== 姿態外推 ====================
+// extractTargetObservations 拿到的姿態與相機幀同齡，畫面卻要在相機到顯示的
+// 延遲之後才出現。這裡為每個目標維護一個運動模型：
+//  - 最近幾個姿態樣本放在小環形緩衝中，由最新與最舊樣本估計線速度與角速度
+//  - 新樣本與上一次模型預測的偏差決定置信度，低於門檻時不外推（只輸出最新姿態）
+//  - 姿態狀態變化（例如 TRACKED → EXTENDED_TRACKED）時重置模型
+//
+// 所有狀態按字段分開存放（SoA），predict() 對全部目標做一次無分支的線性遍歷，
+// 編譯器可以直接向量化。除 setEnabled 外只由渲染線程訪問，不加鎖。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "VuforiaEngine/VuforiaEngine.h"
+
+namespace VuforiaWrapper {
+
+    struct PoseExtrapolatorConfig {
+        float minConfidence = 0.5f;       // 低於此置信度不外推
+        float maxHorizonMs = 100.0f;      // 最長外推時間
+        float maxLinearSpeed = 3.0f;      // 米 / 秒，超過視為跳變
+        float maxAngularSpeed = 6.0f;     // 弧度 / 秒
+        float residualScale = 0.01f;      // 預測誤差達到此值（米）時置信度減半
+    };
+
+    class PoseExtrapolator {
+    public:
+        static constexpr size_t MAX_TARGETS = 32;   // 與姿態流槽位數一致
+        static constexpr size_t HISTORY = 4;        // 每個目標保留的樣本數
+
+        PoseExtrapolator();
+
+        void setConfig(const PoseExtrapolatorConfig& config) { mConfig = config; }
+        const PoseExtrapolatorConfig& getConfig() const { return mConfig; }
+
+        // 任意線程可調用，下一個樣本生效
+        void setEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+        bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        /**
+         * 加入一個觀察樣本並更新該目標的速度估計
+         * @param poseStatus VuObservationPoseStatus，與上一個樣本不同時重置模型
+         * @param timestampNs 樣本時間（CLOCK_MONOTONIC，優先使用相機曝光時間），不晚於上一個樣本時忽略
+         */
+        void addSample(int32_t targetId, int32_t poseStatus, const VuMatrix44F& pose, int64_t timestampNs);
+
+        /**
+         * 一次遍歷把所有目標外推到預計的顯示時間
+         */
+        void predict(int64_t displayTimeNs);
+
+        /**
+         * 取得最近一次 predict() 的結果；置信度不足或停用時就是最新樣本
+         * @param timestampNs 輸出姿態對應的時間
+         * @return 目標沒有樣本時返回 false
+         */
+        bool getPredicted(int32_t targetId, VuMatrix44F& pose, int64_t& timestampNs, float& confidence) const;
+
+        void reset(int32_t targetId);
+        void resetAll();
+
+    private:
+        void pushHistory(size_t index, const float position[3], const float rotation[4], int64_t timestampNs);
+
+        PoseExtrapolatorConfig mConfig;
+        std::atomic<bool> mEnabled;
+
+        // ==================== 歷史樣本環（SoA） ====================
+        float mHistPx[HISTORY][MAX_TARGETS];
+        float mHistPy[HISTORY][MAX_TARGETS];
+        float mHistPz[HISTORY][MAX_TARGETS];
+        float mHistQx[HISTORY][MAX_TARGETS];
+        float mHistQy[HISTORY][MAX_TARGETS];
+        float mHistQz[HISTORY][MAX_TARGETS];
+        float mHistQw[HISTORY][MAX_TARGETS];
+        int64_t mHistTime[HISTORY][MAX_TARGETS];
+        uint32_t mHistNext[MAX_TARGETS];
+        uint32_t mHistCount[MAX_TARGETS];
+
+        // ==================== 運動模型（SoA） ====================
+        float mPx[MAX_TARGETS], mPy[MAX_TARGETS], mPz[MAX_TARGETS];
+        float mQx[MAX_TARGETS], mQy[MAX_TARGETS], mQz[MAX_TARGETS], mQw[MAX_TARGETS];
+        float mVx[MAX_TARGETS], mVy[MAX_TARGETS], mVz[MAX_TARGETS];
+        float mWx[MAX_TARGETS], mWy[MAX_TARGETS], mWz[MAX_TARGETS];
+        int64_t mSampleTime[MAX_TARGETS];
+        float mConfidence[MAX_TARGETS];
+        float mGain[MAX_TARGETS];          // 1 = 外推，0 = 輸出最新樣本
+        int32_t mStatus[MAX_TARGETS];
+
+        // ==================== 預測結果（SoA） ====================
+        float mOutPx[MAX_TARGETS], mOutPy[MAX_TARGETS], mOutPz[MAX_TARGETS];
+        float mOutQx[MAX_TARGETS], mOutQy[MAX_TARGETS], mOutQz[MAX_TARGETS], mOutQw[MAX_TARGETS];
+        float mOutDt[MAX_TARGETS];
+    };
+}
+
+#endif // POSE_EXTRAPOLATOR_H
@@ -0,0 +1,135 @@
+// ==================== PoseStreamTable.cpp ====================
+// 序號鎖保護的每目標姿態共享表
+
+#include "PoseStreamTable.h"
+#include <cstring>
+#include <new>
+
+namespace VuforiaWrapper {
+
+    // 讀者與寫入衝突時的最大重試次數，寫入只有幾十字節，正常情況一次成功
+    static const int kMaxReadRetries = 8;
+
+    PoseStreamTable::PoseStreamTable()
+        : mWrittenMask(0) {
+        memset(mStorage, 0, sizeof(mStorage));
+
+        PoseStreamHeader* head = new (mStorage) PoseStreamHeader();
+        head->magic = POSE_STREAM_MAGIC;
+        head->version = POSE_STREAM_VERSION;
+        head->capacity = static_cast<uint32_t>(POSE_STREAM_MAX_TARGETS);
+        head->slotSize = static_cast<uint32_t>(sizeof(PoseStreamSlot));
+        head->targetCount.store(0, std::memory_order_relaxed);
+        head->frameSequence.store(0, std::memory_order_relaxed);
+        head->updateTimeNs.store(0, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < POSE_STREAM_MAX_TARGETS; ++i) {
+            PoseStreamSlot* entry = new (slot(i)) PoseStreamSlot();
+            entry->sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool PoseStreamTable::write(int32_t targetId, int32_t poseStatus, const VuMatrix44F& pose,
+                                int64_t timestampNs, uint64_t frameSequence) {
+        if (targetId < 0 || static_cast<size_t>(targetId) >= POSE_STREAM_MAX_TARGETS) {
+            return false;
+        }
+
+        PoseStreamSlot* entry = slot(static_cast<size_t>(targetId));
+        const uint32_t sequence = entry->sequence.load(std::memory_order_relaxed);
+        entry->sequence.store(sequence + 1, std::memory_order_relaxed);
+        // 奇數序號必須先於字段寫入可見
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry->poseStatus = poseStatus;
+        entry->timestampNs = timestampNs;
+        entry->frameSequence = frameSequence;
+        memcpy(entry->pose, pose.data, sizeof(entry->pose));
+
+        entry->sequence.store(sequence + 2, std::memory_order_release);
+        mWrittenMask |= 1u << targetId;
+
+        PoseStreamHeader* head = header();
+        const uint32_t count = static_cast<uint32_t>(targetId) + 1;
+        if (head->targetCount.load(std::memory_order_relaxed) < count) {
+            head->targetCount.store(count, std::memory_order_release);
+        }
+        return true;
+    }
+
+    void PoseStreamTable::markNotObserved(size_t index) {
+        PoseStreamSlot* entry = slot(index);
+        if (entry->poseStatus == 0 || entry->poseStatus == VU_OBSERVATION_POSE_STATUS_NO_POSE) {
+            return;
+        }
+
+        const uint32_t sequence = entry->sequence.load(std::memory_order_relaxed);
+        entry->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry->poseStatus = VU_OBSERVATION_POSE_STATUS_NO_POSE;
+        entry->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void PoseStreamTable::commitFrame(uint64_t frameSequence, int64_t updateTimeNs) {
+        // 不在本幀觀察列表中的目標不再有當前姿態
+        const uint32_t count = getTargetCount();
+        for (uint32_t i = 0; i < count; ++i) {
+            if ((mWrittenMask & (1u << i)) == 0) {
+                markNotObserved(i);
+            }
+        }
+        mWrittenMask = 0;
+
+        PoseStreamHeader* head = header();
+        head->updateTimeNs.store(updateTimeNs, std::memory_order_relaxed);
+        head->frameSequence.store(frameSequence, std::memory_order_release);
+    }
+
+    void PoseStreamTable::reset() {
+        VuMatrix44F identity;
+        memset(&identity, 0, sizeof(identity));
+        identity.data[0] = identity.data[5] = identity.data[10] = identity.data[15] = 1.0f;
+
+        const uint32_t count = getTargetCount();
+        for (uint32_t i = 0; i < count; ++i) {
+            write(static_cast<int32_t>(i), 0, identity, 0, 0);
+        }
+        mWrittenMask = 0;
+    }
+
+    bool PoseStreamTable::read(int32_t targetId, int32_t& poseStatus, VuMatrix44F& pose,
+                               int64_t& timestampNs, uint64_t& frameSequence) const {
+        if (targetId < 0 || static_cast<uint32_t>(targetId) >= getTargetCount()) {
+            return false;
+        }
+
+        const PoseStreamSlot* entry = slot(static_cast<size_t>(targetId));
+        for (int attempt = 0; attempt < kMaxReadRetries; ++attempt) {
+            const uint32_t before = entry->sequence.load(std::memory_order_acquire);
+            if (before & 1u) {
+                continue;
+            }
+
+            poseStatus = entry->poseStatus;
+            timestampNs = entry->timestampNs;
+            frameSequence = entry->frameSequence;
+            memcpy(pose.data, entry->pose, sizeof(entry->pose));
+
+            // 字段讀取必須先於第二次序號讀取完成
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry->sequence.load(std::memory_order_relaxed) == before) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t PoseStreamTable::getTargetCount() const {
+        return header()->targetCount.load(std::memory_order_acquire);
+    }
+
+    PoseStreamTable& getPoseStreamTable() {
+        static PoseStreamTable table;
+        return table;
+    }
+}
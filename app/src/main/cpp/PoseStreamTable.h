@@ -0,0 +1,120 @@
+#ifndef POSE_STREAM_TABLE_H
+#define POSE_STREAM_TABLE_H
+
+// ==================== 連續姿態共享表 ====================
+// 每個目標一個固定位置的槽位，渲染線程每幀原地更新最新姿態、狀態與時間戳。
+// 整塊內存通過 DirectByteBuffer 直接暴露給 Java / Filament，讀取時不需要 JNI 調用，
+// 也不分配對象。目標事件只在狀態變化時分發，這裡則是持續的姿態流。
+//
+// 每個槽位由序號鎖（seqlock）保護：
+//  - 寫入者把 sequence 加一（奇數 = 寫入中），寫完字段後再加一（偶數）
+//  - 讀者讀 sequence → 讀字段 → 再讀 sequence，兩次相同且為偶數才算有效，否則重讀
+// 只有一個寫入者（渲染線程），讀者永遠不會阻塞寫入者。
+//
+// 每幀 commitFrame 時，本幀沒有寫入的槽位（目標不在觀察列表中）標記為 NO_POSE，
+// 姿態、時間戳與幀序號保留最後一次觀察的值，讀者不會把過期姿態當作當前姿態。
+//
+// 內存佈局（本機字節序，Java 端需 order(ByteOrder.nativeOrder())）：
+//   [0, 64)          頭部，見 PoseStreamHeader
+//   [64 + i * 128)   第 i 個目標的槽位，見 PoseStreamSlot；i 即 TargetEventManager 的目標 ID
+// 佈局變化時必須同步修改 VuforiaCoreManager.PoseStream 中的偏移常量並提升 version。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "VuforiaEngine/VuforiaEngine.h"
+
+namespace VuforiaWrapper {
+
+    static constexpr uint32_t POSE_STREAM_MAGIC = 0x50534554;   // 'PSET'
+    static constexpr uint32_t POSE_STREAM_VERSION = 1;
+    static constexpr size_t POSE_STREAM_MAX_TARGETS = 32;
+
+    struct PoseStreamHeader {
+        uint32_t magic;                          // 0
+        uint32_t version;                        // 4
+        uint32_t capacity;                       // 8   槽位數量
+        uint32_t slotSize;                       // 12  槽位字節數
+        std::atomic<uint32_t> targetCount;       // 16  已使用的槽位數（最大目標 ID + 1）
+        uint32_t reserved0;                      // 20
+        std::atomic<uint64_t> frameSequence;     // 24  最近一次更新對應的相機幀序號
+        std::atomic<int64_t> updateTimeNs;       // 32  最近一次更新的時間（CLOCK_MONOTONIC）
+        uint8_t reserved[24];                    // 40
+    };
+
+    struct PoseStreamSlot {
+        std::atomic<uint32_t> sequence;          // 0   序號鎖，奇數表示寫入中
+        int32_t poseStatus;                      // 4   VuObservationPoseStatus，0 表示從未觀察到
+        int64_t timestampNs;                     // 8   姿態對應的時間（CLOCK_MONOTONIC）
+        uint64_t frameSequence;                  // 16  姿態所屬的相機幀序號
+        float pose[16];                          // 24  列主序 4x4 姿態矩陣
+        uint8_t reserved[40];                    // 88
+    };
+
+    static_assert(POSE_STREAM_MAX_TARGETS <= 32, "Written-slot mask is a 32-bit word");
+    static_assert(sizeof(PoseStreamHeader) == 64, "PoseStreamHeader layout is shared with Java");
+    static_assert(sizeof(PoseStreamSlot) == 128, "PoseStreamSlot layout is shared with Java");
+    static_assert(sizeof(std::atomic<uint32_t>) == 4 && sizeof(std::atomic<uint64_t>) == 8,
+                  "Pose stream atomics must be plain words");
+
+    class PoseStreamTable {
+    public:
+        PoseStreamTable();
+
+        PoseStreamTable(const PoseStreamTable&) = delete;
+        PoseStreamTable& operator=(const PoseStreamTable&) = delete;
+
+        // ==================== 寫入者接口（渲染線程） ====================
+
+        /**
+         * 原地更新一個目標的槽位
+         * @param targetId TargetEventManager 的目標 ID，超出容量時忽略並返回 false
+         * @param poseStatus VuObservationPoseStatus
+         */
+        bool write(int32_t targetId, int32_t poseStatus, const VuMatrix44F& pose,
+                   int64_t timestampNs, uint64_t frameSequence);
+
+        // 一幀的全部槽位寫完後更新頭部；本幀沒有寫入的槽位標記為 NO_POSE
+        // 沒有任何觀察結果的幀也必須提交
+        void commitFrame(uint64_t frameSequence, int64_t updateTimeNs);
+
+        // 把所有槽位標記為未觀察（引擎停止或清理時）
+        void reset();
+
+        // ==================== 讀者接口（任意線程） ====================
+
+        /**
+         * 一致地讀取一個槽位
+         * @return 槽位無效或多次重試仍與寫入衝突時返回 false
+         */
+        bool read(int32_t targetId, int32_t& poseStatus, VuMatrix44F& pose,
+                  int64_t& timestampNs, uint64_t& frameSequence) const;
+
+        // 共享內存塊（進程生命週期內地址不變）
+        uint8_t* data() { return mStorage; }
+        size_t size() const { return sizeof(mStorage); }
+
+        uint32_t getTargetCount() const;
+
+    private:
+        PoseStreamHeader* header() { return reinterpret_cast<PoseStreamHeader*>(mStorage); }
+        const PoseStreamHeader* header() const { return reinterpret_cast<const PoseStreamHeader*>(mStorage); }
+        PoseStreamSlot* slot(size_t index) {
+            return reinterpret_cast<PoseStreamSlot*>(mStorage + sizeof(PoseStreamHeader)) + index;
+        }
+        const PoseStreamSlot* slot(size_t index) const {
+            return reinterpret_cast<const PoseStreamSlot*>(mStorage + sizeof(PoseStreamHeader)) + index;
+        }
+
+        // 把槽位狀態改為 NO_POSE（從未觀察到或已是 NO_POSE 時不寫入）
+        void markNotObserved(size_t index);
+
+        alignas(64) uint8_t mStorage[sizeof(PoseStreamHeader) + POSE_STREAM_MAX_TARGETS * sizeof(PoseStreamSlot)];
+        uint32_t mWrittenMask;   // 本幀寫入過的槽位（寫入者私有，不在共享內存中）
+    };
+
+    // 進程級單例：Java 端可能在引擎銷毀後仍持有 ByteBuffer，因此內存永不釋放
+    PoseStreamTable& getPoseStreamTable();
+}
+
+#endif // POSE_STREAM_TABLE_H
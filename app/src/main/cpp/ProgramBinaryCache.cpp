@@ -0,0 +1,225 @@
+// ==================== ProgramBinaryCache.cpp ====================
+// 著色器程序二進制的磁盤緩存
+
+#include "ProgramBinaryCache.h"
+#include "VuforiaRenderingJNI.h"
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace VuforiaRendering {
+
+    // 文件頭；格式變化時遞增 version
+    struct ProgramBinaryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t deviceHash;
+        uint64_t sourceHash;
+        uint32_t format;
+        uint32_t length;
+    };
+
+    static const uint32_t kBinaryMagic = 0x42505356;    // "VSPB"
+    static const uint32_t kBinaryVersion = 1;
+    // 超過這個大小的文件視為損壞
+    static const uint32_t kMaxBinaryLength = 4 * 1024 * 1024;
+
+    static const uint64_t kFnvOffset = 14695981039346656037ULL;
+    static const uint64_t kFnvPrime = 1099511628211ULL;
+
+    ProgramBinaryCache::ProgramBinaryCache()
+        : mDeviceQueried(false)
+        , mBinarySupported(false)
+        , mDeviceHash(0) {
+    }
+
+    uint64_t ProgramBinaryCache::hashBytes(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= kFnvPrime;
+        }
+        return hash;
+    }
+
+    uint64_t ProgramBinaryCache::hashSources(const char* vertexSource, const char* fragmentSource) {
+        uint64_t hash = kFnvOffset;
+        hash = hashBytes(hash, vertexSource, strlen(vertexSource));
+        // 分隔符避免兩段源碼拼接後相同
+        const char separator = '\0';
+        hash = hashBytes(hash, &separator, 1);
+        hash = hashBytes(hash, fragmentSource, strlen(fragmentSource));
+        return hash;
+    }
+
+    void ProgramBinaryCache::setDirectory(const std::string& directory) {
+        mDirectory = directory;
+        while (!mDirectory.empty() && mDirectory.back() == '/') {
+            mDirectory.pop_back();
+        }
+        LOGI_RENDER("📦 Program binary cache directory: %s",
+                    mDirectory.empty() ? "(disabled)" : mDirectory.c_str());
+    }
+
+    void ProgramBinaryCache::onContextChanged() {
+        mDeviceQueried = false;
+        mBinarySupported = false;
+        mDeviceHash = 0;
+    }
+
+    bool ProgramBinaryCache::queryDevice() {
+        mDeviceQueried = true;
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        mBinarySupported = formatCount > 0;
+
+        const GLenum keys[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        uint64_t hash = kFnvOffset;
+        for (GLenum key : keys) {
+            const char* value = reinterpret_cast<const char*>(glGetString(key));
+            if (value == nullptr) {
+                // 沒有當前上下文
+                mBinarySupported = false;
+                return false;
+            }
+            hash = hashBytes(hash, value, strlen(value) + 1);
+        }
+        mDeviceHash = hash;
+
+        if (!mBinarySupported) {
+            LOGW_RENDER("⚠️ Driver reports no program binary formats, shader cache disabled");
+        }
+        return mBinarySupported;
+    }
+
+    bool ProgramBinaryCache::isAvailable() {
+        if (mDirectory.empty()) {
+            return false;
+        }
+        if (!mDeviceQueried) {
+            queryDevice();
+        }
+        return mBinarySupported;
+    }
+
+    std::string ProgramBinaryCache::pathFor(const char* label, uint64_t sourceHash) const {
+        char name[64];
+        snprintf(name, sizeof(name), "_%016llx.bin",
+                 static_cast<unsigned long long>(hashBytes(mDeviceHash, &sourceHash, sizeof(sourceHash))));
+        return mDirectory + "/" + label + name;
+    }
+
+    GLuint ProgramBinaryCache::load(const char* label, uint64_t sourceHash) {
+        if (!isAvailable()) {
+            return 0;
+        }
+
+        const std::string path = pathFor(label, sourceHash);
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            mStats.misses++;
+            return 0;
+        }
+
+        ProgramBinaryHeader header;
+        std::vector<unsigned char> binary;
+        bool valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                     header.magic == kBinaryMagic &&
+                     header.version == kBinaryVersion &&
+                     header.deviceHash == mDeviceHash &&
+                     header.sourceHash == sourceHash &&
+                     header.length > 0 && header.length <= kMaxBinaryLength;
+        if (valid) {
+            binary.resize(header.length);
+            valid = fread(binary.data(), 1, binary.size(), file) == binary.size();
+        }
+        fclose(file);
+
+        if (!valid) {
+            LOGW_RENDER("⚠️ [%s] Stale or corrupt program binary, recompiling", label);
+            mStats.rejects++;
+            remove(path.c_str());
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, static_cast<GLenum>(header.format), binary.data(),
+                        static_cast<GLsizei>(binary.size()));
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus != GL_TRUE) {
+            // 驅動更新後的常見情況：格式仍然列出但拒絕舊二進制
+            LOGW_RENDER("⚠️ [%s] Driver rejected cached program binary, recompiling", label);
+            glDeleteProgram(program);
+            mStats.rejects++;
+            remove(path.c_str());
+            return 0;
+        }
+
+        mStats.hits++;
+        return program;
+    }
+
+    void ProgramBinaryCache::store(const char* label, uint64_t sourceHash, GLuint program) {
+        if (program == 0 || !isAvailable()) {
+            return;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0 || static_cast<uint32_t>(length) > kMaxBinaryLength) {
+            return;
+        }
+
+        std::vector<unsigned char> binary(static_cast<size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0) {
+            LOGW_RENDER("⚠️ [%s] glGetProgramBinary returned no data", label);
+            return;
+        }
+
+        ProgramBinaryHeader header;
+        header.magic = kBinaryMagic;
+        header.version = kBinaryVersion;
+        header.deviceHash = mDeviceHash;
+        header.sourceHash = sourceHash;
+        header.format = static_cast<uint32_t>(format);
+        header.length = static_cast<uint32_t>(written);
+
+        const std::string path = pathFor(label, sourceHash);
+        const std::string temporaryPath = path + ".tmp";
+        FILE* file = fopen(temporaryPath.c_str(), "wb");
+        if (file == nullptr) {
+            LOGW_RENDER("⚠️ [%s] Cannot write program binary to %s", label, temporaryPath.c_str());
+            return;
+        }
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(binary.data(), 1, static_cast<size_t>(written), file) == static_cast<size_t>(written);
+        ok = fclose(file) == 0 && ok;
+        if (!ok || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            LOGW_RENDER("⚠️ [%s] Failed to save program binary", label);
+            remove(temporaryPath.c_str());
+            return;
+        }
+
+        mStats.stores++;
+        LOGI_RENDER("💾 [%s] Program binary cached (%d bytes, format 0x%04x)", label, written, format);
+    }
+
+    std::string ProgramBinaryCache::getStatus() const {
+        std::ostringstream status;
+        if (mDirectory.empty()) {
+            status << "disabled";
+        } else if (mDeviceQueried && !mBinarySupported) {
+            status << "unsupported by driver";
+        } else {
+            status << mStats.hits << " hits, " << mStats.misses << " misses, "
+                   << mStats.rejects << " rejected, " << mStats.stores << " stored";
+        }
+        return status.str();
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef PROGRAM_BINARY_CACHE_H
+#define PROGRAM_BINARY_CACHE_H
+
+// ==================== 著色器程序二進制緩存 ====================
+// 鏈接成功的程序用 glGetProgramBinary 保存到應用緩存目錄，下次啟動（或上下文丟失後重建）
+// 用 glProgramBinary 直接載入，跳過 GLSL 編譯和鏈接。
+//
+// 緩存鍵 = GL_VENDOR + GL_RENDERER + GL_VERSION（Android 上包含驅動版本）+ 著色器源碼哈希：
+//  - 文件名由緩存鍵哈希得到，源碼或驅動變化後自然落到新文件
+//  - 文件頭再次記錄設備哈希與源碼哈希，不一致時視為失效
+//  - 驅動拒絕二進制（鏈接狀態為失敗）時刪除文件，由調用者回退到編譯
+// 寫入先寫臨時文件再 rename，進程中途被殺不會留下半個文件。
+// 只在 GL 線程使用，不加鎖。
+
+#include <GLES3/gl3.h>
+#include <cstdint>
+#include <string>
+
+namespace VuforiaRendering {
+
+    struct ProgramBinaryCacheStats {
+        uint64_t hits;      // 從緩存載入成功
+        uint64_t misses;    // 沒有對應文件
+        uint64_t rejects;   // 文件損壞、鍵不符或驅動拒絕
+        uint64_t stores;    // 寫入的程序數
+
+        ProgramBinaryCacheStats() : hits(0), misses(0), rejects(0), stores(0) {}
+    };
+
+    class ProgramBinaryCache {
+    public:
+        ProgramBinaryCache();
+
+        ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+        ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+
+        // 緩存目錄（必須已存在）；空字符串表示停用
+        void setDirectory(const std::string& directory);
+
+        // 新上下文：設備信息與二進制格式支持需要重新查詢
+        void onContextChanged();
+
+        /**
+         * 目錄已設置且驅動至少支持一種二進制格式
+         * 第一次調用時查詢當前上下文，需要在 GL 線程且上下文為當前
+         */
+        bool isAvailable();
+
+        /**
+         * 按源碼哈希載入程序
+         * @return 鏈接成功的程序；沒有可用緩存時返回 0，調用者應回退到編譯
+         */
+        GLuint load(const char* label, uint64_t sourceHash);
+
+        /**
+         * 保存已鏈接的程序（鏈接前應設置 GL_PROGRAM_BINARY_RETRIEVABLE_HINT）
+         */
+        void store(const char* label, uint64_t sourceHash, GLuint program);
+
+        // 頂點與片段著色器源碼的哈希
+        static uint64_t hashSources(const char* vertexSource, const char* fragmentSource);
+
+        const ProgramBinaryCacheStats& getStats() const { return mStats; }
+        std::string getStatus() const;
+
+    private:
+        static uint64_t hashBytes(uint64_t hash, const void* data, size_t size);
+
+        bool queryDevice();
+        std::string pathFor(const char* label, uint64_t sourceHash) const;
+
+        std::string mDirectory;
+        bool mDeviceQueried;
+        bool mBinarySupported;
+        uint64_t mDeviceHash;
+        ProgramBinaryCacheStats mStats;
+    };
+}
+
+#endif // PROGRAM_BINARY_CACHE_H
@@ -0,0 +1,156 @@
+// ==================== RegionOfInterest.cpp ====================
+// 目標包圍盒投影與相機幀子視圖
+
+#include "RegionOfInterest.h"
+#include "ImageConversion.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VuforiaWrapper {
+
+    // 比這更近的點視為在相機後方（米）
+    static const float kMinDepth = 0.01f;
+
+    // 列主序 4x4 矩陣乘點
+    static inline void transformPoint(const VuMatrix44F& m, const float in[3], float out[3]) {
+        for (int row = 0; row < 3; ++row) {
+            out[row] = m.data[row] * in[0] + m.data[4 + row] * in[1] +
+                       m.data[8 + row] * in[2] + m.data[12 + row];
+        }
+    }
+
+    static inline void multiplyMatrix(const VuMatrix44F& a, const VuMatrix44F& b, VuMatrix44F& out) {
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 4; ++row) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    sum += a.data[k * 4 + row] * b.data[col * 4 + k];
+                }
+                out.data[col * 4 + row] = sum;
+            }
+        }
+    }
+
+    bool projectTargetCrop(const CameraFrameData& frame, const VuMatrix44F& targetPose,
+                           const VuAABB& bbox, float padding, CropRect& rect) {
+        if (!frame.hasIntrinsics || frame.width <= 0 || frame.height <= 0 ||
+            frame.intrinsics.size.data[0] <= 0.0f || frame.intrinsics.size.data[1] <= 0.0f) {
+            return false;
+        }
+
+        // 目標座標 → 相機座標（X 右、Y 下、Z 前）
+        VuMatrix44F modelView;
+        multiplyMatrix(frame.viewMatrix, targetPose, modelView);
+
+        // 內參可能以不同解析度標定，縮放到當前圖像
+        const float scaleX = frame.width / frame.intrinsics.size.data[0];
+        const float scaleY = frame.height / frame.intrinsics.size.data[1];
+        const float fx = frame.intrinsics.focalLength.data[0] * scaleX;
+        const float fy = frame.intrinsics.focalLength.data[1] * scaleY;
+        const float cx = frame.intrinsics.principalPoint.data[0] * scaleX;
+        const float cy = frame.intrinsics.principalPoint.data[1] * scaleY;
+
+        float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+        int behindCount = 0;
+        for (int corner = 0; corner < 8; ++corner) {
+            const float local[3] = {
+                bbox.center.data[0] + ((corner & 1) ? bbox.extent.data[0] : -bbox.extent.data[0]),
+                bbox.center.data[1] + ((corner & 2) ? bbox.extent.data[1] : -bbox.extent.data[1]),
+                bbox.center.data[2] + ((corner & 4) ? bbox.extent.data[2] : -bbox.extent.data[2])
+            };
+            float view[3];
+            transformPoint(modelView, local, view);
+            if (view[2] < kMinDepth) {
+                ++behindCount;
+                continue;
+            }
+            const float u = fx * view[0] / view[2] + cx;
+            const float v = fy * view[1] / view[2] + cy;
+            minX = std::min(minX, u);
+            maxX = std::max(maxX, u);
+            minY = std::min(minY, v);
+            maxY = std::max(maxY, v);
+        }
+
+        if (behindCount == 8) {
+            return false;
+        }
+
+        if (behindCount > 0) {
+            // 包圍盒跨過相機平面，投影無界 - 保守地使用整幀
+            minX = 0.0f;
+            minY = 0.0f;
+            maxX = static_cast<float>(frame.width);
+            maxY = static_cast<float>(frame.height);
+        } else {
+            const float padX = (maxX - minX) * padding;
+            const float padY = (maxY - minY) * padding;
+            minX -= padX;
+            maxX += padX;
+            minY -= padY;
+            maxY += padY;
+        }
+
+        // 裁剪到圖像範圍，起點向下、終點向上對齊到偶數
+        const int32_t left = static_cast<int32_t>(std::max(0.0f, std::floor(minX))) & ~1;
+        const int32_t top = static_cast<int32_t>(std::max(0.0f, std::floor(minY))) & ~1;
+        const int32_t right = std::min(frame.width & ~1,
+            (static_cast<int32_t>(std::min(static_cast<float>(frame.width), std::ceil(maxX))) + 1) & ~1);
+        const int32_t bottom = std::min(frame.height & ~1,
+            (static_cast<int32_t>(std::min(static_cast<float>(frame.height), std::ceil(maxY))) + 1) & ~1);
+        if (right <= left || bottom <= top) {
+            return false;
+        }
+
+        rect.x = left;
+        rect.y = top;
+        rect.width = right - left;
+        rect.height = bottom - top;
+        return true;
+    }
+
+    bool makeCameraSubView(const CameraFrameData& frame, const CropRect& rect, CameraSubView& view) {
+        if (!frame.hasImage() || rect.isEmpty() || rect.x < 0 || rect.y < 0 ||
+            rect.x + rect.width > frame.width || rect.y + rect.height > frame.height) {
+            return false;
+        }
+
+        int32_t bytesPerPixel = 0;
+        switch (frame.format) {
+            case VU_IMAGE_PIXEL_FORMAT_NV12:
+            case VU_IMAGE_PIXEL_FORMAT_NV21:
+            case VU_IMAGE_PIXEL_FORMAT_GRAYSCALE:
+                bytesPerPixel = 1;
+                break;
+            case VU_IMAGE_PIXEL_FORMAT_RGB888:
+                bytesPerPixel = 3;
+                break;
+            case VU_IMAGE_PIXEL_FORMAT_RGBA8888:
+                bytesPerPixel = 4;
+                break;
+            default:
+                return false;
+        }
+
+        view.format = frame.format;
+        view.rect = rect;
+        view.stride = frame.stride;
+        view.data = frame.buffer + static_cast<size_t>(rect.y) * frame.stride +
+                    static_cast<size_t>(rect.x) * bytesPerPixel;
+        view.chroma = nullptr;
+        view.chromaStride = 0;
+
+        if (frame.format == VU_IMAGE_PIXEL_FORMAT_NV12 || frame.format == VU_IMAGE_PIXEL_FORMAT_NV21) {
+            ImageConversion::YuvPlanes planes;
+            if (!frame.getYuvPlanes(planes)) {
+                return false;
+            }
+            // 色度平面半解析度，每對 UV 覆蓋 2x2 亮度像素；rect 起點已是偶數
+            view.chroma = planes.uv + static_cast<size_t>(rect.y / 2) * planes.uvStride + rect.x;
+            view.chromaStride = planes.uvStride;
+        }
+
+        view.keepAlive = frame.image;
+        return true;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef REGION_OF_INTEREST_H
+#define REGION_OF_INTEREST_H
+
+// ==================== 目標驅動的感興趣區域 ====================
+// 把被追蹤目標的包圍盒（VuImageTargetObservationTargetInfo::bbox）經目標姿態、
+// 視圖矩陣與相機內參投影到相機圖像座標，得到加邊距的裁剪矩形，
+// CPU 端分析只需處理矩形內的像素（帶步長的子視圖，不複製）。
+//
+// 注意：VuRenderState::projectionMatrix 映射到顯示視口（包含屏幕旋轉與
+// 視頻背景裁剪），不是相機圖像，因此像素座標使用同一 VuState 的相機內參計算。
+
+#include "VuforiaWrapper.h"
+#include "TargetBoundsTable.h"
+
+namespace VuforiaWrapper {
+
+    // 相機圖像中的矩形（像素），x / y / width / height 均為偶數，方便 YUV 色度對齊
+    struct CropRect {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+
+        CropRect() : x(0), y(0), width(0), height(0) {}
+        bool isEmpty() const { return width <= 0 || height <= 0; }
+    };
+
+    // 相機幀的子視圖 - 指向原始緩衝區，keepAlive 持有期間有效
+    struct CameraSubView {
+        VuImagePixelFormat format;
+        CropRect rect;              // 在完整圖像中的位置
+        const uint8_t* data;        // 矩形左上角（YUV 格式為亮度平面）
+        int32_t stride;
+        const uint8_t* chroma;      // NV12 / NV21 交錯色度平面的對應位置，其他格式為 nullptr
+        int32_t chromaStride;
+        CameraImageRef keepAlive;
+
+        CameraSubView() : format(VU_IMAGE_PIXEL_FORMAT_UNKNOWN), data(nullptr), stride(0),
+                          chroma(nullptr), chromaStride(0) {}
+    };
+
+    /**
+     * 把目標包圍盒投影到相機圖像並加上邊距
+     * @param frame 提供視圖矩陣、內參與圖像尺寸的相機幀
+     * @param targetPose 目標姿態（VuPoseInfo::pose）
+     * @param bbox 目標座標系下的包圍盒
+     * @param padding 邊距，相對矩形尺寸的比例（0.1 = 每邊擴展 10%）
+     * @param rect 輸出矩形，已裁剪到圖像範圍內
+     * @return 目標完全在相機後方、不在畫面內或缺少內參時返回 false
+     */
+    bool projectTargetCrop(const CameraFrameData& frame, const VuMatrix44F& targetPose,
+                           const VuAABB& bbox, float padding, CropRect& rect);
+
+    /**
+     * 建立相機幀中矩形區域的帶步長子視圖（不複製像素）
+     * @return 不支持的像素格式或矩形超出圖像時返回 false
+     */
+    bool makeCameraSubView(const CameraFrameData& frame, const CropRect& rect, CameraSubView& view);
+}
+
+#endif // REGION_OF_INTEREST_H
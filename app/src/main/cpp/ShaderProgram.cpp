@@ -0,0 +1,278 @@
+// ==================== ShaderProgram.cpp ====================
+// 著色器程序的編譯、鏈接與反射緩存
+
+#include "ShaderProgram.h"
+#include "ProgramBinaryCache.h"
+#include "GLStateTracker.h"
+#include "VuforiaRenderingJNI.h"
+#include <chrono>
+#include <cstring>
+
+namespace VuforiaRendering {
+
+    // ==================== 類型化句柄 ====================
+
+    void FloatUniform::set(float value) const {
+        if (location >= 0) {
+            glUniform1f(location, value);
+        }
+    }
+
+    void Vec4Uniform::set(const float* value) const {
+        if (location >= 0) {
+            glUniform4fv(location, 1, value);
+        }
+    }
+
+    void Mat4Uniform::set(const float* columnMajor) const {
+        if (location >= 0) {
+            glUniformMatrix4fv(location, 1, GL_FALSE, columnMajor);
+        }
+    }
+
+    void SamplerUniform::set(GLint textureUnit) const {
+        if (location >= 0) {
+            glUniform1i(location, textureUnit);
+        }
+    }
+
+    // ==================== 著色器程序 ====================
+
+    ShaderProgram::ShaderProgram()
+        : mProgram(0), mFromCache(false), mBuildTimeMs(0.0f), mStateTracker(nullptr) {
+    }
+
+    ShaderProgram::~ShaderProgram() {
+        // 析構時不保證有當前上下文，程序由 release(false) 顯式刪除
+    }
+
+    GLuint ShaderProgram::compileShader(GLenum stage, const char* source, const char* label) {
+        GLuint shader = glCreateShader(stage);
+        if (shader == 0) {
+            LOGE_RENDER("❌ [%s] glCreateShader failed", label);
+            return 0;
+        }
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint compileStatus = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+        if (compileStatus != GL_TRUE) {
+            GLchar infoLog[SHADER_INFO_LOG_SIZE];
+            glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+            LOGE_RENDER("❌ [%s] %s shader compilation failed: %s", label,
+                        stage == GL_VERTEX_SHADER ? "Vertex" : "Fragment", infoLog);
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    GLuint ShaderProgram::compileAndLink(const char* vertexSource, const char* fragmentSource, bool retrievable) {
+        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, mLabel.c_str());
+        if (vertexShader == 0) {
+            return 0;
+        }
+        GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, mLabel.c_str());
+        if (fragmentShader == 0) {
+            glDeleteShader(vertexShader);
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        if (retrievable) {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glLinkProgram(program);
+
+        // 鏈接後著色器對象不再需要
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus != GL_TRUE) {
+            GLchar infoLog[SHADER_INFO_LOG_SIZE];
+            glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
+            LOGE_RENDER("❌ [%s] Shader program linking failed: %s", mLabel.c_str(), infoLog);
+            glDeleteProgram(program);
+            return 0;
+        }
+        return program;
+    }
+
+    bool ShaderProgram::build(const char* label, const char* vertexSource, const char* fragmentSource,
+                              ProgramBinaryCache* cache) {
+        release(false);
+        mLabel = label != nullptr ? label : "";
+        mFromCache = false;
+        const auto start = std::chrono::steady_clock::now();
+
+        const bool useCache = cache != nullptr && !mLabel.empty() && cache->isAvailable();
+        const uint64_t sourceHash = useCache ? ProgramBinaryCache::hashSources(vertexSource, fragmentSource) : 0;
+
+        GLuint program = useCache ? cache->load(mLabel.c_str(), sourceHash) : 0;
+        if (program != 0) {
+            mFromCache = true;
+        } else {
+            program = compileAndLink(vertexSource, fragmentSource, useCache);
+            if (program == 0) {
+                return false;
+            }
+            if (useCache) {
+                cache->store(mLabel.c_str(), sourceHash, program);
+            }
+        }
+
+        mProgram = program;
+        reflect();
+        mBuildTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        LOGI_RENDER("✅ [%s] Shader program %s in %.2f ms (ID: %u, %zu attributes, %zu uniforms)",
+                    mLabel.c_str(), mFromCache ? "loaded from binary cache" : "compiled",
+                    mBuildTimeMs, mProgram, mAttributes.size(), mUniforms.size());
+        return true;
+    }
+
+    void ShaderProgram::release(bool contextLost) {
+        if (mProgram != 0 && !contextLost) {
+            glDeleteProgram(mProgram);
+            if (mStateTracker != nullptr) {
+                mStateTracker->onProgramDeleted(mProgram);
+            }
+        }
+        mProgram = 0;
+        mAttributes.clear();
+        mUniforms.clear();
+    }
+
+    void ShaderProgram::reflect() {
+        mAttributes.clear();
+        mUniforms.clear();
+
+        GLint maxNameLength = 0;
+        GLint count = 0;
+
+        glGetProgramiv(mProgram, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxNameLength);
+        glGetProgramiv(mProgram, GL_ACTIVE_ATTRIBUTES, &count);
+        std::vector<GLchar> name(static_cast<size_t>(maxNameLength > 0 ? maxNameLength : 1) + 1);
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            Variable variable;
+            glGetActiveAttrib(mProgram, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                              &length, &variable.size, &variable.type, name.data());
+            variable.name.assign(name.data(), static_cast<size_t>(length));
+            variable.location = glGetAttribLocation(mProgram, variable.name.c_str());
+            mAttributes.push_back(variable);
+        }
+
+        glGetProgramiv(mProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+        glGetProgramiv(mProgram, GL_ACTIVE_UNIFORMS, &count);
+        name.resize(static_cast<size_t>(maxNameLength > 0 ? maxNameLength : 1) + 1);
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            Variable variable;
+            glGetActiveUniform(mProgram, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                               &length, &variable.size, &variable.type, name.data());
+            variable.name.assign(name.data(), static_cast<size_t>(length));
+            // 數組 uniform 報告為 "name[0]"，按基本名查詢
+            const size_t bracket = variable.name.find('[');
+            if (bracket != std::string::npos) {
+                variable.name.resize(bracket);
+            }
+            variable.location = glGetUniformLocation(mProgram, variable.name.c_str());
+            // uniform block 成員沒有獨立位置，不緩存
+            if (variable.location >= 0) {
+                mUniforms.push_back(variable);
+            }
+        }
+    }
+
+    const ShaderProgram::Variable* ShaderProgram::findAttribute(const char* name) const {
+        for (const Variable& variable : mAttributes) {
+            if (variable.name == name) {
+                return &variable;
+            }
+        }
+        return nullptr;
+    }
+
+    const ShaderProgram::Variable* ShaderProgram::findUniform(const char* name) const {
+        for (const Variable& variable : mUniforms) {
+            if (variable.name == name) {
+                return &variable;
+            }
+        }
+        return nullptr;
+    }
+
+    bool ShaderProgram::isSamplerType(GLenum type) {
+        switch (type) {
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_EXTERNAL_OES:
+            case GL_INT_SAMPLER_2D:
+            case GL_UNSIGNED_INT_SAMPLER_2D:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    GLint ShaderProgram::uniformLocation(const char* name, GLenum expectedType) const {
+        const Variable* variable = findUniform(name);
+        if (variable == nullptr) {
+            // 未使用的 uniform 會被驅動優化掉，不算錯誤
+            LOGD_RENDER("[%s] Uniform %s is not active", mLabel.c_str(), name);
+            return -1;
+        }
+        const bool matches = expectedType == GL_SAMPLER_2D ? isSamplerType(variable->type)
+                                                           : variable->type == expectedType;
+        if (!matches) {
+            LOGW_RENDER("⚠️ [%s] Uniform %s has type 0x%04x, expected 0x%04x",
+                        mLabel.c_str(), name, variable->type, expectedType);
+            return -1;
+        }
+        return variable->location;
+    }
+
+    AttributeHandle ShaderProgram::attribute(const char* name) const {
+        AttributeHandle handle;
+        const Variable* variable = findAttribute(name);
+        if (variable != nullptr) {
+            handle.location = variable->location;
+        } else {
+            LOGD_RENDER("[%s] Attribute %s is not active", mLabel.c_str(), name);
+        }
+        return handle;
+    }
+
+    FloatUniform ShaderProgram::floatUniform(const char* name) const {
+        FloatUniform handle;
+        handle.location = uniformLocation(name, GL_FLOAT);
+        return handle;
+    }
+
+    Vec4Uniform ShaderProgram::vec4Uniform(const char* name) const {
+        Vec4Uniform handle;
+        handle.location = uniformLocation(name, GL_FLOAT_VEC4);
+        return handle;
+    }
+
+    Mat4Uniform ShaderProgram::mat4Uniform(const char* name) const {
+        Mat4Uniform handle;
+        handle.location = uniformLocation(name, GL_FLOAT_MAT4);
+        return handle;
+    }
+
+    SamplerUniform ShaderProgram::samplerUniform(const char* name) const {
+        SamplerUniform handle;
+        // GL_SAMPLER_2D 在這裡代表「任意採樣器類型」
+        handle.location = uniformLocation(name, GL_SAMPLER_2D);
+        return handle;
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef SHADER_PROGRAM_H
+#define SHADER_PROGRAM_H
+
+// ==================== 著色器程序封裝 ====================
+// 編譯、鏈接後立即反射所有活動屬性和 uniform，把名稱到位置的映射緩存下來。
+// 渲染路徑只持有類型化句柄，每幀不再調用 glGetAttribLocation / glGetUniformLocation。
+//
+// 句柄在初始化時按名稱取得，同時檢查 GLSL 聲明的類型；名稱不存在或類型不符時
+// 返回無效句柄（location == -1），對其 set 與 GL 的語義一致，不產生任何效果。
+// uniform 的 set 作用於當前綁定的程序，調用前需先 glUseProgram。
+//
+// 傳入 ProgramBinaryCache 時先嘗試載入緩存的程序二進制，沒有或失效時才編譯，
+// 編譯成功後寫回緩存。
+
+#include <GLES3/gl3.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VuforiaRendering {
+
+    class ProgramBinaryCache;
+    class GLStateTracker;
+
+    // ==================== 類型化句柄 ====================
+
+    struct AttributeHandle {
+        GLint location;
+        AttributeHandle() : location(-1) {}
+        bool isValid() const { return location >= 0; }
+    };
+
+    struct FloatUniform {
+        GLint location;
+        FloatUniform() : location(-1) {}
+        bool isValid() const { return location >= 0; }
+        void set(float value) const;
+    };
+
+    struct Vec4Uniform {
+        GLint location;
+        Vec4Uniform() : location(-1) {}
+        bool isValid() const { return location >= 0; }
+        void set(const float* value) const;
+    };
+
+    struct Mat4Uniform {
+        GLint location;
+        Mat4Uniform() : location(-1) {}
+        bool isValid() const { return location >= 0; }
+        void set(const float* columnMajor) const;
+    };
+
+    // 任意採樣器類型（sampler2D、samplerExternalOES 等），值為紋理單元
+    struct SamplerUniform {
+        GLint location;
+        SamplerUniform() : location(-1) {}
+        bool isValid() const { return location >= 0; }
+        void set(GLint textureUnit) const;
+    };
+
+    // ==================== 著色器程序 ====================
+
+    class ShaderProgram {
+    public:
+        ShaderProgram();
+        ~ShaderProgram();
+
+        ShaderProgram(const ShaderProgram&) = delete;
+        ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+        /**
+         * 編譯並鏈接程序，成功後反射所有活動變量
+         * 已有程序時先刪除舊程序
+         * @param label 用於日誌和緩存文件名
+         * @param cache 可選的程序二進制緩存
+         */
+        bool build(const char* label, const char* vertexSource, const char* fragmentSource,
+                   ProgramBinaryCache* cache = nullptr);
+
+        // 釋放程序；上下文丟失時句柄已失效，只清零不刪除
+        void release(bool contextLost);
+
+        // 綁定本程序的狀態跟蹤器；release / 重新 build 刪除程序時通知它（不持有所有權）
+        void setStateTracker(GLStateTracker* tracker) { mStateTracker = tracker; }
+
+        GLuint getId() const { return mProgram; }
+        bool isValid() const { return mProgram != 0; }
+        const std::string& getLabel() const { return mLabel; }
+        // 最近一次 build 是否來自二進制緩存，以及耗時
+        bool isFromCache() const { return mFromCache; }
+        float getBuildTimeMs() const { return mBuildTimeMs; }
+
+        // ==================== 句柄查詢（初始化時調用） ====================
+
+        AttributeHandle attribute(const char* name) const;
+        FloatUniform floatUniform(const char* name) const;
+        Vec4Uniform vec4Uniform(const char* name) const;
+        Mat4Uniform mat4Uniform(const char* name) const;
+        SamplerUniform samplerUniform(const char* name) const;
+
+        size_t getAttributeCount() const { return mAttributes.size(); }
+        size_t getUniformCount() const { return mUniforms.size(); }
+
+    private:
+        struct Variable {
+            std::string name;   // 數組去掉 "[0]" 後綴
+            GLint location;
+            GLenum type;
+            GLint size;
+        };
+
+        static GLuint compileShader(GLenum stage, const char* source, const char* label);
+        GLuint compileAndLink(const char* vertexSource, const char* fragmentSource, bool retrievable);
+        void reflect();
+
+        const Variable* findAttribute(const char* name) const;
+        const Variable* findUniform(const char* name) const;
+        GLint uniformLocation(const char* name, GLenum expectedType) const;
+        static bool isSamplerType(GLenum type);
+
+        GLuint mProgram;
+        std::string mLabel;
+        bool mFromCache;
+        float mBuildTimeMs;
+        GLStateTracker* mStateTracker;
+        std::vector<Variable> mAttributes;
+        std::vector<Variable> mUniforms;
+    };
+}
+
+#endif // SHADER_PROGRAM_H
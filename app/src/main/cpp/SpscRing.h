@@ -0,0 +1,182 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+// ==================== 無鎖單生產者 / 單消費者環形緩衝 ====================
+// 固定容量的 POD 記錄環：
+//  - 生產者只寫 mHead，消費者只通過 CAS 推進 mTail，兩側用 acquire / release 同步
+//  - 可用容量可在運行時收窄到 N 以內（setLimit），內存仍按 N 靜態分配
+//  - 環滿時按策略處理：丟棄新記錄（DROP_NEWEST）或覆蓋最舊記錄（DROP_OLDEST），
+//    兩種丟棄分開計數；另記錄歷史最高積壓量（高水位）
+//
+// DROP_OLDEST 時生產者也會推進 mTail。為了不讓兩側同時訪問同一槽位：
+//  - 誰通過 CAS 推進 mTail，誰就獨佔被跨過的位置：消費者先認領、再複製，
+//    生產者認領後直接丟棄
+//  - 每個槽位帶序號，等於它下一個可寫入的位置；認領方用完後以 release 發佈
+//    「位置 + N」，生產者寫入前 acquire 檢查，因此不會覆寫正在被複製的槽位
+//  - 環滿且最舊槽位正被消費者複製時，生產者不等待，按 DROP_NEWEST 計數丟棄
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace VuforiaWrapper {
+
+    enum class RingOverflowPolicy {
+        DROP_NEWEST = 0,   // 環滿時丟棄正在寫入的記錄
+        DROP_OLDEST = 1    // 環滿時覆蓋最舊的未讀記錄
+    };
+
+    template <typename T, size_t N>
+    class SpscRing {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+        static_assert(std::is_trivially_copyable<T>::value, "SpscRing records must be trivially copyable");
+
+    public:
+        SpscRing() : mHead(0), mTail(0), mDroppedNewest(0), mDroppedOldest(0), mHighWater(0),
+                     mPolicy(static_cast<int>(RingOverflowPolicy::DROP_OLDEST)), mLimit(N) {
+            for (size_t i = 0; i < N; ++i) {
+                mSlots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        static constexpr size_t capacity() { return N; }
+
+        void setPolicy(RingOverflowPolicy policy) {
+            mPolicy.store(static_cast<int>(policy), std::memory_order_relaxed);
+        }
+
+        RingOverflowPolicy getPolicy() const {
+            return static_cast<RingOverflowPolicy>(mPolicy.load(std::memory_order_relaxed));
+        }
+
+        // 設置可用容量（1..N）；收窄後超出部分在下一次 push 時按策略處理
+        void setLimit(size_t limit) {
+            const size_t clamped = limit < 1 ? 1 : (limit > N ? N : limit);
+            mLimit.store(clamped, std::memory_order_relaxed);
+        }
+
+        size_t getLimit() const { return mLimit.load(std::memory_order_relaxed); }
+
+        // ==================== 生產者接口（單線程） ====================
+
+        // 寫入一條記錄；記錄被丟棄時返回 false
+        bool push(const T& value) {
+            const uint64_t head = mHead.load(std::memory_order_relaxed);
+            uint64_t tail = mTail.load(std::memory_order_acquire);
+            const uint64_t limit = static_cast<uint64_t>(getLimit());
+            while (head - tail >= limit) {
+                if (getPolicy() == RingOverflowPolicy::DROP_NEWEST) {
+                    mDroppedNewest.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                // 認領並丟棄最舊記錄；CAS 失敗表示消費者剛好認領了它，tail 已更新，重新檢查
+                if (mTail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+                    releaseSlot(tail);
+                    mDroppedOldest.fetch_add(1, std::memory_order_relaxed);
+                    ++tail;
+                }
+            }
+
+            // 目標槽位上一輪的記錄可能仍在被消費者複製
+            Slot& slot = mSlots[head & (N - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != head) {
+                mDroppedNewest.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            memcpy(&slot.value, &value, sizeof(T));
+            mHead.store(head + 1, std::memory_order_release);
+
+            // 高水位只由生產者寫入
+            const uint64_t depth = head + 1 - tail;
+            if (depth > mHighWater.load(std::memory_order_relaxed)) {
+                mHighWater.store(depth, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+        // ==================== 消費者接口（單線程） ====================
+
+        // 取出最多 maxCount 條記錄到 out，返回實際數量
+        size_t popBatch(T* out, size_t maxCount) {
+            if (out == nullptr || maxCount == 0) {
+                return 0;
+            }
+            uint64_t tail = mTail.load(std::memory_order_acquire);
+            size_t count = 0;
+            do {
+                const uint64_t head = mHead.load(std::memory_order_acquire);
+                const size_t available = static_cast<size_t>(head - tail);
+                count = available < maxCount ? available : maxCount;
+                if (count == 0) {
+                    return 0;
+                }
+                // CAS 失敗說明生產者剛丟棄了最舊記錄，tail 已更新為新值
+            } while (!mTail.compare_exchange_weak(tail, tail + count, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire));
+
+            // [tail, tail + count) 已歸消費者獨佔
+            for (size_t i = 0; i < count; ++i) {
+                memcpy(&out[i], &mSlots[(tail + i) & (N - 1)].value, sizeof(T));
+                releaseSlot(tail + i);
+            }
+            return count;
+        }
+
+        // 丟棄所有未讀記錄（消費者側）
+        void clear() {
+            uint64_t tail = mTail.load(std::memory_order_acquire);
+            uint64_t head = mHead.load(std::memory_order_acquire);
+            while (!mTail.compare_exchange_weak(tail, head, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+                head = mHead.load(std::memory_order_acquire);
+            }
+            for (uint64_t position = tail; position < head; ++position) {
+                releaseSlot(position);
+            }
+        }
+
+        // ==================== 統計（任意線程） ====================
+
+        size_t size() const {
+            const uint64_t tail = mTail.load(std::memory_order_acquire);
+            const uint64_t head = mHead.load(std::memory_order_acquire);
+            return static_cast<size_t>(head - tail);
+        }
+
+        uint64_t getDroppedNewestCount() const { return mDroppedNewest.load(std::memory_order_relaxed); }
+        uint64_t getDroppedOldestCount() const { return mDroppedOldest.load(std::memory_order_relaxed); }
+        uint64_t getOverflowCount() const { return getDroppedNewestCount() + getDroppedOldestCount(); }
+
+        // 歷史最高積壓量（記錄數）
+        size_t getHighWaterMark() const { return static_cast<size_t>(mHighWater.load(std::memory_order_relaxed)); }
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> sequence;  // 該槽位下一個可寫入的位置
+            T value;
+        };
+
+        // 認領方用完位置 position 後交還給生產者的下一輪
+        void releaseSlot(uint64_t position) {
+            mSlots[position & (N - 1)].sequence.store(position + N, std::memory_order_release);
+        }
+
+        // 生產者與消費者的索引放在不同緩存行，避免偽共享
+        alignas(64) std::atomic<uint64_t> mHead;
+        alignas(64) std::atomic<uint64_t> mTail;
+        alignas(64) std::atomic<uint64_t> mDroppedNewest;
+        std::atomic<uint64_t> mDroppedOldest;
+        std::atomic<uint64_t> mHighWater;
+        std::atomic<int> mPolicy;
+        std::atomic<size_t> mLimit;
+        Slot mSlots[N];
+    };
+}
+
+#endif // SPSC_RING_H
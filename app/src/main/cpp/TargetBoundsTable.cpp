@@ -0,0 +1,54 @@
+// ==================== TargetBoundsTable.cpp ====================
+// 被追蹤目標的姿態與包圍盒表
+
+#include "TargetBoundsTable.h"
+
+namespace VuforiaWrapper {
+
+    void TargetBoundsTable::update(int32_t targetId, const VuMatrix44F& pose, const VuAABB& bbox,
+                                   uint64_t frameSequence, bool tracked) {
+        if (targetId < 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        const size_t index = static_cast<size_t>(targetId);
+        if (index >= mEntries.size()) {
+            if (!tracked) {
+                return;
+            }
+            // 只在目標首次被追蹤時增長
+            mEntries.resize(index + 1, Entry{});
+        }
+
+        Entry& entry = mEntries[index];
+        copyMatrix(entry.pose, pose);
+        entry.bbox = bbox;
+        entry.frameSequence = frameSequence;
+        entry.tracked = tracked;
+        entry.observed = true;
+    }
+
+    void TargetBoundsTable::commitFrame() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (Entry& entry : mEntries) {
+            entry.tracked = entry.tracked && entry.observed;
+            entry.observed = false;
+        }
+    }
+
+    bool TargetBoundsTable::find(int32_t targetId, Entry& entry) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (targetId < 0 || static_cast<size_t>(targetId) >= mEntries.size() ||
+            !mEntries[targetId].tracked) {
+            return false;
+        }
+        entry = mEntries[targetId];
+        return true;
+    }
+
+    void TargetBoundsTable::clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries.clear();
+    }
+}
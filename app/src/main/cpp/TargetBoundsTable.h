@@ -0,0 +1,47 @@
+#ifndef TARGET_BOUNDS_TABLE_H
+#define TARGET_BOUNDS_TABLE_H
+
+// ==================== 目標包圍盒表 ====================
+// 渲染線程每幀記錄被追蹤目標的姿態與包圍盒，ROI 裁剪按需查詢後再投影（見 RegionOfInterest.h）。
+// 不依賴 JNI，可以在主機端測試。
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "TrackingTypes.h"
+
+namespace VuforiaWrapper {
+
+    // 被追蹤目標的最新姿態與包圍盒，以 TargetEventManager 的目標 ID 索引
+    // 由渲染線程更新，任意線程查詢
+    class TargetBoundsTable {
+    public:
+        struct Entry {
+            VuMatrix44F pose;
+            VuAABB bbox;
+            uint64_t frameSequence;  // 觀察結果所屬的相機幀序號
+            bool tracked;
+            bool observed;           // 本幀 update 過，commitFrame 時清除
+        };
+
+        /**
+         * 更新目標；tracked 為 false 時只標記失效（保留條目避免重複分配）
+         */
+        void update(int32_t targetId, const VuMatrix44F& pose, const VuAABB& bbox,
+                    uint64_t frameSequence, bool tracked);
+
+        // 一幀的觀察結果寫完後調用：本幀沒有 update 的目標已不在觀察列表中，標記失效
+        void commitFrame();
+
+        // 查詢正在追蹤的目標
+        bool find(int32_t targetId, Entry& entry) const;
+
+        void clear();
+
+    private:
+        mutable std::mutex mMutex;
+        std::vector<Entry> mEntries;
+    };
+}
+
+#endif // TARGET_BOUNDS_TABLE_H
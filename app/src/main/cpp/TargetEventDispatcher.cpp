@@ -0,0 +1,260 @@
+// ==================== TargetEventDispatcher.cpp ====================
+// 目標事件的專用分發線程
+
+#include "TargetEventDispatcher.h"
+#include "TargetEventManager.h"
+#include "WrapperLog.h"
+#include "JniRegistry.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+namespace VuforiaWrapper {
+
+    TargetEventDispatcher::TargetEventDispatcher(TargetEventManager* eventManager)
+        : mEventManager(eventManager)
+        , mJavaVM(nullptr)
+        , mEnv(nullptr)
+        , mWorker("Target event dispatcher", IDLE_WAIT_MS, WorkerThread::Callbacks{
+              [this]() { return attachThread(); },
+              [this]() { dispatchPending(); },
+              [this]() { detachThread(); }})
+        , mCallback(nullptr) {
+    }
+
+    TargetEventDispatcher::~TargetEventDispatcher() {
+        stop();
+    }
+
+    bool TargetEventDispatcher::start(JavaVM* vm) {
+        if (vm == nullptr || mEventManager == nullptr) {
+            return false;
+        }
+        // 進程內只有一個 JavaVM，線程已在運行時重複設置也不會改變它
+        mJavaVM.store(vm, std::memory_order_release);
+        return mWorker.start();
+    }
+
+    void TargetEventDispatcher::stop() {
+        mWorker.stop();
+    }
+
+    void TargetEventDispatcher::setCallback(jobject callback) {
+        std::lock_guard<std::mutex> lock(mCallbackMutex);
+        mCallback = callback;
+    }
+
+    void TargetEventDispatcher::notify() {
+        mWorker.notify();
+    }
+
+    bool TargetEventDispatcher::attachThread() {
+        JavaVM* vm = mJavaVM.load(std::memory_order_acquire);
+        JNIEnv* env = nullptr;
+        JavaVMAttachArgs args;
+        args.version = JNI_VERSION_1_6;
+        args.name = const_cast<char*>("TargetEvents");
+        args.group = nullptr;
+        if (vm->AttachCurrentThread(&env, &args) != JNI_OK || env == nullptr) {
+            LOGE("❌ Target event dispatcher failed to attach to JVM");
+            return false;
+        }
+        mEnv = env;
+        return true;
+    }
+
+    void TargetEventDispatcher::dispatchPending() {
+        std::lock_guard<std::mutex> lock(mCallbackMutex);
+        if (mCallback == nullptr) {
+            return;
+        }
+        const int64_t oldestNs = dispatchBatch(mEnv, mCallback);
+        if (oldestNs > 0) {
+            const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            recordLag(static_cast<float>(nowNs - oldestNs) / 1e6f);
+        }
+    }
+
+    void TargetEventDispatcher::detachThread() {
+        // 批次數組的全局引用在本線程的 JNIEnv 上釋放
+        releaseJavaBuffers(mEnv);
+        mEnv = nullptr;
+        mJavaVM.load(std::memory_order_acquire)->DetachCurrentThread();
+    }
+
+    int64_t TargetEventDispatcher::dispatchBatch(JNIEnv* env, jobject callback) {
+        if (env == nullptr || callback == nullptr) {
+            return 0;
+        }
+
+        // 方法 ID 在 JNI_OnLoad 時緩存，事件分發不再查找類和方法
+        const JniRegistry& jni = getJniRegistry();
+        if (!jni.valid || jni.onTargetEventBatch == nullptr) {
+            return 0;
+        }
+
+        // 名稱表先於引用這些 ID 的事件到達 Java
+        sendPendingNames(env, callback);
+
+        int64_t oldestNs = 0;
+        const TargetEvent* batch = mEventManager->getBatch();
+        const size_t count = mEventManager->takeBatch(oldestNs);
+
+        if (count == 0 || !ensureJavaBuffers(env, count)) {
+            return oldestNs;
+        }
+
+        // 打包成 SoA 數組，每個數組一次 Set*ArrayRegion
+        for (size_t i = 0; i < count; ++i) {
+            const TargetEvent& event = batch[i];
+            mPackedIds[i] = event.targetId;
+            mPackedTypes[i] = static_cast<jint>(event.eventType);
+            // steady_clock 即 CLOCK_MONOTONIC，與 Java System.nanoTime() 同一時基
+            mPackedTimestamps[i] = static_cast<jlong>(event.timestampNs);
+            memcpy(&mPackedPoses[i * 16], event.poseMatrix.data, sizeof(event.poseMatrix.data));
+        }
+
+        const jsize jCount = static_cast<jsize>(count);
+        env->SetIntArrayRegion(mJavaBuffers.targetIds, 0, jCount, mPackedIds.data());
+        env->SetIntArrayRegion(mJavaBuffers.eventTypes, 0, jCount, mPackedTypes.data());
+        env->SetLongArrayRegion(mJavaBuffers.timestamps, 0, jCount, mPackedTimestamps.data());
+        env->SetFloatArrayRegion(mJavaBuffers.poses, 0, jCount * 16, mPackedPoses.data());
+
+        env->CallVoidMethod(callback, jni.onTargetEventBatch, jCount,
+                            mJavaBuffers.targetIds, mJavaBuffers.eventTypes,
+                            mJavaBuffers.timestamps, mJavaBuffers.poses);
+
+        // Java 回調拋出的異常不能帶入下一次 JNI 調用
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+        return oldestNs;
+    }
+
+    void TargetEventDispatcher::sendPendingNames(JNIEnv* env, jobject callback) {
+        const JniRegistry& jni = getJniRegistry();
+        if (jni.onTargetNamesRegistered == nullptr || jni.stringClass == nullptr) {
+            return;
+        }
+
+        // 只在有新目標登記時執行，這裡的分配不在每幀路徑上
+        size_t first = 0;
+        std::vector<std::string>& names = mPendingNames;
+        if (!mEventManager->takePendingNames(first, names)) {
+            return;
+        }
+
+        const jsize pending = static_cast<jsize>(names.size());
+        jintArray jIds = env->NewIntArray(pending);
+        jobjectArray jNames = env->NewObjectArray(pending, jni.stringClass, nullptr);
+        if (jIds == nullptr || jNames == nullptr) {
+            env->ExceptionClear();
+            if (jIds != nullptr) env->DeleteLocalRef(jIds);
+            if (jNames != nullptr) env->DeleteLocalRef(jNames);
+            return;
+        }
+        for (jsize i = 0; i < pending; ++i) {
+            const jint id = static_cast<jint>(first + static_cast<size_t>(i));
+            env->SetIntArrayRegion(jIds, i, 1, &id);
+            jstring jName = env->NewStringUTF(names[static_cast<size_t>(i)].c_str());
+            env->SetObjectArrayElement(jNames, i, jName);
+            env->DeleteLocalRef(jName);
+        }
+
+        env->CallVoidMethod(callback, jni.onTargetNamesRegistered, jIds, jNames);
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        } else {
+            mEventManager->markNamesSent(first + names.size());
+        }
+        env->DeleteLocalRef(jIds);
+        env->DeleteLocalRef(jNames);
+    }
+
+    bool TargetEventDispatcher::ensureJavaBuffers(JNIEnv* env, size_t count) {
+        if (count > mPackedIds.size()) {
+            mPackedIds.resize(count);
+            mPackedTypes.resize(count);
+            mPackedTimestamps.resize(count);
+            mPackedPoses.resize(count * 16);
+        }
+        if (count <= mJavaBuffers.capacity) {
+            return true;
+        }
+
+        // 容量翻倍增長，穩態下不再重新分配 Java 數組
+        size_t capacity = mJavaBuffers.capacity > 0 ? mJavaBuffers.capacity : 8;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        releaseJavaBuffers(env);
+
+        const jsize jCapacity = static_cast<jsize>(capacity);
+        jintArray ids = env->NewIntArray(jCapacity);
+        jintArray types = env->NewIntArray(jCapacity);
+        jlongArray timestamps = env->NewLongArray(jCapacity);
+        jfloatArray poses = env->NewFloatArray(jCapacity * 16);
+        const bool allocated = ids != nullptr && types != nullptr && timestamps != nullptr && poses != nullptr;
+        if (allocated) {
+            mJavaBuffers.targetIds = static_cast<jintArray>(env->NewGlobalRef(ids));
+            mJavaBuffers.eventTypes = static_cast<jintArray>(env->NewGlobalRef(types));
+            mJavaBuffers.timestamps = static_cast<jlongArray>(env->NewGlobalRef(timestamps));
+            mJavaBuffers.poses = static_cast<jfloatArray>(env->NewGlobalRef(poses));
+            mJavaBuffers.capacity = capacity;
+        } else {
+            env->ExceptionClear();
+            LOGE("❌ Failed to allocate target event batch arrays (%zu)", capacity);
+        }
+        if (ids != nullptr) env->DeleteLocalRef(ids);
+        if (types != nullptr) env->DeleteLocalRef(types);
+        if (timestamps != nullptr) env->DeleteLocalRef(timestamps);
+        if (poses != nullptr) env->DeleteLocalRef(poses);
+        return allocated;
+    }
+
+    void TargetEventDispatcher::releaseJavaBuffers(JNIEnv* env) {
+        if (env != nullptr) {
+            jobject refs[] = {mJavaBuffers.targetIds, mJavaBuffers.eventTypes,
+                              mJavaBuffers.timestamps, mJavaBuffers.poses};
+            for (jobject ref : refs) {
+                if (ref != nullptr) {
+                    env->DeleteGlobalRef(ref);
+                }
+            }
+        }
+        mJavaBuffers = JavaBatchBuffers();
+    }
+
+    void TargetEventDispatcher::recordLag(float lagMs) {
+        std::lock_guard<std::mutex> lock(mStatsMutex);
+        mLagStats.batches++;
+        if (lagMs > LATE_THRESHOLD_MS) {
+            mLagStats.lateBatches++;
+            LOGW("⚠️ Target event dispatch lagging: %.1f ms", lagMs);
+        }
+        mLagStats.lastMs = lagMs;
+        mLagStats.averageMs = mLagStats.batches == 1 ? lagMs : mLagStats.averageMs * 0.9f + lagMs * 0.1f;
+        if (lagMs > mLagStats.maxMs) {
+            mLagStats.maxMs = lagMs;
+        }
+    }
+
+    DispatchLagStats TargetEventDispatcher::getLagStats() const {
+        std::lock_guard<std::mutex> lock(mStatsMutex);
+        return mLagStats;
+    }
+
+    std::string TargetEventDispatcher::getStatus() const {
+        const DispatchLagStats stats = getLagStats();
+        std::ostringstream status;
+        status << (isRunning() ? "running" : "stopped")
+               << ", lag " << std::fixed << std::setprecision(1) << stats.lastMs
+               << " ms (avg " << stats.averageMs << ", max " << stats.maxMs << ")"
+               << ", late " << stats.lateBatches << "/" << stats.batches;
+        return status.str();
+    }
+}
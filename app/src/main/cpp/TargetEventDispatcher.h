@@ -0,0 +1,124 @@
+#ifndef TARGET_EVENT_DISPATCHER_H
+#define TARGET_EVENT_DISPATCHER_H
+
+// ==================== 目標事件分發線程 ====================
+// 渲染線程只把事件寫入 TargetEventManager 的事件環並調用 notify()（不加鎖、不阻塞），
+// 專用線程一次性附加到 JVM，被喚醒後取出事件、打包成 SoA 數組並調用 Java 回調。
+// Java 監聽器再慢也只會讓事件在環中積壓（由溢出策略處理），不會拖慢渲染。
+//
+// 分發延遲 = 批次中最早事件入隊到回調返回的時間，用來觀察監聽器是否跟不上。
+
+#include <jni.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "WorkerThread.h"
+
+namespace VuforiaWrapper {
+
+    class TargetEventManager;
+
+    // 分發延遲統計（毫秒）
+    struct DispatchLagStats {
+        uint64_t batches;       // 已分發的批次數
+        uint64_t lateBatches;   // 延遲超過 LATE_THRESHOLD_MS 的批次數
+        float lastMs;
+        float averageMs;        // 指數移動平均
+        float maxMs;
+
+        DispatchLagStats() : batches(0), lateBatches(0), lastMs(0.0f), averageMs(0.0f), maxMs(0.0f) {}
+    };
+
+    class TargetEventDispatcher {
+    public:
+        // 超過兩個 60Hz 刷新週期視為監聽器跟不上
+        static constexpr float LATE_THRESHOLD_MS = 33.0f;
+        // 錯過喚醒時的兜底輪詢間隔
+        static constexpr int IDLE_WAIT_MS = 50;
+
+        explicit TargetEventDispatcher(TargetEventManager* eventManager);
+        ~TargetEventDispatcher();
+
+        TargetEventDispatcher(const TargetEventDispatcher&) = delete;
+        TargetEventDispatcher& operator=(const TargetEventDispatcher&) = delete;
+
+        /**
+         * 啟動分發線程（已啟動時直接返回 true）
+         * @param vm 線程啟動時附加、退出時分離
+         */
+        bool start(JavaVM* vm);
+
+        // 停止並等待線程退出；線程退出前在自己的 JNIEnv 上釋放批次數組
+        void stop();
+
+        bool isRunning() const { return mWorker.isRunning(); }
+
+        /**
+         * 設置回調對象（全局引用，所有權仍屬調用者）
+         * 會等待正在進行的分發完成，返回後舊引用可以安全刪除
+         */
+        void setCallback(jobject callback);
+
+        // 有新事件（渲染線程調用，不加鎖、不阻塞）
+        void notify();
+
+        DispatchLagStats getLagStats() const;
+        std::string getStatus() const;
+
+    private:
+        // Java 端批次數組（全局引用），按容量重用，只在回調期間有效
+        struct JavaBatchBuffers {
+            jintArray targetIds = nullptr;
+            jintArray eventTypes = nullptr;
+            jlongArray timestamps = nullptr;
+            jfloatArray poses = nullptr;    // 每個事件 16 個 float（列主序）
+            size_t capacity = 0;
+        };
+
+        // 工作線程回調：附加到 JVM / 分發一批 / 釋放批次數組並分離
+        bool attachThread();
+        void dispatchPending();
+        void detachThread();
+        void recordLag(float lagMs);
+
+        /**
+         * 取出一批事件並打包成一次 Java 批次回調
+         * 有新登記的目標時先調用 onTargetNamesRegistered
+         * @return 本批最早事件的入隊時間（納秒），沒有事件時返回 0
+         */
+        int64_t dispatchBatch(JNIEnv* env, jobject callback);
+
+        // 發送尚未同步的名稱表
+        void sendPendingNames(JNIEnv* env, jobject callback);
+
+        // 確保 Java 批次數組容量足夠
+        bool ensureJavaBuffers(JNIEnv* env, size_t count);
+
+        // 釋放 Java 批次數組的全局引用（線程退出前在自己的 JNIEnv 上調用）
+        void releaseJavaBuffers(JNIEnv* env);
+
+        TargetEventManager* mEventManager;
+        std::atomic<JavaVM*> mJavaVM;
+        JNIEnv* mEnv;   // 只由工作線程訪問，附加期間有效
+        WorkerThread mWorker;
+
+        // 回調對象；分發期間持有，保證 setCallback 返回後不再使用舊引用
+        std::mutex mCallbackMutex;
+        jobject mCallback;
+
+        mutable std::mutex mStatsMutex;
+        DispatchLagStats mLagStats;
+
+        // 打包用的本地暫存（只由分發線程訪問）
+        std::vector<jint> mPackedIds;
+        std::vector<jint> mPackedTypes;
+        std::vector<jlong> mPackedTimestamps;
+        std::vector<jfloat> mPackedPoses;
+        std::vector<std::string> mPendingNames;
+        JavaBatchBuffers mJavaBuffers;
+    };
+}
+
+#endif // TARGET_EVENT_DISPATCHER_H
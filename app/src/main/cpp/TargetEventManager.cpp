@@ -0,0 +1,334 @@
+// ==================== TargetEventManager.cpp ====================
+// 目標事件的登記、遲滯、入隊與批次合併
+
+#include "TargetEventManager.h"
+#include "WrapperLog.h"
+#include <algorithm>
+#include <chrono>
+
+namespace VuforiaWrapper {
+    
+    int32_t TargetEventManager::registerTarget(const char* targetName, int32_t observerId) {
+        if (targetName == nullptr) {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        return findOrRegisterLocked(targetName, observerId);
+    }
+    
+    void TargetEventManager::clearObserverIds() {
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        mObserverToTarget.clear();
+    }
+    
+    int32_t TargetEventManager::findTarget(const char* targetName) const {
+        if (targetName == nullptr) {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        for (size_t i = 0; i < mTargetNames.size(); ++i) {
+            if (mTargetNames[i] == targetName) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+    
+    int32_t TargetEventManager::findOrRegisterLocked(const char* targetName, int32_t observerId) {
+        int32_t targetId = -1;
+        for (size_t i = 0; i < mTargetNames.size(); ++i) {
+            if (mTargetNames[i] == targetName) {
+                targetId = static_cast<int32_t>(i);
+                break;
+            }
+        }
+        if (targetId < 0) {
+            // 名稱只在這裡駐留一次，之後事件路徑只使用整數 ID
+            targetId = static_cast<int32_t>(mTargetNames.size());
+            mTargetNames.emplace_back(targetName);
+            mTargetStates.push_back(TargetState{TargetEventType::TARGET_LOST, TargetEventType::TARGET_LOST, 0, 0});
+            LOGD("Target registered: %s -> %d (observer %d)", targetName, targetId, observerId);
+        }
+        
+        if (observerId >= 0) {
+            if (static_cast<size_t>(observerId) >= mObserverToTarget.size()) {
+                mObserverToTarget.resize(static_cast<size_t>(observerId) + 1, -1);
+            }
+            mObserverToTarget[observerId] = targetId;
+        }
+        return targetId;
+    }
+    
+    int32_t TargetEventManager::resolveObserverLocked(int32_t observerId, const char* targetName) {
+        // 快速路徑：observer ID 直接索引平坦數組，不比較字符串
+        if (observerId >= 0 && static_cast<size_t>(observerId) < mObserverToTarget.size()) {
+            const int32_t targetId = mObserverToTarget[observerId];
+            if (targetId >= 0) {
+                return targetId;
+            }
+        }
+        // 不是經 createImageTargetObserver 登記的 observer，首次出現時按名稱駐留
+        if (targetName == nullptr) {
+            return -1;
+        }
+        return findOrRegisterLocked(targetName, observerId);
+    }
+    
+    void TargetEventManager::resendTargetNames() {
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        mNamesSent = 0;
+    }
+    
+    void TargetEventManager::addEvent(const char* targetName, TargetEventType eventType, 
+                                    const VuMatrix44F& poseMatrix, float confidence) {
+        if (targetName == nullptr) {
+            return;
+        }
+        
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int32_t targetId = -1;
+        {
+            std::lock_guard<std::mutex> lock(mTargetsMutex);
+            
+            // 檢查是否需要觸發事件（避免重複）
+            targetId = findOrRegisterLocked(targetName, -1);
+            if (!shouldTriggerEvent(targetId, eventType, nowNs)) {
+                return;
+            }
+            pushEventLocked(targetId, eventType, poseMatrix, confidence);
+        }
+    }
+    
+    void TargetEventManager::addEvents(TargetObservation* observations, size_t count) {
+        if (observations == nullptr || count == 0) {
+            return;
+        }
+        
+        // 遲滯計時每批只取一次時間
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        
+        for (size_t i = 0; i < count; ++i) {
+            TargetObservation& observation = observations[i];
+            const int32_t targetId = resolveObserverLocked(observation.observerId, observation.targetName);
+            observation.targetId = targetId;
+            if (targetId < 0 || !shouldTriggerEvent(targetId, observation.eventType, nowNs)) {
+                continue;
+            }
+            pushEventLocked(targetId, observation.eventType,
+                            observation.poseMatrix, observation.confidence);
+        }
+    }
+    
+    void TargetEventManager::pushEventLocked(int32_t targetId, TargetEventType eventType,
+                                             const VuMatrix44F& poseMatrix, float confidence) {
+        TargetEvent event;
+        event.targetId = targetId;
+        event.eventType = eventType;
+        copyMatrix(event.poseMatrix, poseMatrix);
+        event.confidence = confidence;
+        event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        
+        // 只保留最新狀態：內存由登記的目標數決定，與分發速度無關
+        if (getQueueMode() == EventQueueMode::LATEST_STATE_ONLY) {
+            const size_t index = static_cast<size_t>(targetId);
+            if (mLatestEvents.size() <= index) {
+                mLatestEvents.resize(mTargetNames.size());
+                mLatestPending.resize(mTargetNames.size(), 0);
+            }
+            mLatestEvents[index] = event;
+            if (mLatestPending[index]) {
+                mSupersededEvents.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                mLatestPending[index] = 1;
+                const size_t pending = mLatestPendingCount.fetch_add(1, std::memory_order_release) + 1;
+                mLatestHighWater = std::max(mLatestHighWater, pending);
+            }
+            return;
+        }
+        
+        // 寫入事件環不需要名稱表的鎖，但這裡順帶持有也不會阻塞分發者
+        // 每幀路徑不記錄正常入隊；持續溢出時只在第一次及每滿一環的丟棄記錄一次
+        if (!mEventRing.push(event)) {
+            const uint64_t dropped = mEventRing.getDroppedNewestCount();
+            if (dropped == 1 || dropped % EVENT_RING_CAPACITY == 0) {
+                LOGW("⚠️ Target event ring full, dropped event for target %d (%llu dropped)",
+                     targetId, static_cast<unsigned long long>(dropped));
+            }
+        }
+    }
+    
+    size_t TargetEventManager::drainLatestStates(size_t offset) {
+        if (mLatestPendingCount.load(std::memory_order_acquire) == 0) {
+            return offset;
+        }
+        
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        for (size_t id = 0; id < mLatestPending.size() && offset < EVENT_RING_CAPACITY; ++id) {
+            if (!mLatestPending[id]) {
+                continue;
+            }
+            mDispatchQueue[offset++] = mLatestEvents[id];
+            mLatestPending[id] = 0;
+            mLatestPendingCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return offset;
+    }
+    
+    void TargetEventManager::setQueuePolicy(EventQueueMode mode, size_t capacity) {
+        mEventRing.setLimit(capacity);
+        if (mode != EventQueueMode::LATEST_STATE_ONLY) {
+            mEventRing.setPolicy(mode == EventQueueMode::DROP_NEWEST ?
+                                 RingOverflowPolicy::DROP_NEWEST : RingOverflowPolicy::DROP_OLDEST);
+        }
+        // 切換模式時已在環或信箱中的事件照常分發
+        mQueueMode.store(static_cast<int>(mode), std::memory_order_relaxed);
+        LOGI("Target event queue: mode %d, capacity %zu", static_cast<int>(mode), mEventRing.getLimit());
+    }
+    
+    size_t TargetEventManager::getHighWaterMark() const {
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        return std::max(mEventRing.getHighWaterMark(), mLatestHighWater);
+    }
+    
+    void TargetEventManager::setHysteresis(uint32_t frames, uint32_t milliseconds) {
+        mHysteresisFrames.store(frames > 0 ? frames : 1, std::memory_order_relaxed);
+        mHysteresisMs.store(milliseconds, std::memory_order_relaxed);
+        LOGI("Target event hysteresis: %u frames / %u ms", frames, milliseconds);
+    }
+    
+    bool TargetEventManager::shouldTriggerEvent(int32_t targetId, TargetEventType eventType, int64_t nowNs) {
+        TargetState& state = mTargetStates[static_cast<size_t>(targetId)];
+        
+        // 回到已發出的狀態：待定的變化被撤回，計入抑制數量
+        if (eventType == state.lastEventType) {
+            if (state.pendingFrames > 0) {
+                mSuppressedFlaps.fetch_add(1, std::memory_order_relaxed);
+                state.pendingFrames = 0;
+            }
+            return false;
+        }
+        
+        if (state.pendingFrames == 0 || state.pendingType != eventType) {
+            if (state.pendingFrames > 0) {
+                mSuppressedFlaps.fetch_add(1, std::memory_order_relaxed);
+            }
+            state.pendingType = eventType;
+            state.pendingFrames = 0;
+            state.pendingSinceNs = nowNs;
+        }
+        ++state.pendingFrames;
+        
+        // 連續 N 幀或持續 T 毫秒，任一滿足即發出
+        const uint32_t minFrames = mHysteresisFrames.load(std::memory_order_relaxed);
+        const int64_t minDurationNs = static_cast<int64_t>(mHysteresisMs.load(std::memory_order_relaxed)) * 1000000;
+        if (state.pendingFrames < minFrames && nowNs - state.pendingSinceNs < minDurationNs) {
+            return false;
+        }
+        
+        state.lastEventType = eventType;
+        state.pendingFrames = 0;
+        return true;
+    }
+    
+    size_t TargetEventManager::coalesceBatch(size_t count) {
+        // 目標 ID 在登記時分配，數組只在新目標出現後增長
+        size_t maxId = 0;
+        for (size_t i = 0; i < count; ++i) {
+            maxId = std::max(maxId, static_cast<size_t>(mDispatchQueue[i].targetId) + 1);
+        }
+        if (mBatchLastIndex.size() < maxId) {
+            mBatchLastIndex.resize(maxId, -1);
+            mDispatchedTypes.resize(maxId, -1);
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            mBatchLastIndex[mDispatchQueue[i].targetId] = static_cast<int32_t>(i);
+        }
+        
+        // 每個目標只保留本批最後一個事件；它與上次分發的狀態相同時整組抵消
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const TargetEvent& event = mDispatchQueue[i];
+            const int32_t lastIndex = mBatchLastIndex[event.targetId];
+            if (lastIndex != static_cast<int32_t>(i)) {
+                continue;
+            }
+            mBatchLastIndex[event.targetId] = -1;
+            const int8_t type = static_cast<int8_t>(event.eventType);
+            if (mDispatchedTypes[event.targetId] == type ||
+                (mDispatchedTypes[event.targetId] < 0 && event.eventType == TargetEventType::TARGET_LOST)) {
+                continue;
+            }
+            mDispatchedTypes[event.targetId] = type;
+            if (kept != i) {
+                mDispatchQueue[kept] = event;
+            }
+            ++kept;
+        }
+        
+        if (kept < count) {
+            mCoalescedEvents.fetch_add(count - kept, std::memory_order_relaxed);
+        }
+        return kept;
+    }
+    
+    size_t TargetEventManager::takeBatch(int64_t& oldestNs) {
+        oldestNs = 0;
+        
+        // 從事件環無鎖取出所有積壓事件，回調期間生產者可以繼續寫入
+        size_t count = mEventRing.popBatch(mDispatchQueue, EVENT_RING_CAPACITY);
+        // 信箱事件排在環中事件之後（模式切換前入環的事件更早）
+        count = drainLatestStates(count);
+        if (mResetDispatchState.exchange(false, std::memory_order_acquire)) {
+            std::fill(mDispatchedTypes.begin(), mDispatchedTypes.end(), static_cast<int8_t>(-1));
+        }
+        if (count == 0) {
+            return 0;
+        }
+        // 信箱按目標 ID 取出，最早的事件不一定在第一個
+        oldestNs = mDispatchQueue[0].timestampNs;
+        for (size_t i = 1; i < count; ++i) {
+            oldestNs = std::min(oldestNs, mDispatchQueue[i].timestampNs);
+        }
+        return coalesceBatch(count);
+    }
+    
+    bool TargetEventManager::takePendingNames(size_t& firstId, std::vector<std::string>& names) {
+        // 鎖內只複製新登記的名稱，JNI 調用在鎖外進行，不阻塞渲染線程的目標登記
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        if (mTargetNames.size() <= mNamesSent) {
+            return false;
+        }
+        firstId = mNamesSent;
+        names.assign(mTargetNames.begin() + static_cast<std::ptrdiff_t>(firstId), mTargetNames.end());
+        return true;
+    }
+    
+    void TargetEventManager::markNamesSent(size_t end) {
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        mNamesSent = std::max(mNamesSent, end);
+    }
+    
+    void TargetEventManager::clearEvents() {
+        mEventRing.clear();
+        std::lock_guard<std::mutex> lock(mTargetsMutex);
+        std::fill(mLatestPending.begin(), mLatestPending.end(), static_cast<uint8_t>(0));
+        mLatestPendingCount.store(0, std::memory_order_relaxed);
+        // 名稱表與 ID 保留（Java 端已持有映射），只重置事件狀態
+        for (auto& state : mTargetStates) {
+            state.lastEventType = TargetEventType::TARGET_LOST;
+            state.pendingFrames = 0;
+        }
+        // 分發者的狀態由它自己在下一批開始時重置
+        mResetDispatchState.store(true, std::memory_order_release);
+    }
+    
+    size_t TargetEventManager::getEventCount() const {
+        return mEventRing.size() + mLatestPendingCount.load(std::memory_order_relaxed);
+    }
+
+} // namespace VuforiaWrapper
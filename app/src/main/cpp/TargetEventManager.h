@@ -0,0 +1,174 @@
+#ifndef TARGET_EVENT_MANAGER_H
+#define TARGET_EVENT_MANAGER_H
+
+// ==================== 目標事件管理器 ====================
+// 渲染線程每幀把觀察結果交給 addEvents：解析目標 ID、套用狀態遲滯，
+// 狀態變化寫入無鎖事件環（或每目標一格的信箱）。分發線程用 takeBatch 取出並合併，
+// 再由 TargetEventDispatcher 打包成 Java 回調。這裡不依賴 JNI，可以在主機端測試。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "TrackingTypes.h"
+#include "SpscRing.h"
+
+namespace VuforiaWrapper {
+    class TargetEventManager {
+    private:
+        // 每個目標的逐幀狀態，與名稱表一樣以目標 ID（登記順序）索引
+        struct TargetState {
+            TargetEventType lastEventType;   // 最後一次發出的事件類型，初始視為 LOST
+            TargetEventType pendingType;     // 等待滿足遲滯條件的新狀態
+            uint32_t pendingFrames;          // 新狀態已連續出現的幀數，0 表示沒有待定狀態
+            int64_t pendingSinceNs;          // 新狀態首次出現的時間
+        };
+        
+    public:
+        // 事件環容量：正常每幀只有少量狀態變化，足以容納分發線程暫停期間的積壓
+        static constexpr size_t EVENT_RING_CAPACITY = 256;
+        
+        // 默認遲滯：新狀態連續 3 幀或持續 100ms 後才發出
+        static constexpr uint32_t DEFAULT_HYSTERESIS_FRAMES = 3;
+        static constexpr uint32_t DEFAULT_HYSTERESIS_MS = 100;
+        
+    private:
+        // 生產者（渲染線程的觀察結果提取）與分發線程（takeBatch）之間的無鎖事件環
+        SpscRing<TargetEvent, EVENT_RING_CAPACITY> mEventRing;
+        TargetEvent mDispatchQueue[EVENT_RING_CAPACITY];  // takeBatch 取出的批次
+        // 保護名稱表與狀態表（登記可能來自 Java 線程），每幀只加一次鎖
+        mutable std::mutex mTargetsMutex;
+        std::vector<std::string> mTargetNames;      // 駐留名稱表，只在登記時追加
+        std::vector<TargetState> mTargetStates;     // 平坦狀態數組
+        std::vector<int32_t> mObserverToTarget;     // observer ID → 目標 ID（-1 表示未登記）
+        size_t mNamesSent = 0;           // 已交給分發者的名稱數量
+        
+        // 狀態遲滯設置（任意線程可修改）與抑制統計
+        std::atomic<uint32_t> mHysteresisFrames{DEFAULT_HYSTERESIS_FRAMES};
+        std::atomic<uint32_t> mHysteresisMs{DEFAULT_HYSTERESIS_MS};
+        std::atomic<uint64_t> mSuppressedFlaps{0};    // 未達遲滯條件就撤回的狀態變化
+        std::atomic<uint64_t> mCoalescedEvents{0};    // 批次內相互抵消或被後續事件取代的事件
+        
+        // 批次合併用：每個目標最後分發的類型與本批最後一個事件的位置（只由分發者訪問）
+        std::vector<int8_t> mDispatchedTypes;       // -1 表示尚未分發過
+        std::vector<int32_t> mBatchLastIndex;       // -1 表示本批沒有該目標的事件
+        std::atomic<bool> mResetDispatchState{false};  // clearEvents 請求分發者重置上述狀態
+        
+        // 隊列模式；LATEST_STATE_ONLY 時事件不進環，改寫入每目標一格的信箱（受 mTargetsMutex 保護）
+        std::atomic<int> mQueueMode{static_cast<int>(EventQueueMode::DROP_OLDEST)};
+        std::vector<TargetEvent> mLatestEvents;     // 以目標 ID 索引
+        std::vector<uint8_t> mLatestPending;        // 1 表示該格有未分發事件
+        std::atomic<size_t> mLatestPendingCount{0}; // 分發者無鎖判斷信箱是否為空
+        size_t mLatestHighWater = 0;
+        std::atomic<uint64_t> mSupersededEvents{0}; // 信箱中未分發就被同一目標新事件取代的數量
+        
+    public:
+        TargetEventManager() = default;
+        ~TargetEventManager() = default;
+        
+        /**
+         * 登記目標名稱並分配 ID；已登記的名稱返回原 ID
+         * 新名稱由分發者在下一批事件之前通過 takePendingNames 一次性取走
+         * @param observerId vuObserverGetId 的結果，之後的觀察結果直接按它查找；未知時傳 -1
+         */
+        int32_t registerTarget(const char* targetName, int32_t observerId = -1);
+        
+        // 清除 observer ID 映射（observer 銷毀後 ID 可能被重用），名稱表與目標 ID 保留
+        void clearObserverIds();
+        
+        // 按名稱查找目標 ID（查詢路徑使用），未登記返回 -1
+        int32_t findTarget(const char* targetName) const;
+        
+        // 更換回調對象後，下一批事件之前重新發送完整名稱表
+        void resendTargetNames();
+        
+        // 添加單個事件（生產者線程）
+        void addEvent(const char* targetName, TargetEventType eventType, 
+                     const VuMatrix44F& poseMatrix, float confidence = 1.0f);
+        
+        /**
+         * 添加一幀的全部觀察結果（生產者線程，每批只加一次鎖）
+         * 同時把解析出的目標 ID 寫回 observations[i].targetId
+         */
+        void addEvents(TargetObservation* observations, size_t count);
+        
+        /**
+         * 設置狀態遲滯：新狀態連續出現 frames 幀或持續 milliseconds 毫秒後才發出事件
+         * frames 為 1 時停用遲滯（每次變化立即發出）
+         */
+        void setHysteresis(uint32_t frames, uint32_t milliseconds);
+        
+        // 被遲滯抑制的狀態變化數量
+        uint64_t getSuppressedCount() const { return mSuppressedFlaps.load(std::memory_order_relaxed); }
+        
+        // 分發前在批次內合併掉的事件數量
+        uint64_t getCoalescedCount() const { return mCoalescedEvents.load(std::memory_order_relaxed); }
+        
+        /**
+         * 設置事件隊列模式與容量（任意線程，之後的事件生效）
+         * @param capacity 事件環可用容量，限制在 1..EVENT_RING_CAPACITY；LATEST_STATE_ONLY 時由目標數決定
+         */
+        void setQueuePolicy(EventQueueMode mode, size_t capacity);
+        
+        EventQueueMode getQueueMode() const { return static_cast<EventQueueMode>(mQueueMode.load(std::memory_order_relaxed)); }
+        size_t getQueueCapacity() const { return mEventRing.getLimit(); }
+        
+        // 隊列歷史最高積壓量（事件環與信箱取較大者）
+        size_t getHighWaterMark() const;
+        
+        // 各策略下的丟棄數量
+        uint64_t getDroppedNewestCount() const { return mEventRing.getDroppedNewestCount(); }
+        uint64_t getDroppedOldestCount() const { return mEventRing.getDroppedOldestCount(); }
+        uint64_t getSupersededCount() const { return mSupersededEvents.load(std::memory_order_relaxed); }
+        
+        /**
+         * 取出積壓事件並合併成一批（只由分發線程調用），結果在 getBatch() 中
+         * 返回的批次在下一次 takeBatch 之前有效
+         * @param oldestNs 本批最早事件的入隊時間（納秒），沒有取出任何事件時為 0
+         * @return 合併後的事件數量
+         */
+        size_t takeBatch(int64_t& oldestNs);
+        
+        const TargetEvent* getBatch() const { return mDispatchQueue; }
+        
+        /**
+         * 複製尚未交給分發者的名稱（只由分發線程調用，只在有新目標登記時分配）
+         * @param firstId names[0] 的目標 ID
+         * @return 沒有新名稱時返回 false
+         */
+        bool takePendingNames(size_t& firstId, std::vector<std::string>& names);
+        
+        // 名稱已送達 Java，end 為已送達的最大目標 ID + 1
+        void markNamesSent(size_t end);
+        
+        // 清空事件隊列
+        void clearEvents();
+        
+        // 獲取隊列大小
+        size_t getEventCount() const;
+        
+    private:
+        // 在持鎖狀態下查找或登記目標
+        int32_t findOrRegisterLocked(const char* targetName, int32_t observerId);
+        
+        // 在持鎖狀態下把 observer ID 解析為目標 ID，只有首次出現時才讀取名稱
+        int32_t resolveObserverLocked(int32_t observerId, const char* targetName);
+        
+        // 檢查事件是否需要觸發（避免重複事件並套用遲滯），需要時同時記錄最新狀態
+        bool shouldTriggerEvent(int32_t targetId, TargetEventType eventType, int64_t nowNs);
+        
+        // 合併批次內同一目標的事件，返回保留的事件數量
+        size_t coalesceBatch(size_t count);
+        
+        // 在持鎖狀態下按隊列模式把事件寫入事件環或信箱
+        void pushEventLocked(int32_t targetId, TargetEventType eventType,
+                             const VuMatrix44F& poseMatrix, float confidence);
+        
+        // 把信箱中的事件追加到 mDispatchQueue[offset..]，返回新的批次長度
+        size_t drainLatestStates(size_t offset);
+    };
+}
+
+#endif // TARGET_EVENT_MANAGER_H
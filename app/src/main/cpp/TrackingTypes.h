@@ -0,0 +1,103 @@
+#ifndef TRACKING_TYPES_H
+#define TRACKING_TYPES_H
+
+// ==================== 追蹤數據類型 ====================
+// 觀察結果、目標事件與追蹤快照等逐幀記錄，以及矩陣工具函數。
+// 只依賴 Vuforia 的數據類型頭文件（不依賴 JNI / GLES），
+// 事件管理器、包圍盒表等逐幀模塊可以在主機端單獨編譯測試。
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "VuforiaEngine/VuforiaEngine.h"
+
+// ==================== 矩陣工具函數 ====================
+namespace VuforiaWrapper {
+    // 手動設置單位矩陣的工具函數
+    inline void setIdentityMatrix(VuMatrix44F& matrix) {
+        memset(&matrix, 0, sizeof(VuMatrix44F));
+        matrix.data[0] = 1.0f;   // [0,0]
+        matrix.data[5] = 1.0f;   // [1,1]
+        matrix.data[10] = 1.0f;  // [2,2]
+        matrix.data[15] = 1.0f;  // [3,3]
+    }
+    
+    // 複製矩陣的工具函數
+    inline void copyMatrix(VuMatrix44F& dest, const VuMatrix44F& src) {
+        memcpy(&dest, &src, sizeof(VuMatrix44F));
+    }
+}
+
+
+// ==================== 追蹤常量 ====================
+namespace VuforiaWrapper {
+    // 追蹤快照常量：槽位數需容納短暫持有快照的讀者，外加一個寫入槽位
+    static constexpr size_t TRACKING_SNAPSHOT_MAX_TARGETS = 32;
+    static constexpr size_t TRACKING_SNAPSHOT_SLOTS = 4;
+}
+
+// ==================== 逐幀記錄 ====================
+namespace VuforiaWrapper {
+    
+    // Target 檢測事件
+    enum class TargetEventType {
+        TARGET_FOUND = 0,
+        TARGET_TRACKING = 1,
+        TARGET_LOST = 2,
+        TARGET_EXTENDED_TRACKING = 3
+    };
+    
+    // 事件隊列模式（數值與 Java 端 EVENT_QUEUE_* 常量一致）
+    enum class EventQueueMode {
+        DROP_NEWEST = 0,        // 隊列滿時丟棄新事件
+        DROP_OLDEST = 1,        // 隊列滿時覆蓋最舊事件（默認）
+        LATEST_STATE_ONLY = 2   // 每個目標只保留最新一個未分發事件
+    };
+    
+    // Target 事件數據 - 可平凡複製的 POD 記錄，經 SpscRing 從生產者傳給分發者
+    struct TargetEvent {
+        int32_t targetId;           // TargetEventManager 名稱表中的索引
+        TargetEventType eventType;
+        VuMatrix44F poseMatrix;
+        int64_t timestampNs;        // steady_clock（CLOCK_MONOTONIC）納秒
+        float confidence;
+        
+        TargetEvent() : targetId(-1), eventType(TargetEventType::TARGET_LOST), timestampNs(0), confidence(0.0f) {
+            // 使用新的矩陣初始化方法
+            setIdentityMatrix(poseMatrix);
+        }
+    };
+    
+    // 單幀追蹤快照 - 發佈後不可變，任意線程可一致地讀取同一幀的目標姿態與相機矩陣
+    // 只包含 TRACKED / EXTENDED_TRACKED 的目標，姿態為觀察值（未外推），與矩陣同屬一幀
+    struct TrackingSnapshot {
+        uint64_t frameSequence;     // 對應的相機幀序號
+        int64_t timestampNs;        // 發佈時間（CLOCK_MONOTONIC）
+        VuMatrix44F projectionMatrix;
+        VuMatrix44F viewMatrix;
+        uint32_t targetCount;
+        int32_t targetIds[TRACKING_SNAPSHOT_MAX_TARGETS];
+        int32_t poseStatus[TRACKING_SNAPSHOT_MAX_TARGETS];           // VuObservationPoseStatus
+        float poses[TRACKING_SNAPSHOT_MAX_TARGETS * 16];             // 每個目標 16 個 float（列主序）
+        
+        TrackingSnapshot() : frameSequence(0), timestampNs(0), targetCount(0) {
+            setIdentityMatrix(projectionMatrix);
+            setIdentityMatrix(viewMatrix);
+        }
+    };
+    
+    // 單幀觀察結果 - targetName 指向 VuState 內部數據，只在本幀內有效
+    // targetName 只在 observerId 尚未登記時讀取一次
+    struct TargetObservation {
+        int32_t observerId;         // vuObservationGetObserverId
+        int32_t targetId;           // TargetEventManager::addEvents 填入的目標 ID
+        const char* targetName;
+        TargetEventType eventType;
+        int32_t poseStatus;         // 原始 VuObservationPoseStatus
+        VuMatrix44F poseMatrix;
+        VuAABB bbox;                // 目標座標系下的包圍盒
+        float confidence;
+    };
+}
+
+#endif // TRACKING_TYPES_H
@@ -0,0 +1,330 @@
+// ==================== VideoModeGovernor.cpp ====================
+// 根據幀處理時間自動切換相機視頻模式
+
+#include "VideoModeGovernor.h"
+#include "VuforiaWrapper.h"
+#include <algorithm>
+
+namespace VuforiaWrapper {
+
+    // 反覆降級時升級等待的上限
+    static const int64_t kMaxUpgradeBackoffMs = 5 * 60 * 1000;
+
+    VideoModeGovernor::VideoModeGovernor()
+        : mEnabled(true)
+        , mWindowStale(false)
+        , mOverloadedWindows(0)
+        , mHeadroomWindows(0)
+        , mActiveLevel(-1)
+        , mPendingLevel(-1)
+        , mLastSwitchMs(0)
+        , mDecisionNext(0)
+        , mDecisionCount(0)
+        , mLastP90Ms(0.0f) {
+        mWindow.reserve(mConfig.windowFrames);
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            mModes[level] = {false, 0, 0, 0.0f};
+            mUpgradeBlockedUntilMs[level] = 0;
+            mUpgradeBackoffMs[level] = mConfig.upgradeBackoff.count();
+        }
+    }
+
+    int VideoModeGovernor::levelOf(VuCameraVideoModePreset preset) {
+        switch (preset) {
+            case VU_CAMERA_VIDEO_MODE_PRESET_OPTIMIZE_SPEED:
+                return 0;
+            case VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT:
+                return 1;
+            case VU_CAMERA_VIDEO_MODE_PRESET_OPTIMIZE_QUALITY:
+                return 2;
+            default:
+                return -1;
+        }
+    }
+
+    VuCameraVideoModePreset VideoModeGovernor::presetOf(int level) {
+        switch (level) {
+            case 0:
+                return VU_CAMERA_VIDEO_MODE_PRESET_OPTIMIZE_SPEED;
+            case 2:
+                return VU_CAMERA_VIDEO_MODE_PRESET_OPTIMIZE_QUALITY;
+            default:
+                return VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT;
+        }
+    }
+
+    const char* VideoModeGovernor::presetName(VuCameraVideoModePreset preset) {
+        switch (preset) {
+            case VU_CAMERA_VIDEO_MODE_PRESET_OPTIMIZE_SPEED:
+                return "SPEED";
+            case VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT:
+                return "DEFAULT";
+            case VU_CAMERA_VIDEO_MODE_PRESET_OPTIMIZE_QUALITY:
+                return "QUALITY";
+            default:
+                return "UNKNOWN";
+        }
+    }
+
+    int64_t VideoModeGovernor::nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void VideoModeGovernor::setEnabled(bool enabled) {
+        mEnabled.store(enabled, std::memory_order_release);
+        LOGI("🎚️ Video mode governor %s", enabled ? "enabled" : "disabled");
+    }
+
+    void VideoModeGovernor::setConfig(const Config& config) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mConfig = config;
+        if (mConfig.windowFrames == 0) {
+            mConfig.windowFrames = 1;
+        }
+        mWindow.clear();
+        mWindow.reserve(mConfig.windowFrames);
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            mUpgradeBackoffMs[level] = mConfig.upgradeBackoff.count();
+        }
+    }
+
+    bool VideoModeGovernor::refreshVideoModes(VuController* cameraController) {
+        if (cameraController == nullptr) {
+            return false;
+        }
+
+        VuCameraVideoModeList* list = nullptr;
+        if (vuCameraVideoModeListCreate(&list) != VU_SUCCESS || list == nullptr) {
+            LOGE("❌ Failed to create video mode list");
+            return false;
+        }
+
+        ModeInfo modes[LEVEL_COUNT] = {};
+        int32_t size = 0;
+        if (vuCameraControllerGetVideoModes(cameraController, list) == VU_SUCCESS) {
+            vuCameraVideoModeListGetSize(list, &size);
+        }
+        for (int32_t i = 0; i < size; ++i) {
+            VuCameraVideoMode mode;
+            if (vuCameraVideoModeListGetElement(list, i, &mode) != VU_SUCCESS) {
+                continue;
+            }
+            const int level = levelOf(mode.presetMode);
+            if (level < 0) {
+                continue;
+            }
+            modes[level] = {true, mode.resolution.data[0], mode.resolution.data[1], mode.frameRate};
+            LOGI("📷 Video mode %s: %dx%d @ %.1f fps", presetName(mode.presetMode),
+                 mode.resolution.data[0], mode.resolution.data[1], mode.frameRate);
+        }
+        vuCameraVideoModeListDestroy(list);
+
+        VuCameraVideoModePreset active = VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT;
+        vuCameraControllerGetActiveVideoMode(cameraController, &active);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::copy(std::begin(modes), std::end(modes), std::begin(mModes));
+        mActiveLevel = levelOf(active);
+        mPendingLevel = -1;
+        mLastSwitchMs = nowMs();
+        return size > 0;
+    }
+
+    // ==================== 渲染線程 ====================
+
+    bool VideoModeGovernor::recordFrame(float processingMs) {
+        if (!isEnabled()) {
+            return false;
+        }
+        // 切換期間的幀屬於舊模式或引擎重啟，不計入新模式的窗口
+        if (mWindowStale.load(std::memory_order_acquire)) {
+            mWindowStale.store(false, std::memory_order_relaxed);
+            mWindow.clear();
+        }
+        mWindow.push_back(processingMs);
+        if (mWindow.size() < mConfig.windowFrames) {
+            return false;
+        }
+        const bool switchRequested = evaluateWindow();
+        mWindow.clear();
+        return switchRequested;
+    }
+
+    void VideoModeGovernor::resetWindow() {
+        mWindowStale.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mOverloadedWindows = 0;
+        mHeadroomWindows = 0;
+    }
+
+    float VideoModeGovernor::budgetMsLocked() const {
+        if (mActiveLevel >= 0 && mModes[mActiveLevel].frameRate > 0.0f) {
+            return 1000.0f / mModes[mActiveLevel].frameRate;
+        }
+        return 1000.0f / 30.0f;
+    }
+
+    int VideoModeGovernor::findLevel(int from, int step) const {
+        for (int level = from + step; level >= 0 && level < LEVEL_COUNT; level += step) {
+            if (mModes[level].available) {
+                return level;
+            }
+        }
+        return -1;
+    }
+
+    bool VideoModeGovernor::evaluateWindow() {
+        // 窗口固定大小，原地部分排序取 p90
+        const size_t index = (mWindow.size() * 9) / 10;
+        std::nth_element(mWindow.begin(), mWindow.begin() + index, mWindow.end());
+        const float p90 = mWindow[index];
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLastP90Ms = p90;
+        if (mActiveLevel < 0 || mPendingLevel >= 0) {
+            return false;
+        }
+
+        const int64_t now = nowMs();
+        if (now - mLastSwitchMs < mConfig.minDwell.count()) {
+            return false;
+        }
+
+        bool switchRequested = false;
+        const float budget = budgetMsLocked();
+        if (p90 > budget * mConfig.overloadRatio) {
+            mHeadroomWindows = 0;
+            if (++mOverloadedWindows >= mConfig.downgradeWindows) {
+                const int target = findLevel(mActiveLevel, -1);
+                if (target >= 0) {
+                    requestSwitchLocked(target, p90, "frame budget exceeded");
+                    switchRequested = true;
+                }
+                mOverloadedWindows = 0;
+            }
+        } else if (p90 < budget * mConfig.headroomRatio) {
+            mOverloadedWindows = 0;
+            if (++mHeadroomWindows >= mConfig.upgradeWindows) {
+                const int target = findLevel(mActiveLevel, 1);
+                if (target >= 0 && now >= mUpgradeBlockedUntilMs[target]) {
+                    requestSwitchLocked(target, p90, "frame budget headroom");
+                    switchRequested = true;
+                }
+                mHeadroomWindows = 0;
+            }
+        } else {
+            // 處於遲滯帶內，保持當前模式
+            mOverloadedWindows = 0;
+            mHeadroomWindows = 0;
+        }
+        return switchRequested;
+    }
+
+    void VideoModeGovernor::requestSwitchLocked(int targetLevel, float p90Ms, const char* reason) {
+        mPendingLevel = targetLevel;
+
+        VideoModeDecision& decision = mDecisions[mDecisionNext];
+        decision.timestampMs = nowMs();
+        decision.fromPreset = presetOf(mActiveLevel);
+        decision.toPreset = presetOf(targetLevel);
+        decision.p90Ms = p90Ms;
+        decision.budgetMs = budgetMsLocked();
+        decision.reason = reason;
+        decision.applied = false;
+        mDecisionNext = (mDecisionNext + 1) % MAX_DECISIONS;
+        mDecisionCount = std::min(mDecisionCount + 1, MAX_DECISIONS);
+
+        LOGI("🎚️ Video mode %s -> %s requested (%s, p90 %.1f ms, budget %.1f ms)",
+             presetName(decision.fromPreset), presetName(decision.toPreset),
+             reason, p90Ms, decision.budgetMs);
+    }
+
+    bool VideoModeGovernor::takePendingSwitch(VuCameraVideoModePreset& preset) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mPendingLevel < 0) {
+            return false;
+        }
+        preset = presetOf(mPendingLevel);
+        return true;
+    }
+
+    void VideoModeGovernor::onSwitchApplied(VuCameraVideoModePreset preset, VideoModeSwitchResult result) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const int level = levelOf(preset);
+        const int64_t now = nowMs();
+        const bool success = result == VideoModeSwitchResult::APPLIED;
+
+        // 更新日誌中最近一條決定的結果
+        if (mDecisionCount > 0) {
+            VideoModeDecision& last = mDecisions[(mDecisionNext + MAX_DECISIONS - 1) % MAX_DECISIONS];
+            if (last.toPreset == preset) {
+                last.applied = success;
+            }
+        }
+
+        if (success && level >= 0) {
+            // 降級：離開的模式暫時不允許升回，反覆降級時等待加倍
+            if (level < mActiveLevel) {
+                const int left = mActiveLevel;
+                mUpgradeBlockedUntilMs[left] = now + mUpgradeBackoffMs[left];
+                mUpgradeBackoffMs[left] = std::min(mUpgradeBackoffMs[left] * 2, kMaxUpgradeBackoffMs);
+            }
+            mActiveLevel = level;
+        } else if (result == VideoModeSwitchResult::REJECTED && level >= 0) {
+            // 相機拒絕該模式：之後不再嘗試
+            mModes[level].available = false;
+        }
+        // FAILED：模式本身沒有被驗證，保持可用；停留時間過後窗口可以再次給出決定
+
+        mPendingLevel = -1;
+        mLastSwitchMs = now;
+        mOverloadedWindows = 0;
+        mHeadroomWindows = 0;
+    }
+
+    // ==================== 查詢 ====================
+
+    VuCameraVideoModePreset VideoModeGovernor::getActivePreset() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return presetOf(mActiveLevel);
+    }
+
+    std::vector<VideoModeDecision> VideoModeGovernor::getDecisionLog() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::vector<VideoModeDecision> log;
+        log.reserve(mDecisionCount);
+        const size_t first = (mDecisionNext + MAX_DECISIONS - mDecisionCount) % MAX_DECISIONS;
+        for (size_t i = 0; i < mDecisionCount; ++i) {
+            log.push_back(mDecisions[(first + i) % MAX_DECISIONS]);
+        }
+        return log;
+    }
+
+    std::string VideoModeGovernor::getReport() const {
+        const std::vector<VideoModeDecision> log = getDecisionLog();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(1);
+        report << "=== Video Mode Governor ===\n";
+        report << "Enabled: " << (isEnabled() ? "Yes" : "No") << "\n";
+        report << "Active Mode: " << (mActiveLevel >= 0 ? presetName(presetOf(mActiveLevel)) : "UNKNOWN")
+               << ", budget " << budgetMsLocked() << " ms, last p90 " << mLastP90Ms << " ms\n";
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            const ModeInfo& mode = mModes[level];
+            if (mode.available) {
+                report << "  " << presetName(presetOf(level)) << ": " << mode.width << "x"
+                       << mode.height << " @ " << mode.frameRate << " fps\n";
+            }
+        }
+        report << "Decisions (" << log.size() << "):\n";
+        for (const auto& decision : log) {
+            report << "  t=" << decision.timestampMs << "ms " << presetName(decision.fromPreset)
+                   << " -> " << presetName(decision.toPreset) << " (" << decision.reason
+                   << ", p90 " << decision.p90Ms << "/" << decision.budgetMs << " ms)"
+                   << (decision.applied ? "" : " [not applied]") << "\n";
+        }
+        return report.str();
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef VIDEO_MODE_GOVERNOR_H
+#define VIDEO_MODE_GOVERNOR_H
+
+// ==================== 相機視頻模式調節器 ====================
+// 根據渲染線程每幀處理時間自動切換相機視頻模式預設：
+//  - 每 windowFrames 幀統計一次 p90 處理時間，與幀預算（1000 / 模式幀率）比較
+//  - 連續 downgradeWindows 個窗口超出預算 → 降一級（QUALITY → DEFAULT → SPEED）
+//  - 連續 upgradeWindows 個窗口低於 headroomRatio × 預算 → 升一級
+//  - 遲滯：切換後 minDwell 內不再評估；升回曾經降級過的模式需要等待
+//    upgradeBackoff，且每次反覆降級後等待時間加倍
+// vuCameraControllerSetActiveVideoMode 只能在引擎停止時調用，因此調節器只
+// 給出決定，由 wrapper 在引擎控制線程上重啟引擎套用，渲染線程不等待。
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "VuforiaEngine/VuforiaEngine.h"
+
+namespace VuforiaWrapper {
+
+    // wrapper 套用一次切換的結果
+    enum class VideoModeSwitchResult {
+        APPLIED = 0,    // 已切換並重新啟動
+        REJECTED = 1,   // 相機拒絕該模式，或引擎無法以該模式啟動（已回滾）
+        FAILED = 2      // 前置條件或引擎本身失敗（沒有相機控制器、無法停止 / 重新啟動），模式未被驗證
+    };
+
+    // 一次切換決定
+    struct VideoModeDecision {
+        int64_t timestampMs;               // steady_clock 毫秒
+        VuCameraVideoModePreset fromPreset;
+        VuCameraVideoModePreset toPreset;
+        float p90Ms;                       // 觸發決定的窗口 p90 處理時間
+        float budgetMs;                    // 當時的幀預算
+        const char* reason;                // 靜態字符串
+        bool applied;                      // 引擎是否成功切換
+
+        VideoModeDecision()
+            : timestampMs(0)
+            , fromPreset(VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT)
+            , toPreset(VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT)
+            , p90Ms(0.0f)
+            , budgetMs(0.0f)
+            , reason("")
+            , applied(false) {}
+    };
+
+    class VideoModeGovernor {
+    public:
+        struct Config {
+            uint32_t windowFrames;         // 每個統計窗口的幀數
+            float overloadRatio;           // p90 > 預算 × overloadRatio 視為超載
+            float headroomRatio;           // p90 < 預算 × headroomRatio 視為有餘量
+            uint32_t downgradeWindows;     // 連續超載窗口數
+            uint32_t upgradeWindows;       // 連續有餘量窗口數
+            std::chrono::milliseconds minDwell;       // 切換後最短停留時間
+            std::chrono::milliseconds upgradeBackoff; // 升回降級過的模式前的初始等待
+
+            Config()
+                : windowFrames(90)
+                , overloadRatio(1.0f)
+                , headroomRatio(0.6f)
+                , downgradeWindows(2)
+                , upgradeWindows(5)
+                , minDwell(10000)
+                , upgradeBackoff(30000) {}
+        };
+
+        static constexpr size_t MAX_DECISIONS = 32;
+
+        VideoModeGovernor();
+
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return mEnabled.load(std::memory_order_acquire); }
+
+        // 只能在沒有幀正在統計時調用（例如引擎啟動前）
+        void setConfig(const Config& config);
+
+        /**
+         * 從相機控制器讀取可用模式與當前模式（引擎啟動後調用，避免額外打開相機）
+         * @return 讀取失敗或沒有可用模式時返回 false
+         */
+        bool refreshVideoModes(VuController* cameraController);
+
+        // ==================== 渲染線程接口 ====================
+
+        /**
+         * 記錄一幀的處理時間（毫秒）
+         * @return 本幀結束的窗口產生了切換決定時返回 true，調用者應喚醒引擎控制線程
+         */
+        bool recordFrame(float processingMs);
+
+        // ==================== 引擎控制線程接口 ====================
+
+        // 取出待套用的切換；返回 false 表示不需要切換
+        bool takePendingSwitch(VuCameraVideoModePreset& preset);
+
+        // wrapper 套用切換後回報結果；只有 REJECTED 會把該模式標記為不可用
+        void onSwitchApplied(VuCameraVideoModePreset preset, VideoModeSwitchResult result);
+
+        // 引擎重啟或暫停後丟棄當前窗口（任意線程，渲染線程在下一次 recordFrame 清空）
+        void resetWindow();
+
+        // ==================== 查詢（任意線程） ====================
+
+        VuCameraVideoModePreset getActivePreset() const;
+        std::vector<VideoModeDecision> getDecisionLog() const;
+        std::string getReport() const;
+
+        static const char* presetName(VuCameraVideoModePreset preset);
+
+    private:
+        // 由低到高的質量等級
+        static constexpr int LEVEL_COUNT = 3;
+
+        struct ModeInfo {
+            bool available;
+            int32_t width;
+            int32_t height;
+            float frameRate;
+        };
+
+        static int levelOf(VuCameraVideoModePreset preset);
+        static VuCameraVideoModePreset presetOf(int level);
+        static int64_t nowMs();
+
+        // 產生切換決定時返回 true
+        bool evaluateWindow();
+        int findLevel(int from, int step) const;
+        float budgetMsLocked() const;
+        void requestSwitchLocked(int targetLevel, float p90Ms, const char* reason);
+
+        std::atomic<bool> mEnabled;
+        Config mConfig;
+
+        // 渲染線程私有的窗口統計
+        std::vector<float> mWindow;
+        std::atomic<bool> mWindowStale;    // 其他線程要求丟棄窗口
+        uint32_t mOverloadedWindows;
+        uint32_t mHeadroomWindows;
+
+        mutable std::mutex mMutex;
+        ModeInfo mModes[LEVEL_COUNT];
+        int mActiveLevel;
+        int mPendingLevel;                 // -1 表示沒有待套用的切換
+        int64_t mLastSwitchMs;
+        int64_t mUpgradeBlockedUntilMs[LEVEL_COUNT];
+        int64_t mUpgradeBackoffMs[LEVEL_COUNT];
+        VideoModeDecision mDecisions[MAX_DECISIONS];
+        size_t mDecisionNext;
+        size_t mDecisionCount;
+        float mLastP90Ms;
+    };
+}
+
+#endif // VIDEO_MODE_GOVERNOR_H
@@ -6,6 +6,10 @@
 
 #include "VuforiaRenderingJNI.h"
 #include "VuforiaWrapper.h"  // 引用主要的Wrapper类       // OpenGL扩展
+#include "JniRegistry.h"
+#include "ShaderProgram.h"
+#include "GLStateTracker.h"
+#include "ProgramBinaryCache.h"
 #include <jni.h>
 #include <android/log.h>
 #include <GLES3/gl3.h>
@@ -28,11 +32,33 @@ namespace VuforiaRendering {
     struct RenderingState {
         // OpenGL资源
         bool initialized;
-        GLuint videoBackgroundShaderProgram;
+        EGLContext glContext;       // 資源所屬的上下文，變化即表示上下文已丟失
+        GLStateTracker glState;     // 當前上下文的狀態記錄
+        ProgramBinaryCache programCache;
+        ShaderProgram videoBackgroundShader;
+        struct {
+            AttributeHandle position;
+            AttributeHandle texCoord;
+            Mat4Uniform projectionMatrix;
+            Mat4Uniform modelViewMatrix;
+            SamplerUniform cameraTexture;
+            FloatUniform alpha;
+        } videoBackgroundHandles;
         GLuint videoBackgroundVAO;
         GLuint videoBackgroundVBO;
+        GLuint videoBackgroundIBO;
         GLuint videoBackgroundTextureId;
         
+        // 視頻背景網格（常駐 GPU，只在內容或視口變化時重新上傳）
+        uint64_t meshHash;          // 已上傳網格內容的 FNV-1a 哈希
+        int meshViewportWidth;      // 上傳時的視口
+        int meshViewportHeight;
+        GLsizei meshVertexCount;
+        GLsizei meshIndexCount;     // 0 表示無索引，用 glDrawArrays
+        long meshUploadCount;
+        int viewportWidth;          // onSurfaceChanged 設置的當前視口
+        int viewportHeight;
+        
         // 性能监控
         std::chrono::steady_clock::time_point lastFrameTime;
         float currentFPS;
@@ -53,9 +79,12 @@ namespace VuforiaRendering {
             GLuint currentTexture;
         } savedGLState;
         
-        RenderingState() : initialized(false), videoBackgroundShaderProgram(0),
-                        videoBackgroundVAO(0), videoBackgroundVBO(0),
-                        videoBackgroundTextureId(0), currentFPS(0.0F),
+        RenderingState() : initialized(false), glContext(EGL_NO_CONTEXT),
+                        videoBackgroundVAO(0), videoBackgroundVBO(0), videoBackgroundIBO(0),
+                        videoBackgroundTextureId(0), meshHash(0),
+                        meshViewportWidth(0), meshViewportHeight(0),
+                        meshVertexCount(0), meshIndexCount(0), meshUploadCount(0),
+                        viewportWidth(0), viewportHeight(0), currentFPS(0.0F),
                         totalFrameCount(0), videoBackgroundRenderingEnabled(true),
                         renderingQuality(1) {
             lastFrameTime = std::chrono::steady_clock::now();
@@ -132,93 +161,262 @@ namespace VuforiaRendering {
             }
         )";
         
-        // 编译顶点着色器
-        GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-        glCompileShader(vertexShader);
-        
-        GLint vertexCompileStatus;
-        glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &vertexCompileStatus);
-        if (vertexCompileStatus != GL_TRUE) {
-            const int LOG_BUFFER_SIZE = 512;
-            GLchar infoLog[LOG_BUFFER_SIZE];
-            glGetShaderInfoLog(vertexShader, sizeof(infoLog), nullptr, infoLog);
-            LOGE_RENDER("❌ Vertex shader compilation failed: %s", infoLog);
-            glDeleteShader(vertexShader);
+        ShaderProgram& program = g_renderingState.videoBackgroundShader;
+        program.setStateTracker(&g_renderingState.glState);
+        if (!program.build("VideoBackground", vertexShaderSource, fragmentShaderSource,
+                           &g_renderingState.programCache)) {
             return false;
         }
         
-        // 编译片段着色器
-        GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-        glCompileShader(fragmentShader);
-        
-        GLint fragmentCompileStatus;
-        glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &fragmentCompileStatus);
-        if (fragmentCompileStatus != GL_TRUE) {
-            const int LOG_BUFFER_SIZE = 512;
-            GLchar infoLog[LOG_BUFFER_SIZE];
-            glGetShaderInfoLog(fragmentShader, sizeof(infoLog), nullptr, infoLog);
-            LOGE_RENDER("❌ Fragment shader compilation failed: %s", infoLog);
-            glDeleteShader(vertexShader);
-            glDeleteShader(fragmentShader);
-            return false;
-        }
-        
-        // 创建着色器程序
-        g_renderingState.videoBackgroundShaderProgram = glCreateProgram();
-        glAttachShader(g_renderingState.videoBackgroundShaderProgram, vertexShader);
-        glAttachShader(g_renderingState.videoBackgroundShaderProgram, fragmentShader);
-        glLinkProgram(g_renderingState.videoBackgroundShaderProgram);
-        
-        GLint linkStatus;
-        glGetProgramiv(g_renderingState.videoBackgroundShaderProgram, GL_LINK_STATUS, &linkStatus);
-        if (linkStatus != GL_TRUE) {
-            const int LOG_BUFFER_SIZE = 512;
-            GLchar infoLog[LOG_BUFFER_SIZE];
-            glGetProgramInfoLog(g_renderingState.videoBackgroundShaderProgram, sizeof(infoLog), nullptr, infoLog);
-            LOGE_RENDER("❌ Shader program linking failed: %s", infoLog);
-            
-            glDeleteShader(vertexShader);
-            glDeleteShader(fragmentShader);
-            glDeleteProgram(g_renderingState.videoBackgroundShaderProgram);
-            g_renderingState.videoBackgroundShaderProgram = 0;
-            return false;
-        }
+        auto& handles = g_renderingState.videoBackgroundHandles;
+        handles.position = program.attribute("a_position");
+        handles.texCoord = program.attribute("a_texCoord");
+        handles.projectionMatrix = program.mat4Uniform("u_projectionMatrix");
+        handles.modelViewMatrix = program.mat4Uniform("u_modelViewMatrix");
+        handles.cameraTexture = program.samplerUniform("u_cameraTexture");
+        handles.alpha = program.floatUniform("u_alpha");
         
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        // 不隨幀變化的 uniform 在鏈接後設置一次
+        static const float IDENTITY[MATRIX_SIZE] = {
+            1.0F, 0.0F, 0.0F, 0.0F,
+            0.0F, 1.0F, 0.0F, 0.0F,
+            0.0F, 0.0F, 1.0F, 0.0F,
+            0.0F, 0.0F, 0.0F, 1.0F
+        };
+        g_renderingState.glState.useProgram(program.getId());
+        handles.modelViewMatrix.set(IDENTITY);
+        handles.cameraTexture.set(0);
+        handles.alpha.set(1.0F);
         
-        LOGI_RENDER("✅ Video background shader program created successfully (ID: %d)", 
-                g_renderingState.videoBackgroundShaderProgram);
+        LOGI_RENDER("✅ Video background shader program created successfully (ID: %u)", program.getId());
         return true;
     }
     
+    // 釋放視頻背景紋理；上下文丟失時句柄已失效，只清零不刪除
+    void releaseVideoBackgroundTexture(bool contextLost) {
+        if (!contextLost && g_renderingState.videoBackgroundTextureId != 0) {
+            glDeleteTextures(1, &g_renderingState.videoBackgroundTextureId);
+            g_renderingState.glState.onTextureDeleted(g_renderingState.videoBackgroundTextureId);
+        }
+        g_renderingState.videoBackgroundTextureId = 0;
+    }
+    
     // 設置視頻背景紋理
     bool setupVideoBackgroundTexture() {
         LOGI_RENDER("📷 Setting up video background texture...");
         
+        releaseVideoBackgroundTexture(false);
         glGenTextures(1, &g_renderingState.videoBackgroundTextureId);
         if (g_renderingState.videoBackgroundTextureId == 0) {
             LOGE_RENDER("❌ Failed to generate texture ID");
             return false;
         }
         
-        glBindTexture(GL_TEXTURE_EXTERNAL_OES, g_renderingState.videoBackgroundTextureId);
+        GLStateTracker& glState = g_renderingState.glState;
+        glState.activeTexture(GL_TEXTURE0);
+        glState.bindTexture(GL_TEXTURE_EXTERNAL_OES, g_renderingState.videoBackgroundTextureId);
         glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
         
         LOGI_RENDER("✅ Video background texture setup complete (ID: %d)", 
                    g_renderingState.videoBackgroundTextureId);
         return true;
     }
     
+    // ==================== 視頻背景網格 ====================
+    
+    // FNV-1a，網格只有幾十個頂點，逐字節哈希的開銷可以忽略
+    uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+    
+    uint64_t hashVideoBackgroundMesh(const VuMesh* mesh) {
+        uint64_t hash = 14695981039346656037ULL;
+        hash = hashBytes(hash, &mesh->numVertices, sizeof(mesh->numVertices));
+        hash = hashBytes(hash, &mesh->numFaces, sizeof(mesh->numFaces));
+        const size_t vertexCount = static_cast<size_t>(mesh->numVertices);
+        if (mesh->pos != nullptr) {
+            hash = hashBytes(hash, mesh->pos, vertexCount * 3 * sizeof(float));
+        }
+        if (mesh->tex != nullptr) {
+            hash = hashBytes(hash, mesh->tex, vertexCount * 2 * sizeof(float));
+        }
+        if (mesh->faceIndices != nullptr && mesh->numFaces > 0) {
+            hash = hashBytes(hash, mesh->faceIndices, static_cast<size_t>(mesh->numFaces) * 3 * sizeof(uint32_t));
+        }
+        return hash;
+    }
+    
+    // 釋放網格緩衝；上下文丟失時句柄已失效，只清零不刪除
+    void releaseVideoBackgroundMesh(bool contextLost) {
+        if (!contextLost) {
+            GLStateTracker& glState = g_renderingState.glState;
+            if (g_renderingState.videoBackgroundVAO != 0) {
+                glDeleteVertexArrays(1, &g_renderingState.videoBackgroundVAO);
+                glState.onVertexArrayDeleted(g_renderingState.videoBackgroundVAO);
+            }
+            if (g_renderingState.videoBackgroundVBO != 0) {
+                glDeleteBuffers(1, &g_renderingState.videoBackgroundVBO);
+                glState.onBufferDeleted(g_renderingState.videoBackgroundVBO);
+            }
+            if (g_renderingState.videoBackgroundIBO != 0) {
+                glDeleteBuffers(1, &g_renderingState.videoBackgroundIBO);
+                // ELEMENT_ARRAY_BUFFER 綁定屬於上面已刪除的 VAO；這裡只清掉可能殘留的 ARRAY_BUFFER 緩存
+                glState.onBufferDeleted(g_renderingState.videoBackgroundIBO);
+            }
+        }
+        g_renderingState.videoBackgroundVAO = 0;
+        g_renderingState.videoBackgroundVBO = 0;
+        g_renderingState.videoBackgroundIBO = 0;
+        g_renderingState.meshHash = 0;
+        g_renderingState.meshVertexCount = 0;
+        g_renderingState.meshIndexCount = 0;
+    }
+    
+    // 釋放視頻背景的全部 GL 資源（網格、著色器程序、紋理），之後需要重新初始化
+    void releaseVideoBackgroundResources(bool contextLost) {
+        releaseVideoBackgroundMesh(contextLost);
+        g_renderingState.videoBackgroundShader.release(contextLost);
+        releaseVideoBackgroundTexture(contextLost);
+        g_renderingState.initialized = false;
+    }
+    
+    /**
+     * 在當前上下文中創建視頻背景著色器與紋理，成功後標記為已初始化
+     * 調用者必須持有 g_renderingMutex
+     */
+    bool createVideoBackgroundResources() {
+        if (!createVideoBackgroundShader()) {
+            LOGE_RENDER("❌ Failed to create video background shader");
+            return false;
+        }
+        
+        if (!setupVideoBackgroundTexture()) {
+            LOGE_RENDER("❌ Failed to setup video background texture");
+            return false;
+        }
+        
+        g_renderingState.initialized = true;
+        return true;
+    }
+    
+    /**
+     * 與當前 EGL 上下文同步
+     * 上下文變化（首次創建或丟失後重建）時舊上下文的句柄全部失效：只清零不刪除，
+     * 標記為未初始化以便重新創建資源，並重置狀態記錄
+     * @return 上下文是否發生變化
+     */
+    bool syncWithCurrentContext() {
+        const EGLContext current = eglGetCurrentContext();
+        if (current == g_renderingState.glContext) {
+            return false;
+        }
+        if (g_renderingState.glContext != EGL_NO_CONTEXT) {
+            LOGW_RENDER("⚠️ GL context changed, dropping resources of the lost context");
+        }
+        releaseVideoBackgroundResources(true);
+        g_renderingState.glState.reset();
+        g_renderingState.programCache.onContextChanged();
+        g_renderingState.glContext = current;
+        return true;
+    }
+    
+    /**
+     * 確保視頻背景網格已在 VAO/VBO/IBO 中
+     * 內容哈希與視口都未變化時直接返回；否則整體重新上傳
+     * VBO 佈局：[位置 xyz × n][紋理座標 uv × n]
+     */
+    bool uploadVideoBackgroundMesh(const VuMesh* mesh) {
+        if (mesh->pos == nullptr || mesh->numVertices <= 0) {
+            return false;
+        }
+        
+        const uint64_t hash = hashVideoBackgroundMesh(mesh);
+        if (g_renderingState.videoBackgroundVAO != 0 &&
+            hash == g_renderingState.meshHash &&
+            g_renderingState.meshViewportWidth == g_renderingState.viewportWidth &&
+            g_renderingState.meshViewportHeight == g_renderingState.viewportHeight) {
+            return true;
+        }
+        
+        if (g_renderingState.videoBackgroundVAO == 0) {
+            glGenVertexArrays(1, &g_renderingState.videoBackgroundVAO);
+            glGenBuffers(1, &g_renderingState.videoBackgroundVBO);
+            glGenBuffers(1, &g_renderingState.videoBackgroundIBO);
+            if (g_renderingState.videoBackgroundVAO == 0 || g_renderingState.videoBackgroundVBO == 0 ||
+                g_renderingState.videoBackgroundIBO == 0) {
+                LOGE_RENDER("❌ Failed to create video background mesh buffers");
+                releaseVideoBackgroundMesh(false);
+                return false;
+            }
+        }
+        
+        const GLsizei vertexCount = static_cast<GLsizei>(mesh->numVertices);
+        const GLsizeiptr positionBytes = static_cast<GLsizeiptr>(vertexCount) * 3 * sizeof(float);
+        const GLsizeiptr texCoordBytes = mesh->tex != nullptr ?
+            static_cast<GLsizeiptr>(vertexCount) * 2 * sizeof(float) : 0;
+        const bool indexed = mesh->faceIndices != nullptr && mesh->numFaces > 0;
+        
+        GLStateTracker& glState = g_renderingState.glState;
+        glState.bindVertexArray(g_renderingState.videoBackgroundVAO);
+        
+        glState.bindArrayBuffer(g_renderingState.videoBackgroundVBO);
+        glBufferData(GL_ARRAY_BUFFER, positionBytes + texCoordBytes, nullptr, GL_STATIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, positionBytes, mesh->pos);
+        if (texCoordBytes > 0) {
+            glBufferSubData(GL_ARRAY_BUFFER, positionBytes, texCoordBytes, mesh->tex);
+        }
+        
+        const GLint positionAttribute = g_renderingState.videoBackgroundHandles.position.location;
+        const GLint texCoordAttribute = g_renderingState.videoBackgroundHandles.texCoord.location;
+        if (positionAttribute != -1) {
+            glEnableVertexAttribArray(positionAttribute);
+            glVertexAttribPointer(positionAttribute, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+        if (texCoordAttribute != -1) {
+            if (texCoordBytes > 0) {
+                glEnableVertexAttribArray(texCoordAttribute);
+                glVertexAttribPointer(texCoordAttribute, 2, GL_FLOAT, GL_FALSE, 0,
+                                      reinterpret_cast<const void*>(positionBytes));
+            } else {
+                glDisableVertexAttribArray(texCoordAttribute);
+            }
+        }
+        
+        // IBO 綁定記錄在 VAO 中
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_renderingState.videoBackgroundIBO);
+        if (indexed) {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                         static_cast<GLsizeiptr>(mesh->numFaces) * 3 * sizeof(uint32_t),
+                         mesh->faceIndices, GL_STATIC_DRAW);
+        }
+        
+        // VAO 保持綁定，繪製時不必重新綁定
+        
+        g_renderingState.meshHash = hash;
+        g_renderingState.meshViewportWidth = g_renderingState.viewportWidth;
+        g_renderingState.meshViewportHeight = g_renderingState.viewportHeight;
+        g_renderingState.meshVertexCount = vertexCount;
+        g_renderingState.meshIndexCount = indexed ? static_cast<GLsizei>(mesh->numFaces * 3) : 0;
+        g_renderingState.meshUploadCount++;
+        
+        LOGD_RENDER("📐 Video background mesh uploaded: %d vertices, %d indices, viewport %dx%d (upload #%ld)",
+                    vertexCount, g_renderingState.meshIndexCount,
+                    g_renderingState.viewportWidth, g_renderingState.viewportHeight,
+                    g_renderingState.meshUploadCount);
+        return true;
+    }
+    
     // 渲染視頻背景
     void renderVideoBackgroundWithProperShader(const VuRenderState& renderState) {
-        if (!g_renderingState.initialized || g_renderingState.videoBackgroundShaderProgram == 0) {
+        if (!g_renderingState.initialized || !g_renderingState.videoBackgroundShader.isValid()) {
             return;
         }
         
@@ -227,75 +425,39 @@ namespace VuforiaRendering {
                 return;
             }
             
-            // ✅ 新增：避免重複的 OpenGL 狀態切換
-            static bool glStatesInitialized = false;
-            if (!glStatesInitialized) {
-                glDisable(GL_DEPTH_TEST);
-                glDisable(GL_CULL_FACE);
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                glStatesInitialized = true;
-            }
-            
-            // ✅ 新增：避免重複綁定相同的著色器
-            static GLuint lastUsedProgram = 0;
-            if (lastUsedProgram != g_renderingState.videoBackgroundShaderProgram) {
-                glUseProgram(g_renderingState.videoBackgroundShaderProgram);
-                lastUsedProgram = g_renderingState.videoBackgroundShaderProgram;
-            }
+            // 所有狀態經過跟蹤器，與當前上下文中的實際狀態一致時不產生 GL 調用
+            GLStateTracker& glState = g_renderingState.glState;
+            glState.setEnabled(GL_DEPTH_TEST, false);
+            glState.setEnabled(GL_CULL_FACE, false);
+            glState.setEnabled(GL_BLEND, true);
+            glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             
-            // ✅ 新增：避免重複綁定相同的紋理
-            static GLuint lastBoundTexture = 0;
-            if (lastBoundTexture != g_renderingState.videoBackgroundTextureId) {
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_EXTERNAL_OES, g_renderingState.videoBackgroundTextureId);
-                lastBoundTexture = g_renderingState.videoBackgroundTextureId;
-                
-                GLint textureLocation = glGetUniformLocation(g_renderingState.videoBackgroundShaderProgram, "u_cameraTexture");
-                if (textureLocation != -1) {
-                    glUniform1i(textureLocation, 0);
-                }
-            }
-                
-            // 设置顶点属性
-            GLint positionAttribute = glGetAttribLocation(g_renderingState.videoBackgroundShaderProgram, "a_position");
-            GLint texCoordAttribute = glGetAttribLocation(g_renderingState.videoBackgroundShaderProgram, "a_texCoord");
+            glState.useProgram(g_renderingState.videoBackgroundShader.getId());
+            g_renderingState.videoBackgroundHandles.projectionMatrix.set(renderState.vbProjectionMatrix.data);
             
-            if (positionAttribute != -1 && renderState.vbMesh->pos != nullptr) {
-                glEnableVertexAttribArray(positionAttribute);
-                glVertexAttribPointer(positionAttribute, 3, GL_FLOAT, GL_FALSE, 0, renderState.vbMesh->pos);
-            }
+            glState.activeTexture(GL_TEXTURE0);
+            glState.bindTexture(GL_TEXTURE_EXTERNAL_OES, g_renderingState.videoBackgroundTextureId);
             
-            if (texCoordAttribute != -1 && renderState.vbMesh->tex != nullptr) {
-                glEnableVertexAttribArray(texCoordAttribute);
-                glVertexAttribPointer(texCoordAttribute, 2, GL_FLOAT, GL_FALSE, 0, renderState.vbMesh->tex);
+            // 从 GPU 缓冲绘制，网格内容或视口变化时才重新上传
+            if (!uploadVideoBackgroundMesh(renderState.vbMesh)) {
+                return;
             }
             
-            if (renderState.vbMesh->faceIndices != nullptr && renderState.vbMesh->numFaces > 0) {
-                glDrawElements(GL_TRIANGLES, renderState.vbMesh->numFaces * 3, GL_UNSIGNED_INT, renderState.vbMesh->faceIndices);
-            } else if (renderState.vbMesh->numVertices > 0) {
-                glDrawArrays(GL_TRIANGLES, 0, renderState.vbMesh->numVertices);
+            glState.bindVertexArray(g_renderingState.videoBackgroundVAO);
+            if (g_renderingState.meshIndexCount > 0) {
+                glDrawElements(GL_TRIANGLES, g_renderingState.meshIndexCount, GL_UNSIGNED_INT, nullptr);
+            } else {
+                glDrawArrays(GL_TRIANGLES, 0, g_renderingState.meshVertexCount);
             }
             
-            // 清理
-            if (positionAttribute != -1) {
-                glDisableVertexAttribArray(positionAttribute);
-            }
-            if (texCoordAttribute != -1) {
-                glDisableVertexAttribArray(texCoordAttribute);
-            }
-            
-            glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
-            glUseProgram(0);
-            
-            // 恢复OpenGL状态
-            glEnable(GL_DEPTH_TEST);
-            glEnable(GL_CULL_FACE);
-            glDisable(GL_BLEND);
+            // 恢复后续 3D 内容所需的状态；程序、纹理和 VAO 保持绑定，下一帧由跟踪器跳过
+            glState.setEnabled(GL_DEPTH_TEST, true);
+            glState.setEnabled(GL_CULL_FACE, true);
+            glState.setEnabled(GL_BLEND, false);
             
         } catch (const std::exception& e) {
             LOGE_RENDER("❌ Error in renderVideoBackgroundWithProperShader: %s", e.what());
-            glUseProgram(0);
+            g_renderingState.glState.useProgram(0);
         }
     }
         void debugRenderState(const VuRenderState& renderState) {
@@ -466,6 +628,23 @@ namespace VuforiaWrapper {
 } // namespace VuforiaWrapper
 // ==================== JNI 实现 - 使用内部渲染状态 ====================
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setShaderCacheDirectoryNative(
+    JNIEnv* env, jobject thiz, jstring directory) {
+    
+    std::string path;
+    if (directory != nullptr) {
+        const char* chars = env->GetStringUTFChars(directory, nullptr);
+        if (chars != nullptr) {
+            path = chars;
+            env->ReleaseStringUTFChars(directory, chars);
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(g_renderingMutex);
+    g_renderingState.programCache.setDirectory(path);
+}
+
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initializeOpenGLResourcesNative(
     JNIEnv* env, jobject thiz) {
@@ -475,6 +654,7 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initializeOpe
     std::lock_guard<std::mutex> lock(g_renderingMutex);
     
     try {
+        VuforiaRendering::syncWithCurrentContext();
         if (g_renderingState.initialized) {
             LOGW_RENDER("OpenGL resources already initialized");
             return JNI_TRUE;
@@ -491,17 +671,10 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initializeOpe
         LOGI_RENDER("   Renderer: %s", renderer ? renderer : "Unknown");
         
         // 创建着色器和纹理
-        if (!VuforiaRendering::createVideoBackgroundShader()) {
-            LOGE_RENDER("❌ Failed to create video background shader");
-            return JNI_FALSE;
-        }
-        
-        if (!VuforiaRendering::setupVideoBackgroundTexture()) {
-            LOGE_RENDER("❌ Failed to setup video background texture");
+        if (!VuforiaRendering::createVideoBackgroundResources()) {
             return JNI_FALSE;
         }
         
-        g_renderingState.initialized = true;
         LOGI_RENDER("✅ OpenGL resources initialized successfully");
         return JNI_TRUE;
         
@@ -521,18 +694,17 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameWi
         return;
     }
 
-    // ✅ 幀率限制 (60 FPS = 16.67ms per frame)
-    static auto lastRenderTime = std::chrono::steady_clock::now();
-    auto currentTime = std::chrono::steady_clock::now();
-    auto timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(
-        currentTime - lastRenderTime).count();
-    
-    if (timeDiff < 16) {  // 限制最高 60 FPS
-        return;  // 跳過這一幀，減少渲染頻率
-    }
-    lastRenderTime = currentTime;
+    // 視頻模式切換在引擎控制線程上進行，不佔用 g_renderingMutex
+    VuforiaWrapper::FrameLatencyTracker& latencyTracker = VuforiaWrapper::getInstance().getLatencyTracker();
+
+    // 延遲打點：本幀在函數結束時結算，onDrawFrame 返回後即 swap
+    latencyTracker.beginFrame();
+
+    // 只由 GLSurfaceView 的 GL 線程調用；幀率由它在 renderFrameSafely 中等待的 vsync 節拍決定，這裡不再限速
     
     try {
+        const auto frameStart = std::chrono::steady_clock::now();
+        
         // 獲取Vuforia引擎
         VuEngine* engine = VuforiaWrapper::getInstance().getEngine();
         if (engine == nullptr) {
@@ -543,14 +715,18 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameWi
         VuState* state = nullptr;
         VuResult result = vuEngineAcquireLatestState(engine, &state);
         if (result != VU_SUCCESS || state == nullptr) {
+            latencyTracker.discardFrame();
             return;
         }
+        latencyTracker.stamp(VuforiaWrapper::LatencyStage::STATE_ACQUIRED);
+        latencyTracker.stampCapture(state);
         
         // 獲取渲染狀態
         VuRenderState renderState;
         result = vuStateGetRenderState(state, &renderState);
         if (result != VU_SUCCESS) {
             vuStateRelease(state);
+            latencyTracker.discardFrame();
             return;
         }
         
@@ -582,6 +758,8 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameWi
                     state,
                     &vbData
                 );
+                // Vuforia 更新紋理時會改動紋理綁定，跟蹤記錄不再可信
+                g_renderingState.glState.invalidateTextures();
                 
                 if (updateResult == VU_SUCCESS) {
                     LOGD_RENDER("✅ Video background texture updated successfully");
@@ -592,10 +770,14 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameWi
             
             // 渲染視頻背景（無論紋理更新是否成功都嘗試渲染）
             VuforiaRendering::renderVideoBackgroundWithProperShader(renderState);
+            latencyTracker.stamp(VuforiaWrapper::LatencyStage::BACKGROUND);
+            VuforiaWrapper::getInstance().recordFrameProcessingTime(
+                std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
         }
         
         // 釋放狀態
         vuStateRelease(state);
+        latencyTracker.endFrame();
         
     } catch (const std::exception& e) {
         LOGE_RENDER("❌ Exception in renderFrameWithVideoBackgroundNative: %s", e.what());
@@ -604,6 +786,47 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameWi
     }
 }
 
+// ==================== 幀節拍 ====================
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_waitForNextFrameNative(
+    JNIEnv* env, jobject thiz) {
+    
+    // vsync 來源由 startRenderingLoop 啟動、stopRenderingLoop / 引擎清理時停止；
+    // 停止後立即返回 false，不在這裡重新啟動
+    VuforiaWrapper::FrameScheduler& scheduler = VuforiaWrapper::getInstance().getFrameScheduler();
+    int64_t frameTimeNs = 0;
+    return scheduler.waitForNextFrame(frameTimeNs) ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetFrameRateNative(
+    JNIEnv* env, jobject thiz, jint fps) {
+    
+    VuforiaWrapper::getInstance().getFrameScheduler().setTargetFrameRate(static_cast<int>(fps));
+}
+
+extern "C" JNIEXPORT jintArray JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getFrameTimeHistogramNative(
+    JNIEnv* env, jobject thiz) {
+    
+    using VuforiaWrapper::FrameScheduler;
+    uint32_t counts[FrameScheduler::BUCKET_COUNT];
+    VuforiaWrapper::getInstance().getFrameScheduler().getHistogram(counts);
+    
+    jint values[FrameScheduler::BUCKET_COUNT];
+    for (size_t i = 0; i < FrameScheduler::BUCKET_COUNT; ++i) {
+        values[i] = static_cast<jint>(counts[i]);
+    }
+    
+    const jsize length = static_cast<jsize>(FrameScheduler::BUCKET_COUNT);
+    jintArray result = env->NewIntArray(length);
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, length, values);
+    }
+    return result;
+}
+
 // ==================== 其他JNI实现 ====================
 
 
@@ -625,10 +848,18 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_debugRenderSt
     
     LOGD_RENDER("=== Rendering State Debug ===");
     LOGD_RENDER("Initialized: %s", g_renderingState.initialized ? "Yes" : "No");  // ✅ 修正：直接使用變數名
-    LOGD_RENDER("Shader: %u", g_renderingState.videoBackgroundShaderProgram);  // ✅ 修正：直接使用變數名
+    LOGD_RENDER("Shader: %u (%zu attributes, %zu uniforms)", g_renderingState.videoBackgroundShader.getId(),
+                g_renderingState.videoBackgroundShader.getAttributeCount(),
+                g_renderingState.videoBackgroundShader.getUniformCount());
     LOGD_RENDER("Texture: %u", g_renderingState.videoBackgroundTextureId);  // ✅ 修正：直接使用變數名
     LOGD_RENDER("VBO: %u", g_renderingState.videoBackgroundVBO);  // ✅ 修正：直接使用變數名
     LOGD_RENDER("VAO: %u", g_renderingState.videoBackgroundVAO);  // ✅ 修正：直接使用變數名
+    LOGD_RENDER("IBO: %u", g_renderingState.videoBackgroundIBO);
+    LOGD_RENDER("Mesh: %d vertices, %d indices, %ld uploads",
+                g_renderingState.meshVertexCount, g_renderingState.meshIndexCount,
+                g_renderingState.meshUploadCount);
+    LOGD_RENDER("GL State: %s", g_renderingState.glState.getStatus().c_str());
+    LOGD_RENDER("Program Cache: %s", g_renderingState.programCache.getStatus().c_str());
     LOGD_RENDER("FPS: %.2f", g_renderingState.currentFPS);  // ✅ 修正：直接使用變數名
     LOGD_RENDER("Frames: %ld", g_renderingState.totalFrameCount);  // ✅ 修正：直接使用變數名
 }
@@ -700,6 +931,10 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_cleanupOpenGL
     LOGI_RENDER("🧹 cleanupOpenGLResourcesNative called");
     
     try {
+        {
+            std::lock_guard<std::mutex> lock(g_renderingMutex);
+            VuforiaRendering::releaseVideoBackgroundResources(false);
+        }
         VuforiaWrapper::getInstance().cleanupOpenGLResources();
         LOGI_RENDER("✅ OpenGL resources cleaned up successfully");
     } catch (const std::exception& e) {
@@ -717,6 +952,11 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getOpenGLInfo
     
     try {
         std::string info = "OpenGL ES 3.0 - Vuforia Rendering Module";
+        {
+            std::lock_guard<std::mutex> lock(g_renderingMutex);
+            info += "\nGL State: " + g_renderingState.glState.getStatus();
+            info += "\nProgram Cache: " + g_renderingState.programCache.getStatus();
+        }
         return env->NewStringUTF(info.c_str());
     } catch (const std::exception& e) {
         LOGE_RENDER("❌ Error in getOpenGLInfoNative: %s", e.what());
@@ -870,19 +1110,36 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_onSurfaceCrea
     LOGI_RENDER("🖼️ onSurfaceCreatedNative called: %dx%d", width, height);
     
     try {
-        // ✅ 新增：避免重複初始化
+        bool contextChanged = false;
+        {
+            // 新上下文中舊的句柄已失效；無論是否變化，GL 狀態都不再可知
+            std::lock_guard<std::mutex> lock(g_renderingMutex);
+            contextChanged = VuforiaRendering::syncWithCurrentContext();
+            if (!contextChanged) {
+                g_renderingState.glState.reset();
+            }
+            g_renderingState.viewportWidth = static_cast<int>(width);
+            g_renderingState.viewportHeight = static_cast<int>(height);
+        }
+        
+        // ✅ 新增：避免重複初始化（上下文重建後必須重新初始化）
         static bool surfaceInitialized = false;
-        if (surfaceInitialized) {
+        if (surfaceInitialized && !contextChanged) {
             LOGW_RENDER("⚠️ Surface already initialized, skipping duplicate initialization");
             return;
         }
         
         VuforiaWrapper::getInstance().onSurfaceCreated(static_cast<int>(width), static_cast<int>(height));
         
-        if (!g_renderingState.initialized) {
-            if (VuforiaWrapper::getInstance().initializeOpenGLResources()) {
-                LOGI_RENDER("✅ OpenGL resources initialized successfully");
-                g_renderingState.initialized = true;
+        VuforiaWrapper::getInstance().initializeOpenGLResources();
+        
+        {
+            // 上下文變化時 syncWithCurrentContext 已釋放著色器、紋理和網格，在新上下文中重建
+            std::lock_guard<std::mutex> lock(g_renderingMutex);
+            if (!g_renderingState.initialized) {
+                if (VuforiaRendering::createVideoBackgroundResources()) {
+                    LOGI_RENDER("✅ OpenGL resources initialized successfully");
+                }
             }
         }
         
@@ -930,6 +1187,11 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_onSurfaceChan
     try {
         // 更新视口设置
         glViewport(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+        {
+            std::lock_guard<std::mutex> lock(g_renderingMutex);
+            g_renderingState.viewportWidth = static_cast<int>(width);
+            g_renderingState.viewportHeight = static_cast<int>(height);
+        }
         
         // 通知Wrapper surface尺寸变化
         VuforiaWrapper::getInstance().onSurfaceChanged(static_cast<int>(width), static_cast<int>(height));
@@ -1201,3 +1463,73 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_startImageTra
     return JNI_TRUE;
 }
 
+// ==================== Native 方法註冊表 ====================
+// 由 JNI_OnLoad 通過 RegisterNatives 綁定；新增 native 方法時需同步加入此表
+
+namespace VuforiaWrapper {
+
+    bool registerRenderingNatives(JNIEnv* env, jclass coreManagerClass) {
+        static const JNINativeMethod kRenderingMethods[] = {
+            {"setShaderCacheDirectoryNative", "(Ljava/lang/String;)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setShaderCacheDirectoryNative)},
+            {"initializeOpenGLResourcesNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initializeOpenGLResourcesNative)},
+            {"renderFrameWithVideoBackgroundNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameWithVideoBackgroundNative)},
+            {"waitForNextFrameNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_waitForNextFrameNative)},
+            {"setTargetFrameRateNative", "(I)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetFrameRateNative)},
+            {"getFrameTimeHistogramNative", "()[I",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getFrameTimeHistogramNative)},
+            {"stopRenderingLoopNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_stopRenderingLoopNative)},
+            {"startRenderingLoopNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_startRenderingLoopNative)},
+            {"isRenderingActiveNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_isRenderingActiveNative)},
+            {"setupVideoBackgroundRenderingNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setupVideoBackgroundRenderingNative)},
+            {"validateRenderingSetupNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_validateRenderingSetupNative)},
+            {"startCameraNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_startCameraNative)},
+            {"stopCameraNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_stopCameraNative)},
+            {"isCameraActiveNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_isCameraActiveNative)},
+            {"setSurfaceNative", "(Ljava/lang/Object;)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setSurfaceNative)},
+            {"onSurfaceCreatedNative", "(II)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_onSurfaceCreatedNative)},
+            {"onSurfaceDestroyedNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_onSurfaceDestroyedNative)},
+            {"onSurfaceChangedNative", "(II)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_onSurfaceChangedNative)},
+            {"isVuforiaEngineRunningNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_isVuforiaEngineRunningNative)},
+            {"pauseVuforiaEngineNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_pauseVuforiaEngineNative)},
+            {"resumeVuforiaEngineNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_resumeVuforiaEngineNative)},
+            {"startVuforiaEngineNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_startVuforiaEngineNative)},
+            {"stopVuforiaEngineNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_stopVuforiaEngineNative)},
+            {"getEngineStatusDetailNative", "()Ljava/lang/String;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getEngineStatusDetailNative)},
+            {"getMemoryUsageNative", "()Ljava/lang/String;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getMemoryUsageNative)},
+            {"stopRenderingNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_stopRenderingNative)},
+            {"initImageTargetDatabaseNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initImageTargetDatabaseNative)},
+            {"startImageTrackingNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_startImageTrackingNative)},
+        };
+
+        return registerNativeMethods(env, coreManagerClass, kRenderingMethods,
+                                     sizeof(kRenderingMethods) / sizeof(kRenderingMethods[0]),
+                                     "VuforiaCoreManager (rendering)");
+    }
+}
@@ -11,6 +11,7 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <queue>
 #include <chrono>
 #include <unordered_map>
@@ -20,18 +21,20 @@
 #include <GLES3/gl3.h>       // OpenGL ES 3.0   
 #include <EGL/egl.h>
 #include "VuforiaEngine/VuforiaEngine.h"
+#include "ImageConversion.h"
+#include "FrameMailbox.h"
+#include "TrackingTypes.h"
+#include "TargetEventManager.h"
+#include "FrameArena.h"
+#include "LatencyTracker.h"
+#include "VideoModeGovernor.h"
+#include "PoseExtrapolator.h"
+#include "FrameScheduler.h"
+#include "WorkerThread.h"
 #ifndef GL_TEXTURE_EXTERNAL_OES
 #define GL_TEXTURE_EXTERNAL_OES 0x8D65
 #endif
-// ==================== 日誌宏定義 ====================
-#ifdef LOG_TAG
-#undef LOG_TAG
-#endif
-#define LOG_TAG "VuforiaWrapper"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+#include "WrapperLog.h"
 
 // ==================== ✅ 全域變數聲明（不是定義！）====================
 // 這些實際定義在 vuforia_wrapper.cpp 中
@@ -61,23 +64,6 @@ void errorCallback(const char* message, void* clientData);
         LOGD("%s succeeded", (operation)); \
     } while(0)
 
-// ==================== 矩陣工具函數 ====================
-namespace VuforiaWrapper {
-    // 手動設置單位矩陣的工具函數
-    inline void setIdentityMatrix(VuMatrix44F& matrix) {
-        memset(&matrix, 0, sizeof(VuMatrix44F));
-        matrix.data[0] = 1.0f;   // [0,0]
-        matrix.data[5] = 1.0f;   // [1,1]
-        matrix.data[10] = 1.0f;  // [2,2]
-        matrix.data[15] = 1.0f;  // [3,3]
-    }
-    
-    // 複製矩陣的工具函數
-    inline void copyMatrix(VuMatrix44F& dest, const VuMatrix44F& src) {
-        memcpy(&dest, &src, sizeof(VuMatrix44F));
-    }
-}
-
 // ==================== 常量定義 ====================
 namespace VuforiaWrapper {
     // 渲染常量
@@ -92,6 +78,14 @@ namespace VuforiaWrapper {
     static constexpr int MAX_SIMULTANEOUS_TARGETS = 10;
     static constexpr float TARGET_SCALE_FACTOR = 1.0f;
     
+    // 姿態外推常量：沒有延遲統計時按曝光到顯示兩個 60Hz 刷新週期、觀察到顯示一個週期外推
+    static constexpr int64_t DEFAULT_PREDICTION_LEAD_NS = 33333333;
+    static constexpr int64_t DEFAULT_DISPLAY_LEAD_NS = 16666667;
+    static constexpr uint64_t PREDICTION_LEAD_REFRESH_FRAMES = 60;
+    
+    // 引擎控制線程錯過喚醒時的兜底輪詢間隔（毫秒）
+    static constexpr int ENGINE_CONTROL_IDLE_WAIT_MS = 100;
+    
     // 版本字符串常量
     static constexpr size_t VERSION_STRING_SIZE = 256;
 }
@@ -99,42 +93,96 @@ namespace VuforiaWrapper {
 // ==================== 數據結構定義 ====================
 namespace VuforiaWrapper {
     
-    // Target 檢測事件
-    enum class TargetEventType {
-        TARGET_FOUND = 0,
-        TARGET_TRACKING = 1,
-        TARGET_LOST = 2,
-        TARGET_EXTENDED_TRACKING = 3
-    };
-    
-    // Target 事件數據
-    struct TargetEvent {
-        std::string targetName;
-        TargetEventType eventType;
-        VuMatrix44F poseMatrix;
-        std::chrono::steady_clock::time_point timestamp;
-        float confidence;
-        
-        TargetEvent() : eventType(TargetEventType::TARGET_LOST), confidence(0.0f) {
-            // 使用新的矩陣初始化方法
-            setIdentityMatrix(poseMatrix);
+    // VuImage 引用釋放器（配合 vuImageAcquireReference 使用）
+    struct VuImageReleaser {
+        void operator()(VuImage* image) const {
+            if (image != nullptr) {
+                vuImageRelease(image);
+            }
         }
     };
-    
+
+    // 相機圖像的引用計數視圖 - 不複製像素，只持有 Vuforia 的圖像引用
+    // 注意：持有引用期間相機緩衝區不會被回收，使用完畢應盡快釋放
+    using CameraImageRef = std::shared_ptr<VuImage>;
+
     // 相機幀數據
+    // 相機幀中已註冊格式的附加圖像（零拷貝）
+    struct CameraImageView {
+        VuImagePixelFormat format;
+        CameraImageRef image;
+        const uint8_t* buffer;
+        int32_t width;
+        int32_t height;
+        int32_t stride;
+        int32_t bufferSize;
+        
+        CameraImageView() : format(VU_IMAGE_PIXEL_FORMAT_UNKNOWN), buffer(nullptr),
+                            width(0), height(0), stride(0), bufferSize(0) {}
+    };
+    
     struct CameraFrameData {
+        // 除原生格式外最多保留的已註冊格式圖像數
+        static constexpr int MAX_EXTRA_IMAGES = 3;
+        
         int width;
         int height;
         VuImagePixelFormat format;
-        std::vector<uint8_t> imageData;
+
+        // 零拷貝圖像視圖（指向 Vuforia 相機緩衝區）
+        CameraImageRef image;
+        const uint8_t* buffer;
+        int32_t stride;
+        int32_t bufferWidth;
+        int32_t bufferHeight;
+        int32_t bufferSize;
+
+        // 通過 vuCameraControllerRegisterImageFormat 註冊的其他格式
+        CameraImageView extraImages[MAX_EXTRA_IMAGES];
+        int32_t extraImageCount;
+
         VuMatrix44F projectionMatrix;
         VuMatrix44F viewMatrix;
         int64_t timestamp;
-        
-        CameraFrameData() : width(0), height(0), format(VU_IMAGE_PIXEL_FORMAT_UNKNOWN), timestamp(0) {
+
+        // 相機內參（像素座標投影用），hasIntrinsics 為 false 時無效
+        VuCameraIntrinsics intrinsics;
+        bool hasIntrinsics;
+
+        CameraFrameData() : width(0), height(0), format(VU_IMAGE_PIXEL_FORMAT_UNKNOWN),
+                            buffer(nullptr), stride(0), bufferWidth(0), bufferHeight(0),
+                            bufferSize(0), extraImageCount(0), timestamp(0), hasIntrinsics(false) {
             // 使用新的矩陣初始化方法
             setIdentityMatrix(projectionMatrix);
             setIdentityMatrix(viewMatrix);
+            memset(&intrinsics, 0, sizeof(VuCameraIntrinsics));
+        }
+        
+        // 是否持有有效的像素數據
+        bool hasImage() const { return image != nullptr && buffer != nullptr; }
+        
+        // 建立 NV12 / NV21 平面描述；格式不符或緩衝區不足時返回 false
+        bool getYuvPlanes(ImageConversion::YuvPlanes& planes) const;
+        
+        // 查找已註冊格式的附加圖像，沒有時返回 nullptr
+        const CameraImageView* findExtraImage(VuImagePixelFormat imageFormat) const {
+            for (int32_t i = 0; i < extraImageCount; ++i) {
+                if (extraImages[i].format == imageFormat) {
+                    return &extraImages[i];
+                }
+            }
+            return nullptr;
+        }
+        
+        // 釋放圖像引用，讓相機緩衝區可以被回收
+        void releaseImage() {
+            image.reset();
+            buffer = nullptr;
+            bufferSize = 0;
+            for (int32_t i = 0; i < extraImageCount; ++i) {
+                extraImages[i] = CameraImageView();
+            }
+            extraImageCount = 0;
         }
     };
     
@@ -151,71 +199,134 @@ namespace VuforiaWrapper {
 // ==================== 核心類別前向聲明 ====================
 namespace VuforiaWrapper {
     class TargetEventManager;
+    class TargetEventDispatcher;
     class CameraFrameExtractor;
     class VuforiaEngineWrapper;
+    class LumaPyramid;
+    class LumaPyramidCache;
+    class CameraFormatRegistry;
+    struct FormatImageView;
+    class TargetBoundsTable;
+    struct CropRect;
+    struct CameraSubView;
 }
 
-// ==================== 目標事件管理器 ====================
+// ==================== 相機幀提取器 ====================
 namespace VuforiaWrapper {
-    class TargetEventManager {
+    class CameraFrameExtractor {
+    public:
+        // 相機幀郵箱：渲染線程寫入，任意線程無鎖讀取
+        using FrameMailboxType = FrameMailbox<CameraFrameData, 3>;
+        using FrameReadGuard = FrameMailboxType::ReadGuard;
+        
     private:
-        std::queue<TargetEvent> mEventQueue;
-        mutable std::mutex mQueueMutex;  // 修正：添加 mutable
-        std::unordered_map<std::string, TargetEventType> mLastEventMap;
+        FrameMailboxType mFrameMailbox;
+        std::unique_ptr<LumaPyramidCache> mLumaPyramids;  // 按需構建的亮度金字塔
         
     public:
-        TargetEventManager() = default;
-        ~TargetEventManager() = default;
+        CameraFrameExtractor();
+        ~CameraFrameExtractor();
         
-        // 線程安全的事件添加
-        void addEvent(const std::string& targetName, TargetEventType eventType, 
-                     const VuMatrix44F& poseMatrix, float confidence = 1.0f);
+        // 從 VuState 提取相機幀數據（只由渲染線程調用，永不阻塞）
+        bool extractFrameData(const VuState* state);
         
-        // 批量處理事件（在主線程中調用）
-        void processEvents(JNIEnv* env, jobject callback);
+        // 無拷貝讀取最新幀；序號不大於 lastSeenSequence 時返回空守衛
+        FrameReadGuard acquireLatestFrame(uint64_t lastSeenSequence = 0) const {
+            return mFrameMailbox.acquireLatest(lastSeenSequence);
+        }
         
-        // 清空事件隊列
-        void clearEvents();
+        // 獲取最新幀數據的拷貝（線程安全，圖像本身仍是共享引用）
+        bool getLatestFrame(CameraFrameData& frameData);
         
-        // 獲取隊列大小
-        size_t getEventCount() const;
+        // 檢查是否有新幀可用
+        bool isFrameAvailable() const { return mFrameMailbox.hasFrame(); }
+        
+        // 最新幀序號，讀者可用來跳過已處理的幀
+        uint64_t getLatestFrameSequence() const { return mFrameMailbox.latestSequence(); }
+        
+        // 因讀者佔用全部槽位而丟棄的幀數
+        uint64_t getDroppedFrameCount() const { return mFrameMailbox.getDroppedFrameCount(); }
+        
+        // 亮度金字塔層數（包含原始分辨率層），0 表示停用（默認）
+        void setLumaPyramidLevels(int levels);
+        int getLumaPyramidLevels() const;
+        
+        /**
+         * 取得指定幀的亮度金字塔，同一幀的所有消費者共享同一份結果
+         * @param frameData 通過 acquireLatestFrame / getLatestFrame 取得的幀
+         * @return 停用或幀格式不是 NV12 / NV21 / GRAYSCALE 時返回 nullptr
+         */
+        std::shared_ptr<const LumaPyramid> getLumaPyramid(const CameraFrameData& frameData);
+        
+        // 取得最新幀的亮度金字塔（金字塔自身持有相機圖像引用）
+        std::shared_ptr<const LumaPyramid> getLatestLumaPyramid();
+        
+        // 釋放持有的圖像引用（必須在引擎銷毀前調用）
+        void reset();
         
     private:
-        // 檢查事件是否需要觸發（避免重複事件）
-        bool shouldTriggerEvent(const std::string& targetName, TargetEventType eventType);
+        // 提取圖像數據 - 修正參數類型
+        bool extractImageData(const VuCameraFrame* cameraFrame, CameraFrameData& frameData);
         
-        // 調用 Java 回調方法
-        void callJavaCallback(JNIEnv* env, jobject callback, const TargetEvent& event);
+        // 提取渲染矩陣
+        bool extractRenderMatrices(const VuState* state, CameraFrameData& frameData);
     };
 }
 
-// ==================== 相機幀提取器 ====================
+// ==================== Java 相機幀租借表 ====================
 namespace VuforiaWrapper {
-    class CameraFrameExtractor {
-    private:
-        CameraFrameData mLatestFrame;
-        mutable std::mutex mFrameMutex;  // 修正：添加 mutable
-        bool mFrameAvailable;
+    // 租借中幀的描述；buffer 在 release 之前保持有效
+    struct CameraFrameLeaseInfo {
+        const uint8_t* buffer;
+        size_t bufferSize;
+        int32_t width;
+        int32_t height;
+        int32_t stride;
+        int32_t format;
+        int64_t timestamp;
+        uint64_t sequence;
         
+        CameraFrameLeaseInfo() : buffer(nullptr), bufferSize(0), width(0), height(0),
+                                 stride(0), format(0), timestamp(0), sequence(0) {}
+    };
+    
+    // 把郵箱槽位借給 Java 層（DirectByteBuffer），直到 Java 顯式歸還
+    // 只由 Java 線程調用，渲染線程不經過這裡
+    class CameraFrameLeaseTable {
     public:
-        CameraFrameExtractor() : mFrameAvailable(false) {}
-        ~CameraFrameExtractor() = default;
+        // 郵箱共 3 個槽位，保留一個給生產者寫入、一個給已發佈幀
+        static constexpr int MAX_LEASES = 2;
         
-        // 從 VuState 提取相機幀數據
-        bool extractFrameData(const VuState* state);
+        CameraFrameLeaseTable() : mGeneration(0) {}
         
-        // 獲取最新幀數據（線程安全）
-        bool getLatestFrame(CameraFrameData& frameData);
+        /**
+         * 租借最新幀
+         * @return 租借句柄；沒有比 lastSeenSequence 更新的幀或租借已滿時返回 -1
+         */
+        int acquire(const CameraFrameExtractor& extractor, uint64_t lastSeenSequence);
         
-        // 檢查是否有新幀可用
-        bool isFrameAvailable() const { return mFrameAvailable; }
+        // 查詢租借中幀的信息；句柄無效（已歸還或過期）時返回 false
+        bool getInfo(int handle, CameraFrameLeaseInfo& info) const;
+        
+        // 歸還租借，之後 Java 端的 ByteBuffer 不可再讀取
+        bool release(int handle);
+        
+        // 歸還所有租借（引擎清理時調用）
+        void releaseAll();
+        
+        int getActiveLeaseCount() const;
         
     private:
-        // 提取圖像數據 - 修正參數類型
-        bool extractImageData(const VuCameraFrame* cameraFrame, CameraFrameData& frameData);
+        // 句柄 = (代數 << 4) | 槽位，防止重複歸還誤傷新的租借
+        static int makeHandle(uint32_t generation, int index) {
+            return static_cast<int>(((generation & 0x7FFFFFu) << 4) | static_cast<uint32_t>(index));
+        }
+        const CameraFrameExtractor::FrameReadGuard* findLease(int handle) const;
         
-        // 提取渲染矩陣
-        bool extractRenderMatrices(const VuState* state, CameraFrameData& frameData);
+        mutable std::mutex mMutex;
+        CameraFrameExtractor::FrameReadGuard mLeases[MAX_LEASES];
+        int mHandles[MAX_LEASES] = {-1, -1};
+        uint32_t mGeneration;
     };
 }
 
@@ -244,7 +355,38 @@ namespace VuforiaWrapper {
         
         // 事件和數據管理
         std::unique_ptr<TargetEventManager> mEventManager;
+        std::unique_ptr<TargetEventDispatcher> mEventDispatcher;  // 必須在 mEventManager 之前析構
         std::unique_ptr<CameraFrameExtractor> mFrameExtractor;
+        CameraFrameLeaseTable mCameraFrameLeases;  // Java 端租借中的相機幀
+        std::unique_ptr<CameraFormatRegistry> mFormatRegistry;  // 消費者聲明的像素格式
+        std::unique_ptr<TargetBoundsTable> mTargetBounds;       // 目標姿態與包圍盒（ROI 裁剪用）
+        
+        // 每幀熱路徑資源 - 跨幀重用，幀結束時 reset
+        FrameArena mFrameArena;
+        VuObservationList* mObservationList;
+        uint64_t mArenaFrameCount;
+        uint64_t mFrameAllocationViolations;  // 預熱後仍發生堆分配的幀數
+        
+        // 相機到畫面延遲統計
+        FrameLatencyTracker mLatencyTracker;
+        
+        // 渲染循環的 vsync 節拍
+        FrameScheduler mFrameScheduler;
+        
+        // 根據幀處理時間切換相機視頻模式
+        VideoModeGovernor mVideoModeGovernor;
+        // 在渲染線程之外重啟引擎套用視頻模式切換（只取 mEngineMutex）
+        std::unique_ptr<WorkerThread> mControlThread;
+        
+        // 把姿態外推到預計顯示時間（只由渲染線程訪問）
+        PoseExtrapolator mPoseExtrapolator;
+        int64_t mPredictionLeadNs;            // 曝光到顯示的預計時間（END_TO_END p50），按延遲統計定期刷新
+        int64_t mDisplayLeadNs;               // 沒有曝光時間戳時：觀察結果到顯示的預計時間
+        uint64_t mPredictionLeadFrames;       // 距上次刷新的幀數
+        
+        // 每幀發佈的追蹤快照：讀者計數保護的多緩衝，以原子索引切換發佈，讀取不需要 mEngineMutex
+        FrameMailbox<TrackingSnapshot, TRACKING_SNAPSHOT_SLOTS> mTrackingSnapshots;
+        TrackingSnapshot* mPendingSnapshot;   // 本幀正在填寫的快照，沒有空閒槽位時為 nullptr
         
         // JNI 相關
         JavaVM* mJVM;
@@ -336,7 +478,11 @@ namespace VuforiaWrapper {
         // ==================== 相機控制 ====================
         bool startCamera();
         void stopCamera();
-        bool setCameraVideoMode(VuCameraVideoModePreset preset);
+        /**
+         * 停止引擎、設置視頻模式並重新啟動；新模式無法啟動時回滾
+         * @return 只有 REJECTED 表示模式本身不可用
+         */
+        VideoModeSwitchResult setCameraVideoMode(VuCameraVideoModePreset preset);
         bool setCameraFocusMode(VuCameraFocusMode focusMode);
         
         // ==================== Image Target 管理 ====================
@@ -361,7 +507,78 @@ namespace VuforiaWrapper {
         
         // ==================== 數據獲取 ====================
         bool getCameraFrame(CameraFrameData& frameData);
+        CameraFrameExtractor::FrameReadGuard acquireCameraFrame(uint64_t lastSeenSequence = 0) const;
+        std::shared_ptr<const LumaPyramid> getCameraLumaPyramid();
+        uint64_t getLatestCameraFrameSequence() const;
+        int leaseCameraFrame(uint64_t lastSeenSequence);
+        CameraFrameLeaseTable& getCameraFrameLeases() { return mCameraFrameLeases; }
+        FrameLatencyTracker& getLatencyTracker() { return mLatencyTracker; }
+        FrameScheduler& getFrameScheduler() { return mFrameScheduler; }
+        VideoModeGovernor& getVideoModeGovernor() { return mVideoModeGovernor; }
+        TargetEventManager* getEventManager() { return mEventManager.get(); }
+        
+        // 停用後姿態流輸出最新觀察到的姿態（渲染線程在下一個樣本生效）
+        void setPoseExtrapolationEnabled(bool enabled) { mPoseExtrapolator.setEnabled(enabled); }
+        
+        /**
+         * 記錄一幀的處理時間（渲染線程）
+         * 調節器決定切換視頻模式時喚醒引擎控制線程，渲染線程不等待引擎重啟
+         */
+        void recordFrameProcessingTime(float processingMs);
+        
+        /**
+         * 套用調節器決定的視頻模式切換（需要重啟引擎）
+         * 在引擎控制線程上調用，只取 mEngineMutex，不能在渲染線程或持有 g_renderingMutex 時調用
+         * @return 本次進行了切換返回 true
+         */
+        bool applyPendingVideoMode();
+        void setCameraLumaPyramidLevels(int levels);
+        
+        /**
+         * 聲明 / 撤銷對某個相機像素格式的需求
+         * 只有被聲明的格式才會在相機控制器註冊，下一幀生效
+         * @param format VuImagePixelFormat 值
+         * @return 格式無效時返回 false
+         */
+        bool requestCameraFormat(VuImagePixelFormat format);
+        void releaseCameraFormat(VuImagePixelFormat format);
+        
+        /**
+         * 取得最新相機幀的指定格式圖像
+         * 相機沒有提供該格式時從 NV12 / NV21 轉換，同一幀只轉換一次
+         * @param format 需要的像素格式（應先 requestCameraFormat）
+         * @param view 輸出圖像視圖，keepAlive 持有期間數據有效
+         * @return 沒有幀或無法提供該格式時返回 false
+         */
+        bool getCameraImage(VuImagePixelFormat format, FormatImageView& view);
+        
+        /**
+         * 目標在最新相機幀中的裁剪矩形（包圍盒投影加邊距）
+         * @param targetName 目標名稱
+         * @param padding 邊距，相對矩形尺寸的比例
+         * @param rect 輸出矩形（相機圖像像素座標）
+         * @return 目標未被追蹤、不在畫面內或本幀的觀察結果尚未寫入（與最新幀不同屬一幀）時返回 false
+         */
+        bool getTargetCropRect(const std::string& targetName, float padding, CropRect& rect);
+        
+        /**
+         * 最新相機幀中目標區域的帶步長子視圖（不複製像素）
+         * @return 目標未被追蹤、不在畫面內、與最新幀不同屬一幀或幀格式不支持時返回 false
+         */
+        bool getTargetSubView(const std::string& targetName, float padding, CameraSubView& view);
+        
+        // ==================== 追蹤快照（任意線程，不加鎖） ====================
+        using TrackingSnapshotGuard = FrameMailbox<TrackingSnapshot, TRACKING_SNAPSHOT_SLOTS>::ReadGuard;
+        
+        /**
+         * 取得最新一幀的追蹤快照；守衛持有期間內容不變，應盡快釋放
+         * @return 尚無快照時返回空守衛
+         */
+        TrackingSnapshotGuard acquireTrackingSnapshot() const { return mTrackingSnapshots.acquireLatest(); }
+        
+        // 最新快照中正在追蹤的目標（eventType 為 FOUND 或 EXTENDED_TRACKING）
         std::vector<TargetEvent> getDetectedTargets();
+        // 最新快照的相機矩陣，尚無快照時返回單位矩陣
         VuMatrix44F getProjectionMatrix() const;
         VuMatrix44F getViewMatrix() const;
         
@@ -533,6 +750,8 @@ namespace VuforiaWrapper {
         // ==================== 內部處理方法 ====================
         void processVuforiaState(const VuState* state);
         void extractTargetObservations(const VuState* state);
+        void publishTrackingSnapshot(const VuState* state);
+        void checkFrameAllocations(uint64_t allocationCount);
         void updateCameraFrame(const VuState* state);
         
         // ==================== 資源管理 ====================
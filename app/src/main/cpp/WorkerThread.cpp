@@ -0,0 +1,92 @@
+// ==================== WorkerThread.cpp ====================
+// 由 notify() 喚醒的專用工作線程
+
+#include "WorkerThread.h"
+#include "WrapperLog.h"
+#include <chrono>
+
+namespace VuforiaWrapper {
+
+    WorkerThread::WorkerThread(const char* name, int idleWaitMs, Callbacks callbacks)
+        : mName(name)
+        , mIdleWaitMs(idleWaitMs)
+        , mCallbacks(std::move(callbacks))
+        , mRunning(false)
+        , mStopRequested(false)
+        , mWakePending(false) {
+    }
+
+    WorkerThread::~WorkerThread() {
+        stop();
+    }
+
+    bool WorkerThread::start() {
+        std::lock_guard<std::mutex> lifecycle(mLifecycleMutex);
+        if (mThread.joinable()) {
+            return true;
+        }
+
+        mStopRequested.store(false, std::memory_order_release);
+        try {
+            mThread = std::thread(&WorkerThread::threadMain, this);
+        } catch (const std::exception& e) {
+            LOGE("❌ Failed to start %s: %s", mName.c_str(), e.what());
+            return false;
+        }
+        return true;
+    }
+
+    void WorkerThread::stop() {
+        std::lock_guard<std::mutex> lifecycle(mLifecycleMutex);
+        if (!mThread.joinable()) {
+            return;
+        }
+        mStopRequested.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mWakePending.store(true, std::memory_order_release);
+        }
+        mWakeCondition.notify_one();
+        mThread.join();
+        LOGI("%s stopped", mName.c_str());
+    }
+
+    void WorkerThread::notify() {
+        // 不取 mWakeMutex：渲染線程永遠不等待工作線程
+        if (!mWakePending.exchange(true, std::memory_order_acq_rel)) {
+            mWakeCondition.notify_one();
+        }
+    }
+
+    void WorkerThread::threadMain() {
+        if (mCallbacks.onStart && !mCallbacks.onStart()) {
+            return;
+        }
+        mRunning.store(true, std::memory_order_release);
+        LOGI("✅ %s started", mName.c_str());
+
+        while (!mStopRequested.load(std::memory_order_acquire)) {
+            {
+                std::unique_lock<std::mutex> lock(mWakeMutex);
+                mWakeCondition.wait_for(lock, std::chrono::milliseconds(mIdleWaitMs), [this] {
+                    return mWakePending.load(std::memory_order_acquire);
+                });
+            }
+            mWakePending.store(false, std::memory_order_release);
+            if (mStopRequested.load(std::memory_order_acquire)) {
+                break;
+            }
+
+            try {
+                mCallbacks.work();
+            } catch (const std::exception& e) {
+                LOGE("❌ Exception on %s: %s", mName.c_str(), e.what());
+            }
+        }
+
+        if (mCallbacks.onExit) {
+            mCallbacks.onExit();
+        }
+        mRunning.store(false, std::memory_order_release);
+    }
+}
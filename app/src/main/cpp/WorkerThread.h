@@ -0,0 +1,64 @@
+#ifndef WORKER_THREAD_H
+#define WORKER_THREAD_H
+
+// ==================== 可喚醒的工作線程 ====================
+// 渲染線程只調用 notify()（不加鎖、不阻塞、不分配），專用線程被喚醒後執行工作函數。
+// 引擎控制線程（相機視頻模式切換需要重啟引擎）與目標事件分發線程共用這個實現：
+//  - notify 只設置標誌並 notify_one；錯過的喚醒由 idleWaitMs 的兜底超時補上，
+//    超時後工作函數同樣會被調用，因此沒有待處理工作時必須能快速返回
+//  - start / stop 由 mLifecycleMutex 串行化，可以從任意線程重複調用
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace VuforiaWrapper {
+
+    class WorkerThread {
+    public:
+        struct Callbacks {
+            std::function<bool()> onStart;   // 可選，在線程上最先調用；返回 false 時線程直接退出
+            std::function<void()> work;      // 每次喚醒（或兜底超時）後調用
+            std::function<void()> onExit;    // 可選，onStart 成功後線程退出前調用
+        };
+
+        WorkerThread(const char* name, int idleWaitMs, Callbacks callbacks);
+        ~WorkerThread();
+
+        WorkerThread(const WorkerThread&) = delete;
+        WorkerThread& operator=(const WorkerThread&) = delete;
+
+        // 啟動線程（已啟動時直接返回 true）
+        bool start();
+
+        // 停止並等待線程退出；調用者不能持有工作函數需要的鎖
+        void stop();
+
+        // onStart 成功後到線程退出前為 true
+        bool isRunning() const { return mRunning.load(std::memory_order_acquire); }
+
+        // 有待處理的工作（渲染線程調用）
+        void notify();
+
+    private:
+        void threadMain();
+
+        const std::string mName;
+        const int mIdleWaitMs;
+        Callbacks mCallbacks;
+
+        std::mutex mLifecycleMutex;
+        std::thread mThread;
+        std::atomic<bool> mRunning;
+        std::atomic<bool> mStopRequested;
+
+        std::atomic<bool> mWakePending;
+        std::mutex mWakeMutex;
+        std::condition_variable mWakeCondition;
+    };
+}
+
+#endif // WORKER_THREAD_H
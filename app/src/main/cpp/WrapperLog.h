@@ -0,0 +1,29 @@
+#ifndef WRAPPER_LOG_H
+#define WRAPPER_LOG_H
+
+// ==================== 日誌宏定義 ====================
+// Android 上寫入 logcat；主機端測試 / 基準構建時寫到 stderr，
+// 讓不依賴 JNI / Vuforia 的模塊可以脫離 NDK 單獨編譯
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "VuforiaWrapper"
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+#else
+#include <cstdio>
+#define WRAPPER_LOG_HOST(level, ...) \
+    do { fprintf(stderr, "%s/%s: ", level, LOG_TAG); fprintf(stderr, __VA_ARGS__); fputc('\n', stderr); } while (0)
+#define LOGI(...) WRAPPER_LOG_HOST("I", __VA_ARGS__)
+#define LOGE(...) WRAPPER_LOG_HOST("E", __VA_ARGS__)
+#define LOGD(...) ((void)0)
+#define LOGW(...) WRAPPER_LOG_HOST("W", __VA_ARGS__)
+#endif
+
+#endif // WRAPPER_LOG_H
@@ -0,0 +1,51 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+// ==================== 主機端測試輔助 ====================
+// 不引入測試框架：失敗時打印位置並累計，main 返回失敗數
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace TestSupport {
+
+    inline int& failureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline int finish(const char* suite) {
+        if (failureCount() == 0) {
+            printf("✅ %s: all checks passed\n", suite);
+            return 0;
+        }
+        printf("❌ %s: %d check(s) failed\n", suite, failureCount());
+        return 1;
+    }
+
+    inline int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++TestSupport::failureCount(); \
+        } \
+    } while (0)
+
+#define CHECK_MSG(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s: ", __FILE__, __LINE__, #condition); \
+            fprintf(stderr, __VA_ARGS__); \
+            fputc('\n', stderr); \
+            ++TestSupport::failureCount(); \
+        } \
+    } while (0)
+
+#endif // TEST_SUPPORT_H
@@ -0,0 +1,354 @@
+// ==================== concurrency_bench.cpp ====================
+// 幀交換的爭用基準：無鎖實現與原先的 mutex 版本對比
+//  - FrameMailbox：1 個生產者、N 個讀者，對比 mutex 保護的單幀拷貝
+//  - SpscRing：目標事件從渲染線程到分發線程，對比 std::queue + mutex 的舊事件隊列
+// 讀者同時校驗每一幀的內容，發現撕裂幀時以非零狀態退出
+
+#include "FrameMailbox.h"
+#include "SpscRing.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+using VuforiaWrapper::FrameMailbox;
+using VuforiaWrapper::SpscRing;
+
+namespace {
+
+    // 大小接近 CameraFrameData（矩陣 + 內參 + 圖像視圖），所有字段由同一序號派生
+    struct BenchFrame {
+        uint64_t sequence = 0;
+        float matrices[2][16] = {};
+        uint8_t payload[320] = {};
+
+        void fill(uint64_t value) {
+            sequence = value;
+            for (int m = 0; m < 2; ++m) {
+                for (int i = 0; i < 16; ++i) {
+                    matrices[m][i] = static_cast<float>(value + i);
+                }
+            }
+            memset(payload, static_cast<int>(value & 0xFF), sizeof(payload));
+        }
+
+        bool consistent() const {
+            const uint8_t expected = static_cast<uint8_t>(sequence & 0xFF);
+            for (uint8_t byte : payload) {
+                if (byte != expected) {
+                    return false;
+                }
+            }
+            return matrices[1][15] == static_cast<float>(sequence + 15);
+        }
+    };
+
+    // 原實現：mFrameMutex 保護單個幀，讀者在鎖內整幀拷貝
+    class MutexFrame {
+    public:
+        void publish(uint64_t sequence) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFrame.fill(sequence);
+        }
+
+        bool read(BenchFrame& out) const {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mFrame.sequence == 0) {
+                return false;
+            }
+            out = mFrame;
+            return true;
+        }
+
+    private:
+        mutable std::mutex mMutex;
+        BenchFrame mFrame;
+    };
+
+    struct LatencySummary {
+        double p50Us;
+        double p99Us;
+        double maxUs;
+    };
+
+    LatencySummary summarize(std::vector<int64_t>& samples) {
+        if (samples.empty()) {
+            return {0.0, 0.0, 0.0};
+        }
+        std::sort(samples.begin(), samples.end());
+        const auto at = [&samples](double q) {
+            return static_cast<double>(samples[static_cast<size_t>(q * (samples.size() - 1))]) / 1000.0;
+        };
+        return {at(0.5), at(0.99), static_cast<double>(samples.back()) / 1000.0};
+    }
+
+    struct ContentionResult {
+        LatencySummary publish;
+        uint64_t reads;
+        uint64_t torn;
+        uint64_t dropped;
+    };
+
+    // 生產者按固定節拍發佈 frames 幀並記錄每次發佈耗時；讀者持續讀取直到生產者結束
+    template <typename Publish, typename Read>
+    ContentionResult runContention(int readers, int frames, int64_t intervalNs, Publish publish, Read read) {
+        std::atomic<bool> running(true);
+        std::atomic<uint64_t> reads(0);
+        std::atomic<uint64_t> torn(0);
+
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; ++r) {
+            threads.emplace_back([&]() {
+                uint64_t localReads = 0;
+                uint64_t localTorn = 0;
+                uint64_t lastSeen = 0;
+                while (running.load(std::memory_order_relaxed)) {
+                    int result = read(lastSeen);
+                    if (result > 0) {
+                        ++localReads;
+                    } else if (result < 0) {
+                        ++localTorn;
+                    }
+                }
+                reads.fetch_add(localReads);
+                torn.fetch_add(localTorn);
+            });
+        }
+
+        std::vector<int64_t> publishNs;
+        publishNs.reserve(static_cast<size_t>(frames));
+        uint64_t dropped = 0;
+        int64_t next = TestSupport::nowNs();
+        for (int i = 1; i <= frames; ++i) {
+            const int64_t start = TestSupport::nowNs();
+            if (!publish(static_cast<uint64_t>(i))) {
+                ++dropped;
+            }
+            publishNs.push_back(TestSupport::nowNs() - start);
+            next += intervalNs;
+            while (TestSupport::nowNs() < next) {
+                std::this_thread::yield();
+            }
+        }
+
+        running.store(false);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        return {summarize(publishNs), reads.load(), torn.load(), dropped};
+    }
+
+    void printResult(const char* name, int readers, const ContentionResult& result) {
+        printf("%-14s %7d %10.2f %10.2f %10.2f %12llu %6llu %8llu\n", name, readers,
+               result.publish.p50Us, result.publish.p99Us, result.publish.maxUs,
+               static_cast<unsigned long long>(result.reads),
+               static_cast<unsigned long long>(result.torn),
+               static_cast<unsigned long long>(result.dropped));
+    }
+
+    // 返回撕裂幀總數
+    uint64_t benchFrameMailbox(int frames, int64_t intervalNs) {
+        printf("\n== Frame exchange: 1 producer, N readers, %d frames every %.1f ms ==\n",
+               frames, static_cast<double>(intervalNs) / 1e6);
+        printf("%-14s %7s %10s %10s %10s %12s %6s %8s\n",
+               "impl", "readers", "pub p50us", "pub p99us", "pub maxus", "reads", "torn", "dropped");
+
+        uint64_t tornTotal = 0;
+        for (int readers : {1, 2, 4, 8}) {
+            FrameMailbox<BenchFrame, 3> mailbox;
+            const ContentionResult lockFree = runContention(readers, frames, intervalNs,
+                [&mailbox](uint64_t sequence) {
+                    BenchFrame* slot = mailbox.beginWrite();
+                    if (slot == nullptr) {
+                        return false;
+                    }
+                    slot->fill(sequence);
+                    mailbox.commitWrite();
+                    return true;
+                },
+                [&mailbox](uint64_t& lastSeen) {
+                    auto guard = mailbox.acquireLatest(lastSeen);
+                    if (!guard) {
+                        return 0;
+                    }
+                    lastSeen = guard.sequence();
+                    return guard->consistent() ? 1 : -1;
+                });
+            printResult("FrameMailbox", readers, lockFree);
+
+            MutexFrame mutexFrame;
+            const ContentionResult locked = runContention(readers, frames, intervalNs,
+                [&mutexFrame](uint64_t sequence) {
+                    mutexFrame.publish(sequence);
+                    return true;
+                },
+                [&mutexFrame](uint64_t& lastSeen) {
+                    BenchFrame copy;
+                    if (!mutexFrame.read(copy) || copy.sequence <= lastSeen) {
+                        return 0;
+                    }
+                    lastSeen = copy.sequence;
+                    return copy.consistent() ? 1 : -1;
+                });
+            printResult("mutex + copy", readers, locked);
+
+            tornTotal += lockFree.torn + locked.torn;
+        }
+        return tornTotal;
+    }
+
+    // ==================== 目標事件隊列 ====================
+
+    // 與 TargetEvent 相同佈局的 POD 記錄
+    struct RingEvent {
+        int32_t targetId;
+        int32_t eventType;
+        int64_t timestampNs;
+        float pose[16];
+    };
+
+    // 舊實現的事件：名稱字符串 + 時間點，std::queue 存儲，mQueueMutex 保護
+    struct LegacyEvent {
+        std::string targetName;
+        int eventType;
+        float pose[16];
+        int64_t timestampNs;
+    };
+
+    class LegacyEventQueue {
+    public:
+        void push(const char* name, int eventType, int64_t timestampNs) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            LegacyEvent event;
+            event.targetName = name;
+            event.eventType = eventType;
+            memset(event.pose, 0, sizeof(event.pose));
+            event.timestampNs = timestampNs;
+            mQueue.push(event);
+        }
+
+        // 舊的 getDetectedTargets：在鎖內把隊列搬到 vector
+        size_t drain(std::vector<LegacyEvent>& out) {
+            out.clear();
+            std::lock_guard<std::mutex> lock(mMutex);
+            while (!mQueue.empty()) {
+                out.push_back(mQueue.front());
+                mQueue.pop();
+            }
+            return out.size();
+        }
+
+    private:
+        std::mutex mMutex;
+        std::queue<LegacyEvent> mQueue;
+    };
+
+    static constexpr size_t EVENT_RING_CAPACITY = 256;
+    // 超出小字符串優化長度，與真實目標名稱一樣會觸發堆分配
+    static const char* const kTargetName = "StonesAndChips_image_target";
+
+    struct QueueResult {
+        LatencySummary push;
+        uint64_t consumed;
+        double elapsedMs;
+    };
+
+    // 生產者一次推入 burst 條事件（模擬一幀內的多個目標），消費者持續批量取出
+    template <typename Push, typename Drain>
+    QueueResult runEventQueue(int events, int burst, Push push, Drain drain) {
+        std::atomic<bool> producerDone(false);
+        uint64_t consumed = 0;
+
+        std::thread consumer([&]() {
+            for (;;) {
+                const bool done = producerDone.load(std::memory_order_acquire);
+                const size_t count = drain();
+                consumed += count;
+                if (done && count == 0) {
+                    break;
+                }
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::vector<int64_t> pushNs;
+        pushNs.reserve(static_cast<size_t>(events));
+        const int64_t begin = TestSupport::nowNs();
+        for (int i = 0; i < events; ++i) {
+            const int64_t start = TestSupport::nowNs();
+            push(i);
+            pushNs.push_back(TestSupport::nowNs() - start);
+            if ((i + 1) % burst == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producerDone.store(true, std::memory_order_release);
+        consumer.join();
+        const double elapsedMs = static_cast<double>(TestSupport::nowNs() - begin) / 1e6;
+        return {summarize(pushNs), consumed, elapsedMs};
+    }
+
+    void printQueueResult(const char* name, int burst, const QueueResult& result) {
+        printf("%-16s %6d %10.3f %10.3f %10.2f %10llu %10.2f\n", name, burst,
+               result.push.p50Us, result.push.p99Us, result.push.maxUs,
+               static_cast<unsigned long long>(result.consumed), result.elapsedMs);
+    }
+
+    void benchEventQueue(int events) {
+        printf("\n== Target events: render thread -> dispatcher, %d events ==\n", events);
+        printf("%-16s %6s %10s %10s %10s %10s %10s\n",
+               "impl", "burst", "push p50us", "push p99us", "push maxus", "consumed", "total ms");
+
+        for (int burst : {1, 4, 16}) {
+            // 與 TargetEventManager 一致：DROP_OLDEST，分發者一次取出整個環
+            SpscRing<RingEvent, EVENT_RING_CAPACITY> ring;
+            std::vector<RingEvent> batch(EVENT_RING_CAPACITY);
+            const QueueResult lockFree = runEventQueue(events, burst,
+                [&ring](int i) {
+                    RingEvent event;
+                    event.targetId = i & 7;
+                    event.eventType = i & 1;
+                    event.timestampNs = i;
+                    memset(event.pose, 0, sizeof(event.pose));
+                    ring.push(event);
+                },
+                [&ring, &batch]() { return ring.popBatch(batch.data(), batch.size()); });
+            printQueueResult("SpscRing", burst, lockFree);
+            if (ring.getOverflowCount() > 0) {
+                printf("%-16s %6s overflowed %llu event(s)\n", "", "",
+                       static_cast<unsigned long long>(ring.getOverflowCount()));
+            }
+
+            LegacyEventQueue legacy;
+            std::vector<LegacyEvent> drained;
+            drained.reserve(EVENT_RING_CAPACITY);
+            const QueueResult locked = runEventQueue(events, burst,
+                [&legacy](int i) { legacy.push(kTargetName, i & 1, i); },
+                [&legacy, &drained]() { return legacy.drain(drained); });
+            printQueueResult("queue + mutex", burst, locked);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    // 事件隊列部分推入 frames * 100 條事件
+    const int frames = argc > 1 ? std::max(1, atoi(argv[1])) : 2000;
+    // 默認以 1 ms 節拍發佈，比 30 fps 相機更密集，放大爭用
+    const int64_t intervalNs = 1000000;
+
+    const uint64_t torn = benchFrameMailbox(frames, intervalNs);
+    benchEventQueue(frames * 100);
+    if (torn != 0) {
+        printf("❌ %llu torn frame(s) observed\n", static_cast<unsigned long long>(torn));
+        return 1;
+    }
+    return 0;
+}
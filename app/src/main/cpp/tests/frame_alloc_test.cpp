@@ -0,0 +1,210 @@
+// ==================== frame_alloc_test.cpp ====================
+// 以 ENABLE_FRAME_ALLOC_CHECK 構建：用假的觀察列表驅動渲染線程每幀經過的真實模塊
+// （TargetEventManager、PoseExtrapolator、PoseStreamTable、追蹤快照、TargetBoundsTable），
+// 順序與 processVuforiaState 相同；預熱後每一幀在 FrameAllocationScope 內的堆分配次數必須為 0
+
+#include "FrameArena.h"
+#include "FrameMailbox.h"
+#include "PoseExtrapolator.h"
+#include "PoseStreamTable.h"
+#include "TargetBoundsTable.h"
+#include "TargetEventManager.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace VuforiaWrapper;
+
+namespace {
+
+    static constexpr size_t MAX_OBSERVATIONS = 24;
+    static constexpr int64_t FRAME_INTERVAL_NS = 16666667;
+
+    // 與 processVuforiaState 相同的姿態狀態 → 事件類型映射
+    TargetEventType toEventType(int32_t poseStatus) {
+        switch (poseStatus) {
+            case VU_OBSERVATION_POSE_STATUS_TRACKED:
+                return TargetEventType::TARGET_FOUND;
+            case VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED:
+                return TargetEventType::TARGET_EXTENDED_TRACKING;
+            default:
+                return TargetEventType::TARGET_LOST;
+        }
+    }
+
+    // 每個目標的狀態隔幾十幀變化一次，穩態下仍持續產生事件
+    int32_t fakePoseStatus(size_t target, uint64_t frame) {
+        switch ((frame / 20 + target) % 4) {
+            case 0:
+                return VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED;
+            case 1:
+                return VU_OBSERVATION_POSE_STATUS_LIMITED;
+            default:
+                return VU_OBSERVATION_POSE_STATUS_TRACKED;
+        }
+    }
+
+    struct FrameLoop {
+        FrameArena arena{1024};  // 故意偏小，讓預熱階段發生溢出與合併
+        TargetEventManager events;
+        PoseExtrapolator extrapolator;
+        PoseStreamTable poseStream;
+        FrameMailbox<TrackingSnapshot, TRACKING_SNAPSHOT_SLOTS> snapshots;
+        TargetBoundsTable bounds;
+        char names[MAX_OBSERVATIONS][16];  // VuState 內部的目標名稱
+        uint64_t dispatchedEvents = 0;
+
+        explicit FrameLoop(EventQueueMode mode) {
+            events.setQueuePolicy(mode, TargetEventManager::EVENT_RING_CAPACITY);
+            for (size_t i = 0; i < MAX_OBSERVATIONS; ++i) {
+                snprintf(names[i], sizeof(names[i]), "target-%zu", i);
+            }
+        }
+
+        // 一幀：觀察列表 → 事件 → 外推 → 姿態流 → 快照 → 包圍盒，分發側取出事件，幀末 reset
+        uint64_t runFrame(uint64_t frame, size_t observationCount) {
+            FrameAllocationScope scope;
+            const int64_t sampleTimeNs = static_cast<int64_t>(frame + 1) * FRAME_INTERVAL_NS;
+
+            TrackingSnapshot* snapshot = snapshots.beginWrite();
+            if (snapshot != nullptr) {
+                snapshot->targetCount = 0;
+            }
+
+            ArenaVector<TargetObservation> observations{ArenaAllocator<TargetObservation>(&arena)};
+            observations.reserve(observationCount);
+            for (size_t i = 0; i < observationCount; ++i) {
+                TargetObservation observation;
+                observation.observerId = static_cast<int32_t>(i);
+                observation.targetId = -1;
+                observation.targetName = names[i];
+                observation.poseStatus = fakePoseStatus(i, frame);
+                observation.eventType = toEventType(observation.poseStatus);
+                setIdentityMatrix(observation.poseMatrix);
+                observation.poseMatrix.data[12] = static_cast<float>(frame) * 0.001f;
+                observation.bbox.center = VuVector3F{{0.0f, 0.0f, 0.0f}};
+                observation.bbox.extent = VuVector3F{{0.1f, 0.1f, 0.0f}};
+                observation.confidence = 1.0f;
+                observations.push_back(observation);
+            }
+
+            events.addEvents(observations.data(), observations.size());
+
+            for (const TargetObservation& observation : observations) {
+                extrapolator.addSample(observation.targetId, observation.poseStatus,
+                                       observation.poseMatrix, sampleTimeNs);
+            }
+            extrapolator.predict(sampleTimeNs + 2 * FRAME_INTERVAL_NS);
+
+            for (const TargetObservation& observation : observations) {
+                VuMatrix44F predictedPose;
+                int64_t predictedTimeNs = sampleTimeNs;
+                float confidence = 0.0f;
+                if (!extrapolator.getPredicted(observation.targetId, predictedPose, predictedTimeNs, confidence)) {
+                    copyMatrix(predictedPose, observation.poseMatrix);
+                }
+                poseStream.write(observation.targetId, observation.poseStatus, predictedPose,
+                                 predictedTimeNs, frame + 1);
+            }
+            poseStream.commitFrame(frame + 1, sampleTimeNs);
+
+            if (snapshot != nullptr) {
+                for (const TargetObservation& observation : observations) {
+                    const uint32_t index = snapshot->targetCount;
+                    if (index >= TRACKING_SNAPSHOT_MAX_TARGETS) {
+                        break;
+                    }
+                    if (observation.poseStatus != VU_OBSERVATION_POSE_STATUS_TRACKED &&
+                        observation.poseStatus != VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED) {
+                        continue;
+                    }
+                    snapshot->targetIds[index] = observation.targetId;
+                    snapshot->poseStatus[index] = observation.poseStatus;
+                    memcpy(&snapshot->poses[index * 16], observation.poseMatrix.data,
+                           sizeof(observation.poseMatrix.data));
+                    snapshot->targetCount = index + 1;
+                }
+                snapshot->frameSequence = frame + 1;
+                snapshot->timestampNs = sampleTimeNs;
+                snapshots.commitWrite();
+            }
+
+            for (const TargetObservation& observation : observations) {
+                const bool tracked = observation.eventType == TargetEventType::TARGET_FOUND ||
+                                     observation.eventType == TargetEventType::TARGET_EXTENDED_TRACKING;
+                bounds.update(observation.targetId, observation.poseMatrix, observation.bbox, frame + 1, tracked);
+            }
+            bounds.commitFrame();
+
+            // 讀者與分發側（生產環境中在其他線程）：查詢快照與包圍盒，取出一批事件
+            {
+                auto latest = snapshots.acquireLatest();
+                CHECK(latest && latest->frameSequence == frame + 1);
+            }
+            TargetBoundsTable::Entry entry;
+            bounds.find(0, entry);
+            int64_t oldestNs = 0;
+            dispatchedEvents += events.takeBatch(oldestNs);
+
+            arena.reset();
+            return scope.getAllocationCount();
+        }
+    };
+
+    // 計數器本身必須能看到作用域內的分配，否則下面的斷言沒有意義
+    void testScopeCountsAllocations() {
+        CHECK(FrameAllocationScope::isEnabled());
+
+        FrameAllocationScope scope;
+        // volatile 防止編譯器把成對的 new / delete 優化掉
+        std::vector<int>* volatile heapVector = new std::vector<int>(16);
+        delete heapVector;
+        CHECK(scope.getAllocationCount() == 2);
+
+        {
+            FrameAllocationScope nested;
+            FrameArena arena(64);
+            arena.allocate(256);
+            CHECK(nested.getAllocationCount() >= 2);
+        }
+    }
+
+    void testSteadyStateFrameLoop(EventQueueMode mode) {
+        static constexpr uint64_t WARMUP_FRAMES = 60;
+        static constexpr uint64_t TOTAL_FRAMES = 600;
+
+        // 事件環與信箱約 40KB，放在堆上
+        std::unique_ptr<FrameLoop> loop(new FrameLoop(mode));
+        uint64_t steadyAllocations = 0;
+        uint64_t warmupAllocations = 0;
+        for (uint64_t frame = 0; frame < TOTAL_FRAMES; ++frame) {
+            // 預熱期間觀察數逐步增長到上限（每個目標首次出現時登記），之後在上限內波動，
+            // 不在本幀列表中的目標由姿態流與包圍盒表標記失效
+            const size_t count = frame < WARMUP_FRAMES
+                ? 1 + static_cast<size_t>(frame) * MAX_OBSERVATIONS / WARMUP_FRAMES
+                : 1 + static_cast<size_t>((frame * 7919) % MAX_OBSERVATIONS);
+            const uint64_t allocations = loop->runFrame(frame, count);
+            if (frame < WARMUP_FRAMES) {
+                warmupAllocations += allocations;
+            } else {
+                CHECK_MSG(allocations == 0, "mode %d frame %llu allocated %llu times", static_cast<int>(mode),
+                          static_cast<unsigned long long>(frame), static_cast<unsigned long long>(allocations));
+                steadyAllocations += allocations;
+            }
+        }
+
+        // 預熱確實觸發了登記與 arena 增長，穩態持續產生事件卻沒有任何分配
+        CHECK(warmupAllocations > 0);
+        CHECK(steadyAllocations == 0);
+        CHECK(loop->arena.getOverflowCount() > 0);
+        CHECK(loop->dispatchedEvents > MAX_OBSERVATIONS);
+    }
+}
+
+int main() {
+    testScopeCountsAllocations();
+    testSteadyStateFrameLoop(EventQueueMode::DROP_OLDEST);
+    testSteadyStateFrameLoop(EventQueueMode::LATEST_STATE_ONLY);
+    return TestSupport::finish("frame_alloc_test");
+}
@@ -0,0 +1,142 @@
+// ==================== frame_scheduler_test.cpp ====================
+// 主機端沒有 AChoreographer，FrameScheduler 使用 60Hz 計時器後備：
+// 穩定 60fps、30fps 抽幀、注入的停頓計為錯過，以及跨線程 start / stop
+
+#include "FrameScheduler.h"
+#include "TestSupport.h"
+#include <thread>
+#include <vector>
+
+using VuforiaWrapper::FrameScheduler;
+using VuforiaWrapper::FrameSchedulerStats;
+
+namespace {
+
+    // 連續等待 frames 幀，返回平均幀間隔（毫秒）
+    double runFrames(FrameScheduler& scheduler, int frames, int stallEvery = 0, int stallMs = 0) {
+        int64_t firstNs = 0;
+        int64_t lastNs = 0;
+        int completed = 0;
+        for (int i = 0; i < frames; ++i) {
+            int64_t frameTimeNs = 0;
+            if (!scheduler.waitForNextFrame(frameTimeNs)) {
+                continue;
+            }
+            if (completed == 0) {
+                firstNs = frameTimeNs;
+            }
+            lastNs = frameTimeNs;
+            ++completed;
+            if (stallEvery > 0 && (i + 1) % stallEvery == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(stallMs));
+            }
+        }
+        return completed > 1 ? static_cast<double>(lastNs - firstNs) / 1e6 / (completed - 1) : 0.0;
+    }
+
+    void testNotRunningReturnsImmediately() {
+        FrameScheduler scheduler;
+        const int64_t start = TestSupport::nowNs();
+        int64_t frameTimeNs = 0;
+        CHECK(!scheduler.waitForNextFrame(frameTimeNs));
+        CHECK(!scheduler.waitForNextFrame(frameTimeNs));
+        // 未啟動時不等待也不睡眠
+        CHECK(TestSupport::nowNs() - start < 5000000);
+    }
+
+    void testTimerCadence() {
+        FrameScheduler scheduler;
+        CHECK(scheduler.start());
+        CHECK(scheduler.isRunning());
+
+        // 每個 vsync 一幀：幀間隔等於計時器週期（時間戳對齊週期邊界）
+        const double everyVsyncMs = runFrames(scheduler, 30);
+        CHECK_MSG(everyVsyncMs > 15.0 && everyVsyncMs < 22.0, "every-vsync interval %.2f ms", everyVsyncMs);
+
+        // 30fps：每 2 個 vsync 一幀
+        scheduler.setTargetFrameRate(30);
+        runFrames(scheduler, 2);
+        const double thirtyMs = runFrames(scheduler, 20);
+        CHECK_MSG(thirtyMs > 31.0 && thirtyMs < 40.0, "30 fps interval %.2f ms", thirtyMs);
+
+        scheduler.setTargetFrameRate(0);
+        scheduler.resetStats();
+
+        // 每 5 幀停頓 40ms：目標 vsync 已過去，計為錯過並跳過 vsync
+        runFrames(scheduler, 25, 5, 40);
+        const FrameSchedulerStats stats = scheduler.getStats();
+        CHECK_MSG(stats.missedDeadlines >= 4, "missed %llu", static_cast<unsigned long long>(stats.missedDeadlines));
+        CHECK(stats.skippedVsyncs >= stats.missedDeadlines);
+        CHECK(!stats.choreographer);
+
+        uint32_t histogram[FrameScheduler::BUCKET_COUNT] = {};
+        scheduler.getHistogram(histogram);
+        uint32_t total = 0;
+        for (uint32_t count : histogram) {
+            total += count;
+        }
+        CHECK(total > 0);
+
+        scheduler.stop();
+        CHECK(!scheduler.isRunning());
+    }
+
+    // 停止後等待立即返回；停止會喚醒正在等待的渲染線程
+    void testStopWakesWaiter() {
+        FrameScheduler scheduler;
+        scheduler.setTargetFrameRate(1);  // 最長間隔，確保渲染線程處於等待中
+        CHECK(scheduler.start());
+        int64_t frameTimeNs = 0;
+        scheduler.waitForNextFrame(frameTimeNs);
+
+        std::atomic<bool> returned(false);
+        std::thread renderThread([&]() {
+            int64_t ignored = 0;
+            scheduler.waitForNextFrame(ignored);
+            returned.store(true);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const int64_t stopStart = TestSupport::nowNs();
+        scheduler.stop();
+        renderThread.join();
+        CHECK(returned.load());
+        CHECK(TestSupport::nowNs() - stopStart < 200000000);
+
+        const int64_t start = TestSupport::nowNs();
+        CHECK(!scheduler.waitForNextFrame(frameTimeNs));
+        CHECK(TestSupport::nowNs() - start < 5000000);
+        CHECK(!scheduler.isRunning());
+    }
+
+    // 渲染線程啟動、UI 線程停止（配合 HOST_TESTS_TSAN 檢查 mThread 沒有競爭）
+    void testConcurrentStartStop() {
+        FrameScheduler scheduler;
+        std::atomic<bool> running(true);
+        std::thread starter([&]() {
+            while (running.load()) {
+                scheduler.start();
+                int64_t ignored = 0;
+                scheduler.waitForNextFrame(ignored);
+            }
+        });
+        std::thread stopper([&]() {
+            for (int i = 0; i < 20; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(3));
+                scheduler.stop();
+            }
+        });
+        stopper.join();
+        running.store(false);
+        starter.join();
+        scheduler.stop();
+        CHECK(!scheduler.isRunning());
+    }
+}
+
+int main() {
+    testNotRunningReturnsImmediately();
+    testTimerCadence();
+    testStopWakesWaiter();
+    testConcurrentStartStop();
+    return TestSupport::finish("frame_scheduler_test");
+}
@@ -0,0 +1,80 @@
+// ==================== image_conversion_bench.cpp ====================
+// NV21 → RGB / RGBA 在常見相機分辨率下各 SIMD 等級的耗時
+
+#include "ImageConversion.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace VuforiaWrapper::ImageConversion;
+
+namespace {
+
+    double benchmarkMs(const YuvPlanes& planes, uint8_t* dst, int32_t channels, SimdLevel level, int iterations) {
+        const int32_t dstStride = planes.width * channels;
+        int64_t best = INT64_MAX;
+        for (int i = 0; i < iterations; ++i) {
+            const int64_t start = TestSupport::nowNs();
+            if (channels == 4) {
+                convertYuvToRgba(planes, dst, dstStride, level);
+            } else {
+                convertYuvToRgb(planes, dst, dstStride, level);
+            }
+            best = std::min(best, TestSupport::nowNs() - start);
+        }
+        return static_cast<double>(best) / 1e6;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 50;
+    const int32_t sizes[][2] = {{640, 480}, {1280, 720}, {1920, 1080}};
+
+    const SimdLevel detected = detectSimdLevel();
+    std::vector<SimdLevel> levels = {SimdLevel::SCALAR};
+    for (SimdLevel level : {SimdLevel::NEON, SimdLevel::SSE41, SimdLevel::AVX2}) {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        const bool compiled = level == SimdLevel::NEON;
+#elif defined(__x86_64__) || defined(__i386__)
+        const bool compiled = level != SimdLevel::NEON;
+#else
+        const bool compiled = false;
+#endif
+        if (compiled && static_cast<int>(level) <= static_cast<int>(detected)) {
+            levels.push_back(level);
+        }
+    }
+
+    printf("%-10s %-6s %-8s %10s\n", "size", "format", "level", "best ms");
+    for (const auto& size : sizes) {
+        const int32_t width = size[0];
+        const int32_t height = size[1];
+        std::vector<uint8_t> y(static_cast<size_t>(width) * height);
+        std::vector<uint8_t> uv(static_cast<size_t>(width) * (height / 2));
+        for (size_t i = 0; i < y.size(); ++i) {
+            y[i] = static_cast<uint8_t>(i * 7);
+        }
+        for (size_t i = 0; i < uv.size(); ++i) {
+            uv[i] = static_cast<uint8_t>(i * 13);
+        }
+
+        YuvPlanes planes;
+        planes.y = y.data();
+        planes.yStride = width;
+        planes.uv = uv.data();
+        planes.uvStride = width;
+        planes.width = width;
+        planes.height = height;
+        planes.vuOrder = true;
+
+        AlignedImageBuffer dst(static_cast<size_t>(width) * height * 4);
+        for (int32_t channels : {3, 4}) {
+            for (SimdLevel level : levels) {
+                printf("%4dx%-5d %-6s %-8s %10.3f\n", width, height, channels == 4 ? "RGBA" : "RGB",
+                       simdLevelName(level), benchmarkMs(planes, dst.data(), channels, level, iterations));
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+// ==================== image_conversion_test.cpp ====================
+// 每個可用的 SIMD 核心與標量參考逐位元比較：
+// 奇數寬 / 高、帶填充的源和目標步長、NV12 與 NV21、RGB / RGBA / 灰度
+
+#include "ImageConversion.h"
+#include "TestSupport.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace VuforiaWrapper::ImageConversion;
+
+namespace {
+
+    // 當前架構編譯了的 SIMD 等級中，CPU 實際支持的部分
+    std::vector<SimdLevel> testedSimdLevels() {
+        const SimdLevel detected = detectSimdLevel();
+        std::vector<SimdLevel> levels;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        if (detected == SimdLevel::NEON) {
+            levels.push_back(SimdLevel::NEON);
+        }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+        if (static_cast<int>(detected) >= static_cast<int>(SimdLevel::SSE41)) {
+            levels.push_back(SimdLevel::SSE41);
+        }
+        if (static_cast<int>(detected) >= static_cast<int>(SimdLevel::AVX2)) {
+            levels.push_back(SimdLevel::AVX2);
+        }
+#endif
+        return levels;
+    }
+
+    struct YuvImage {
+        std::vector<uint8_t> y;
+        std::vector<uint8_t> uv;
+        YuvPlanes planes;
+    };
+
+    // 隨機內容覆蓋整個字節範圍，確保飽和分支被覆蓋；填充區域也寫入隨機值
+    YuvImage makeImage(std::mt19937& rng, int32_t width, int32_t height, int32_t padding, bool vuOrder) {
+        YuvImage image;
+        const int32_t yStride = width + padding;
+        const int32_t uvStride = ((width + 1) & ~1) + padding;
+        image.y.resize(static_cast<size_t>(yStride) * height);
+        image.uv.resize(static_cast<size_t>(uvStride) * ((height + 1) / 2));
+        std::uniform_int_distribution<int> byteDist(0, 255);
+        for (uint8_t& value : image.y) {
+            value = static_cast<uint8_t>(byteDist(rng));
+        }
+        for (uint8_t& value : image.uv) {
+            value = static_cast<uint8_t>(byteDist(rng));
+        }
+        image.planes.y = image.y.data();
+        image.planes.yStride = yStride;
+        image.planes.uv = image.uv.data();
+        image.planes.uvStride = uvStride;
+        image.planes.width = width;
+        image.planes.height = height;
+        image.planes.vuOrder = vuOrder;
+        return image;
+    }
+
+    typedef bool (*ConvertFn)(const YuvPlanes&, uint8_t*, int32_t, SimdLevel);
+
+    void compareKernel(const YuvImage& image, int32_t channels, int32_t dstPadding, SimdLevel level) {
+        const ConvertFn convert = channels == 4 ? &convertYuvToRgba : &convertYuvToRgb;
+        const int32_t dstStride = image.planes.width * channels + dstPadding;
+        const size_t dstSize = static_cast<size_t>(dstStride) * image.planes.height;
+
+        // 不同的哨兵值：填充字節必須保持原樣，像素字節必須一致
+        std::vector<uint8_t> expected(dstSize, 0xA5);
+        std::vector<uint8_t> actual(dstSize, 0xA5);
+        CHECK(convert(image.planes, expected.data(), dstStride, SimdLevel::SCALAR));
+        CHECK(convert(image.planes, actual.data(), dstStride, level));
+
+        for (size_t i = 0; i < dstSize; ++i) {
+            if (expected[i] != actual[i]) {
+                const int32_t row = static_cast<int32_t>(i / dstStride);
+                const int32_t column = static_cast<int32_t>(i % dstStride);
+                CHECK_MSG(false, "%s %s %dx%d yStride %d dstStride %d: byte (%d, %d) scalar %u simd %u",
+                          simdLevelName(level), channels == 4 ? "RGBA" : "RGB",
+                          image.planes.width, image.planes.height, image.planes.yStride, dstStride,
+                          column, row, expected[i], actual[i]);
+                return;
+            }
+        }
+    }
+
+    void testGray(const YuvImage& image, int32_t dstPadding) {
+        const int32_t dstStride = image.planes.width + dstPadding;
+        std::vector<uint8_t> gray(static_cast<size_t>(dstStride) * image.planes.height, 0xA5);
+        CHECK(convertYuvToGray(image.planes, gray.data(), dstStride));
+        for (int32_t row = 0; row < image.planes.height; ++row) {
+            const uint8_t* src = image.planes.y + static_cast<size_t>(row) * image.planes.yStride;
+            const uint8_t* dst = gray.data() + static_cast<size_t>(row) * dstStride;
+            CHECK(memcmp(src, dst, static_cast<size_t>(image.planes.width)) == 0);
+            // 步長相同時整塊複製，填充字節也會被覆蓋
+            if (dstStride == image.planes.yStride) {
+                continue;
+            }
+            for (int32_t x = image.planes.width; x < dstStride; ++x) {
+                CHECK(dst[x] == 0xA5);
+            }
+        }
+    }
+
+    // 已知像素值：標量參考本身符合文檔中的 BT.601 公式
+    void testScalarReference() {
+        const uint8_t y[2] = {16, 235};
+        const uint8_t uv[2] = {128, 128};
+        YuvPlanes planes;
+        planes.y = y;
+        planes.yStride = 2;
+        planes.uv = uv;
+        planes.uvStride = 2;
+        planes.width = 2;
+        planes.height = 1;
+
+        uint8_t rgba[8] = {};
+        CHECK(convertYuvToRgba(planes, rgba, 8, SimdLevel::SCALAR));
+        CHECK(rgba[0] == 0 && rgba[1] == 0 && rgba[2] == 0 && rgba[3] == 255);
+        CHECK(rgba[4] == 253 && rgba[5] == 253 && rgba[6] == 253 && rgba[7] == 255);
+    }
+
+    void testRejectsInvalidInput() {
+        std::mt19937 rng(7);
+        YuvImage image = makeImage(rng, 8, 4, 0, false);
+        std::vector<uint8_t> dst(8 * 4 * 4);
+        CHECK(!convertYuvToRgb(image.planes, dst.data(), 8 * 3 - 1));
+        CHECK(!convertYuvToRgba(image.planes, nullptr, 8 * 4));
+        image.planes.yStride = 7;
+        CHECK(!convertYuvToRgb(image.planes, dst.data(), 8 * 3));
+    }
+}
+
+int main() {
+    const std::vector<SimdLevel> levels = testedSimdLevels();
+    printf("Detected SIMD level: %s, comparing %zu kernel level(s) against scalar\n",
+           simdLevelName(detectSimdLevel()), levels.size());
+
+    testScalarReference();
+    testRejectsInvalidInput();
+
+    const int32_t widths[] = {1, 2, 3, 15, 16, 17, 31, 32, 33, 47, 63, 64, 65, 97, 641};
+    const int32_t heights[] = {1, 2, 3, 7, 17};
+    const int32_t paddings[] = {0, 3, 64};
+
+    std::mt19937 rng(20261016);
+    for (int32_t width : widths) {
+        for (int32_t height : heights) {
+            for (int32_t padding : paddings) {
+                for (int order = 0; order < 2; ++order) {
+                    const YuvImage image = makeImage(rng, width, height, padding, order == 1);
+                    testGray(image, padding);
+                    testGray(image, padding + 5);
+                    for (SimdLevel level : levels) {
+                        compareKernel(image, 3, padding, level);
+                        compareKernel(image, 4, padding, level);
+                    }
+                }
+            }
+        }
+    }
+
+    return TestSupport::finish("image_conversion_test");
+}
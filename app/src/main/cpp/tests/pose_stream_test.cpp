@@ -0,0 +1,94 @@
+// ==================== pose_stream_test.cpp ====================
+// 姿態流每幀提交：本幀沒有寫入的目標標記為 NO_POSE，空幀也要提交
+
+#include "PoseStreamTable.h"
+#include "TestSupport.h"
+#include <cstring>
+
+using VuforiaWrapper::PoseStreamTable;
+
+namespace {
+
+    VuMatrix44F translation(float x) {
+        VuMatrix44F pose;
+        memset(&pose, 0, sizeof(pose));
+        pose.data[0] = pose.data[5] = pose.data[10] = pose.data[15] = 1.0f;
+        pose.data[12] = x;
+        return pose;
+    }
+
+    struct SlotView {
+        int32_t status;
+        VuMatrix44F pose;
+        int64_t timestampNs;
+        uint64_t frameSequence;
+    };
+
+    SlotView readSlot(const PoseStreamTable& table, int32_t targetId) {
+        SlotView view;
+        CHECK(table.read(targetId, view.status, view.pose, view.timestampNs, view.frameSequence));
+        return view;
+    }
+
+    void testAbsentTargetBecomesNoPose() {
+        PoseStreamTable table;
+        table.write(0, VU_OBSERVATION_POSE_STATUS_TRACKED, translation(1.0f), 100, 1);
+        table.write(1, VU_OBSERVATION_POSE_STATUS_TRACKED, translation(2.0f), 100, 1);
+        table.commitFrame(1, 100);
+
+        // 第 2 幀只觀察到目標 0
+        table.write(0, VU_OBSERVATION_POSE_STATUS_TRACKED, translation(1.5f), 200, 2);
+        table.commitFrame(2, 200);
+
+        const SlotView observed = readSlot(table, 0);
+        CHECK(observed.status == VU_OBSERVATION_POSE_STATUS_TRACKED);
+        CHECK(observed.frameSequence == 2);
+
+        // 消失的目標保留最後的姿態與幀序號，但不再是當前姿態
+        const SlotView absent = readSlot(table, 1);
+        CHECK(absent.status == VU_OBSERVATION_POSE_STATUS_NO_POSE);
+        CHECK(absent.frameSequence == 1);
+        CHECK(absent.timestampNs == 100);
+        CHECK(absent.pose.data[12] == 2.0f);
+    }
+
+    void testEmptyFrameCommits() {
+        PoseStreamTable table;
+        table.write(0, VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED, translation(1.0f), 100, 7);
+        table.commitFrame(7, 100);
+
+        // 沒有任何觀察結果的幀：頭部前進，所有目標變為 NO_POSE
+        table.commitFrame(8, 200);
+        const SlotView absent = readSlot(table, 0);
+        CHECK(absent.status == VU_OBSERVATION_POSE_STATUS_NO_POSE);
+        CHECK(absent.frameSequence == 7);
+
+        // NO_POSE 不重複寫入：序號不變，讀者不需要重讀
+        const uint32_t* sequence = reinterpret_cast<const uint32_t*>(table.data() + sizeof(VuforiaWrapper::PoseStreamHeader));
+        const uint32_t before = *sequence;
+        table.commitFrame(9, 300);
+        CHECK(*sequence == before);
+        CHECK((before & 1u) == 0);
+
+        // 重新觀察到後恢復
+        table.write(0, VU_OBSERVATION_POSE_STATUS_TRACKED, translation(3.0f), 400, 10);
+        table.commitFrame(10, 400);
+        CHECK(readSlot(table, 0).status == VU_OBSERVATION_POSE_STATUS_TRACKED);
+    }
+
+    void testNeverObservedStaysNone() {
+        PoseStreamTable table;
+        table.write(2, VU_OBSERVATION_POSE_STATUS_TRACKED, translation(1.0f), 100, 1);
+        table.commitFrame(1, 100);
+        // 目標 0、1 從未觀察到，保持 0 而不是 NO_POSE
+        CHECK(readSlot(table, 0).status == 0);
+        CHECK(readSlot(table, 1).status == 0);
+    }
+}
+
+int main() {
+    testAbsentTargetBecomesNoPose();
+    testEmptyFrameCommits();
+    testNeverObservedStaysNone();
+    return TestSupport::finish("pose_stream_test");
+}
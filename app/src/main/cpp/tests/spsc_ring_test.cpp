@@ -0,0 +1,180 @@
+// ==================== spsc_ring_test.cpp ====================
+// SpscRing 的順序、溢出策略與計數；以及 DROP_OLDEST 下的併發壓力測試
+// （配合 HOST_TESTS_TSAN=ON 構建可檢查槽位訪問沒有數據競爭）
+
+#include "SpscRing.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using VuforiaWrapper::RingOverflowPolicy;
+using VuforiaWrapper::SpscRing;
+
+namespace {
+
+    struct Record {
+        uint64_t sequence;
+        uint64_t check[7];
+
+        static Record make(uint64_t sequence) {
+            Record record;
+            record.sequence = sequence;
+            for (int i = 0; i < 7; ++i) {
+                record.check[i] = sequence * 31 + i;
+            }
+            return record;
+        }
+
+        bool consistent() const {
+            for (int i = 0; i < 7; ++i) {
+                if (check[i] != sequence * 31 + i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    void testFifoOrder() {
+        SpscRing<Record, 8> ring;
+        for (uint64_t i = 1; i <= 5; ++i) {
+            CHECK(ring.push(Record::make(i)));
+        }
+        CHECK(ring.size() == 5);
+
+        Record out[8];
+        CHECK(ring.popBatch(out, 3) == 3);
+        CHECK(out[0].sequence == 1 && out[2].sequence == 3);
+        CHECK(ring.popBatch(out, 8) == 2);
+        CHECK(out[0].sequence == 4 && out[1].sequence == 5);
+        CHECK(ring.popBatch(out, 8) == 0);
+
+        // 繞回多圈後順序不變
+        for (uint64_t i = 6; i <= 40; ++i) {
+            CHECK(ring.push(Record::make(i)));
+            CHECK(ring.popBatch(out, 8) == 1);
+            CHECK(out[0].sequence == i);
+        }
+        CHECK(ring.getOverflowCount() == 0);
+    }
+
+    void testDropNewest() {
+        SpscRing<Record, 8> ring;
+        ring.setPolicy(RingOverflowPolicy::DROP_NEWEST);
+        ring.setLimit(4);
+        for (uint64_t i = 1; i <= 6; ++i) {
+            ring.push(Record::make(i));
+        }
+        CHECK(ring.getDroppedNewestCount() == 2);
+        CHECK(ring.getDroppedOldestCount() == 0);
+        CHECK(ring.getHighWaterMark() == 4);
+
+        Record out[8];
+        CHECK(ring.popBatch(out, 8) == 4);
+        CHECK(out[0].sequence == 1 && out[3].sequence == 4);
+    }
+
+    void testDropOldest() {
+        SpscRing<Record, 8> ring;
+        ring.setLimit(4);
+        for (uint64_t i = 1; i <= 10; ++i) {
+            CHECK(ring.push(Record::make(i)));
+        }
+        CHECK(ring.getDroppedOldestCount() == 6);
+        CHECK(ring.size() == 4);
+
+        Record out[8];
+        CHECK(ring.popBatch(out, 8) == 4);
+        CHECK(out[0].sequence == 7 && out[3].sequence == 10);
+
+        // 全容量下覆蓋同樣保留最新記錄
+        ring.setLimit(8);
+        for (uint64_t i = 11; i <= 30; ++i) {
+            CHECK(ring.push(Record::make(i)));
+        }
+        CHECK(ring.popBatch(out, 8) == 8);
+        CHECK(out[0].sequence == 23 && out[7].sequence == 30);
+    }
+
+    void testClear() {
+        SpscRing<Record, 8> ring;
+        for (uint64_t i = 1; i <= 8; ++i) {
+            ring.push(Record::make(i));
+        }
+        ring.clear();
+        CHECK(ring.size() == 0);
+
+        // 清空後的槽位必須能重新寫滿
+        for (uint64_t i = 9; i <= 16; ++i) {
+            CHECK(ring.push(Record::make(i)));
+        }
+        CHECK(ring.getOverflowCount() == 0);
+        Record out[8];
+        CHECK(ring.popBatch(out, 8) == 8);
+        CHECK(out[0].sequence == 9);
+    }
+
+    // 生產者以 DROP_OLDEST 持續覆蓋，消費者批量讀取：
+    // 讀到的記錄必須完整且嚴格遞增，計數必須對得上
+    void testConcurrentDropOldest() {
+        static constexpr uint64_t RECORDS = 200000;
+        SpscRing<Record, 16> ring;
+        std::atomic<bool> producerDone(false);
+        uint64_t accepted = 0;
+
+        std::thread producer([&]() {
+            for (uint64_t i = 1; i <= RECORDS; ++i) {
+                if (ring.push(Record::make(i))) {
+                    ++accepted;
+                }
+                if ((i & 63) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            producerDone.store(true, std::memory_order_release);
+        });
+
+        uint64_t popped = 0;
+        uint64_t torn = 0;
+        uint64_t outOfOrder = 0;
+        uint64_t lastSequence = 0;
+        Record out[16];
+        for (;;) {
+            const bool done = producerDone.load(std::memory_order_acquire);
+            const size_t count = ring.popBatch(out, 16);
+            for (size_t i = 0; i < count; ++i) {
+                if (!out[i].consistent()) {
+                    ++torn;
+                }
+                if (out[i].sequence <= lastSequence) {
+                    ++outOfOrder;
+                }
+                lastSequence = out[i].sequence;
+            }
+            popped += count;
+            if (done && count == 0) {
+                break;
+            }
+        }
+        producer.join();
+
+        CHECK(torn == 0);
+        CHECK(outOfOrder == 0);
+        CHECK(accepted + ring.getDroppedNewestCount() == RECORDS);
+        CHECK(popped + ring.getDroppedOldestCount() == accepted);
+        printf("concurrent DROP_OLDEST: popped %llu, dropped oldest %llu, dropped newest %llu\n",
+               static_cast<unsigned long long>(popped),
+               static_cast<unsigned long long>(ring.getDroppedOldestCount()),
+               static_cast<unsigned long long>(ring.getDroppedNewestCount()));
+    }
+}
+
+int main() {
+    testFifoOrder();
+    testDropNewest();
+    testDropOldest();
+    testClear();
+    testConcurrentDropOldest();
+    return TestSupport::finish("spsc_ring_test");
+}
@@ -0,0 +1,112 @@
+// ==================== worker_thread_test.cpp ====================
+// WorkerThread：notify 喚醒工作函數、onStart 失敗時不運行、
+// 多個線程同時 start / stop 時生命週期串行化（建議以 HOST_TESTS_TSAN 構建運行）
+
+#include "WorkerThread.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using VuforiaWrapper::WorkerThread;
+
+namespace {
+
+    // 空閒超時設得很長，工作只能由 notify 觸發
+    static constexpr int LONG_IDLE_MS = 10000;
+
+    bool waitFor(const std::atomic<int>& value, int expected, int timeoutMs) {
+        const int64_t deadline = TestSupport::nowNs() + static_cast<int64_t>(timeoutMs) * 1000000;
+        while (value.load() < expected) {
+            if (TestSupport::nowNs() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void testNotifyRunsWork() {
+        std::atomic<int> started{0};
+        std::atomic<int> runs{0};
+        std::atomic<int> exited{0};
+        WorkerThread::Callbacks callbacks;
+        callbacks.onStart = [&]() { ++started; return true; };
+        callbacks.work = [&]() { ++runs; };
+        callbacks.onExit = [&]() { ++exited; };
+
+        WorkerThread worker("test worker", LONG_IDLE_MS, std::move(callbacks));
+        CHECK(worker.start());
+        CHECK(worker.start());   // 已啟動時直接返回
+        CHECK(waitFor(started, 1, 1000));
+
+        worker.notify();
+        CHECK(waitFor(runs, 1, 1000));
+        worker.notify();
+        CHECK(waitFor(runs, 2, 1000));
+
+        // stop 不等待空閒超時，退出前調用 onExit
+        const int64_t stopStart = TestSupport::nowNs();
+        worker.stop();
+        CHECK(TestSupport::nowNs() - stopStart < 1000000000LL);
+        CHECK(!worker.isRunning());
+        CHECK(started.load() == 1);
+        CHECK(exited.load() == 1);
+    }
+
+    void testFailedStartSkipsWork() {
+        std::atomic<int> runs{0};
+        std::atomic<int> exited{0};
+        WorkerThread::Callbacks callbacks;
+        callbacks.onStart = []() { return false; };
+        callbacks.work = [&]() { ++runs; };
+        callbacks.onExit = [&]() { ++exited; };
+
+        WorkerThread worker("failing worker", 1, std::move(callbacks));
+        CHECK(worker.start());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        worker.notify();
+        worker.stop();
+        CHECK(runs.load() == 0);
+        CHECK(exited.load() == 0);
+        CHECK(!worker.isRunning());
+    }
+
+    void testConcurrentLifecycle() {
+        std::atomic<int> starts{0};
+        std::atomic<int> exits{0};
+        WorkerThread::Callbacks callbacks;
+        callbacks.onStart = [&]() { ++starts; return true; };
+        callbacks.work = []() {};
+        callbacks.onExit = [&]() { ++exits; };
+        WorkerThread worker("lifecycle worker", 5, std::move(callbacks));
+
+        // 多個線程交錯 start / stop / notify，不能出現重複 join 或兩個工作線程
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&worker, t]() {
+                for (int i = 0; i < 50; ++i) {
+                    if ((i + t) % 2 == 0) {
+                        worker.start();
+                    } else {
+                        worker.stop();
+                    }
+                    worker.notify();
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        worker.stop();
+        CHECK(!worker.isRunning());
+        CHECK(starts.load() == exits.load());
+    }
+}
+
+int main() {
+    testNotifyRunsWork();
+    testFailedStartSkipsWork();
+    testConcurrentLifecycle();
+    return TestSupport::finish("worker_thread_test");
+}
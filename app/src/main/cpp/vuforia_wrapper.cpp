@@ -1,6 +1,13 @@
 #include "VuforiaWrapper.h"
+#include "LumaPyramid.h"
+#include "CameraFormatRegistry.h"
+#include "RegionOfInterest.h"
+#include "PoseStreamTable.h"
+#include "TargetEventDispatcher.h"
+#include "JniRegistry.h"
 #include "VuforiaEngine/VuforiaEngine.h"
 #include <cstring>
+#include <algorithm>
 //C:\Users\USER\Desktop\IBM-WEATHER-ART-ANDRIOD\app\src\main\cpp\vuforia_wrapper.cpp
 // ==================== 全局變量聲明 ====================
 jobject gAndroidContext = nullptr;
@@ -34,115 +41,51 @@ namespace VuforiaWrapper {
     }
 }
 
-// ==================== TargetEventManager 實現 ====================
+// 外推結果直接寫入姿態流，兩者按同一目標 ID 索引
+static_assert(VuforiaWrapper::PoseExtrapolator::MAX_TARGETS == VuforiaWrapper::POSE_STREAM_MAX_TARGETS,
+              "Pose extrapolator and pose stream must cover the same target ids");
+
+// ==================== CameraFrameExtractor 實現 ====================
 namespace VuforiaWrapper {
     
-    void TargetEventManager::addEvent(const std::string& targetName, TargetEventType eventType, 
-                                    const VuMatrix44F& poseMatrix, float confidence) {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        
-        // 檢查是否需要觸發事件（避免重複）
-        if (!shouldTriggerEvent(targetName, eventType)) {
-            return;
-        }
-        
-        TargetEvent event;
-        event.targetName = targetName;
-        event.eventType = eventType;
-        copyMatrix(event.poseMatrix, poseMatrix);
-        event.confidence = confidence;
-        event.timestamp = std::chrono::steady_clock::now();
-        
-        mEventQueue.push(event);
-        mLastEventMap[targetName] = eventType;
-        
-        LOGD("Target event added: %s, type: %d", targetName.c_str(), static_cast<int>(eventType));
-    }
-    
-    bool TargetEventManager::shouldTriggerEvent(const std::string& targetName, TargetEventType eventType) {
-        auto it = mLastEventMap.find(targetName);
-        if (it == mLastEventMap.end()) {
-            return true;
-        }
-        return it->second != eventType;
-    }
-    
-    void TargetEventManager::processEvents(JNIEnv* env, jobject callback) {
-        if (env == nullptr || callback == nullptr) {
-            return;
-        }
-        
-        std::queue<TargetEvent> tempQueue;
-        {
-            std::lock_guard<std::mutex> lock(mQueueMutex);
-            tempQueue.swap(mEventQueue);
-        }
-        
-        while (!tempQueue.empty()) {
-            const auto& event = tempQueue.front();
-            callJavaCallback(env, callback, event);
-            tempQueue.pop();
-        }
-    }
-    
-    void TargetEventManager::callJavaCallback(JNIEnv* env, jobject callback, const TargetEvent& event) {
-        jclass callbackClass = env->GetObjectClass(callback);
-        if (callbackClass == nullptr) {
-            return;
+    bool CameraFrameData::getYuvPlanes(ImageConversion::YuvPlanes& planes) const {
+        if (!hasImage()) {
+            return false;
         }
-        
-        const char* methodName = nullptr;
-        switch (event.eventType) {
-            case TargetEventType::TARGET_FOUND:
-                methodName = "onTargetFound";
-                break;
-            case TargetEventType::TARGET_TRACKING:
-            case TargetEventType::TARGET_EXTENDED_TRACKING:
-                methodName = "onTargetTracking";
-                break;
-            case TargetEventType::TARGET_LOST:
-                methodName = "onTargetLost";
-                break;
+        if (format != VU_IMAGE_PIXEL_FORMAT_NV12 && format != VU_IMAGE_PIXEL_FORMAT_NV21) {
+            return false;
         }
-        
-        if (methodName != nullptr) {
-            jmethodID methodId = env->GetMethodID(callbackClass, methodName, "(Ljava/lang/String;)V");
-            if (methodId != nullptr) {
-                jstring jTargetName = env->NewStringUTF(event.targetName.c_str());
-                if (jTargetName != nullptr) {
-                    env->CallVoidMethod(callback, methodId, jTargetName);
-                    env->DeleteLocalRef(jTargetName);
-                }
-            }
+
+        // 亮度平面之後緊接交錯的色度平面（bufferHeight 行亮度）
+        const size_t lumaSize = static_cast<size_t>(stride) * bufferHeight;
+        const size_t chromaSize = static_cast<size_t>(stride) * ((height + 1) / 2);
+        if (bufferSize > 0 && lumaSize + chromaSize > static_cast<size_t>(bufferSize)) {
+            LOGW("YUV buffer too small: %d bytes for %dx%d stride %d",
+                 bufferSize, width, height, stride);
+            return false;
         }
-        
-        env->DeleteLocalRef(callbackClass);
+
+        planes.y = buffer;
+        planes.yStride = stride;
+        planes.uv = buffer + lumaSize;
+        planes.uvStride = stride;
+        planes.width = width;
+        planes.height = height;
+        planes.vuOrder = (format == VU_IMAGE_PIXEL_FORMAT_NV21);
+        return true;
     }
     
-    void TargetEventManager::clearEvents() {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        std::queue<TargetEvent> empty;
-        mEventQueue.swap(empty);
-        mLastEventMap.clear();
+    CameraFrameExtractor::CameraFrameExtractor()
+        : mLumaPyramids(std::make_unique<LumaPyramidCache>()) {
     }
     
-    size_t TargetEventManager::getEventCount() const {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        return mEventQueue.size();
-    }
-
-} // namespace VuforiaWrapper
-
-// ==================== CameraFrameExtractor 實現 ====================
-namespace VuforiaWrapper {
+    CameraFrameExtractor::~CameraFrameExtractor() = default;
     
     bool CameraFrameExtractor::extractFrameData(const VuState* state) {
         if (state == nullptr) {
             return false;
         }
         
-        std::lock_guard<std::mutex> lock(mFrameMutex);
-        
         // 獲取相機幀 - 修正：正確的參數類型
         VuCameraFrame* cameraFrame = nullptr;
         VuResult result = vuStateGetCameraFrame(state, &cameraFrame);
@@ -150,28 +93,62 @@ namespace VuforiaWrapper {
             return false;
         }
         
+        // 取得可寫槽位 - 所有槽位都被讀者佔用時丟棄這一幀，不等待
+        CameraFrameData* frameData = mFrameMailbox.beginWrite();
+        if (frameData == nullptr) {
+            return false;
+        }
+        
         // 提取圖像數據
-        if (!extractImageData(cameraFrame, mLatestFrame)) {
+        if (!extractImageData(cameraFrame, *frameData)) {
+            mFrameMailbox.abortWrite();
             return false;
         }
         
         // 提取渲染矩陣
-        if (!extractRenderMatrices(state, mLatestFrame)) {
+        if (!extractRenderMatrices(state, *frameData)) {
+            mFrameMailbox.abortWrite();
             return false;
         }
         
         // 獲取時間戳
-        vuCameraFrameGetTimestamp(cameraFrame, &mLatestFrame.timestamp);
+        vuCameraFrameGetTimestamp(cameraFrame, &frameData->timestamp);
         
-        mFrameAvailable = true;
+        mFrameMailbox.commitWrite();
         return true;
     }
     
-    // 修正：添加常量定義以避免 magic number 警告
-    static const int32_t DEFAULT_FRAME_WIDTH = 640;
-    static const int32_t DEFAULT_FRAME_HEIGHT = 480;
+    // 讀取圖像信息並增加引用計數，讓緩衝區在 VuState 釋放後仍然有效
+    static bool acquireImageView(VuImage* image, CameraImageView& view, VuImageInfo& imageInfo) {
+        memset(&imageInfo, 0, sizeof(VuImageInfo));
+        VuResult result = vuImageGetImageInfo(image, &imageInfo);
+        if (result != VU_SUCCESS || imageInfo.buffer == nullptr) {
+            LOGW("vuImageGetImageInfo failed: %d", result);
+            return false;
+        }
+        
+        // ✅ 零拷貝：增加圖像引用計數
+        VuImage* imageRef = nullptr;
+        result = vuImageAcquireReference(image, &imageRef);
+        if (result != VU_SUCCESS || imageRef == nullptr) {
+            LOGW("vuImageAcquireReference failed: %d", result);
+            return false;
+        }
+        
+        view.image = CameraImageRef(imageRef, VuImageReleaser());
+        view.buffer = static_cast<const uint8_t*>(imageInfo.buffer);
+        view.format = imageInfo.format;
+        view.width = imageInfo.width;
+        view.height = imageInfo.height;
+        view.stride = imageInfo.stride;
+        view.bufferSize = imageInfo.bufferSize;
+        return true;
+    }
     
     bool CameraFrameExtractor::extractImageData(const VuCameraFrame* cameraFrame, CameraFrameData& frameData) {
+        // 槽位重用前先釋放上一輪持有的圖像引用
+        frameData.releaseImage();
+        
         // 修正：創建圖像列表並使用正確的 API
         VuImageList* images = nullptr;
         VuResult result = vuImageListCreate(&images);
@@ -193,28 +170,42 @@ namespace VuforiaWrapper {
             return false;
         }
         
-        // 獲取第一個圖像（通常是主相機圖像）
-        VuImage* image = nullptr;
-        vuImageListGetElement(images, 0, &image);
-        if (image == nullptr) {
-            vuImageListDestroy(images);
-            return false;
+        // 第一個圖像是相機原生格式，其餘是通過 CameraFormatRegistry 註冊的格式
+        bool primaryFound = false;
+        for (int32_t i = 0; i < numImages; ++i) {
+            VuImage* image = nullptr;
+            vuImageListGetElement(images, i, &image);
+            if (image == nullptr) {
+                continue;
+            }
+            
+            if (!primaryFound) {
+                CameraImageView primary;
+                VuImageInfo imageInfo;
+                if (!acquireImageView(image, primary, imageInfo)) {
+                    break;
+                }
+                frameData.image = std::move(primary.image);
+                frameData.buffer = primary.buffer;
+                frameData.width = imageInfo.width;
+                frameData.height = imageInfo.height;
+                frameData.stride = imageInfo.stride;
+                frameData.bufferWidth = imageInfo.bufferWidth;
+                frameData.bufferHeight = imageInfo.bufferHeight;
+                frameData.bufferSize = imageInfo.bufferSize;
+                frameData.format = imageInfo.format;
+                primaryFound = true;
+            } else if (frameData.extraImageCount < CameraFrameData::MAX_EXTRA_IMAGES) {
+                VuImageInfo imageInfo;
+                if (acquireImageView(image, frameData.extraImages[frameData.extraImageCount], imageInfo)) {
+                    ++frameData.extraImageCount;
+                }
+            }
         }
         
-        // 修正：在 Vuforia 11.x 中，圖像信息可能需要通過其他方式獲取
-        // 暫時設置默認值，因為 vuImageGetInfo 可能不存在
-        LOGW("Image info extraction temporarily disabled - API not available in Vuforia 11.x");
-        frameData.width = DEFAULT_FRAME_WIDTH;   // 使用常量
-        frameData.height = DEFAULT_FRAME_HEIGHT;  // 使用常量
-        frameData.format = VU_IMAGE_PIXEL_FORMAT_RGB888;  // 默認格式
-        
-        // 清理資源
+        // 圖像列表只是容器，引用取得後即可銷毀
         vuImageListDestroy(images);
-        
-        // 暫時不複製圖像數據，因為 vuImageGetPixels 不可用
-        frameData.imageData.clear();
-        
-        return true;
+        return primaryFound;
     }
     
     bool CameraFrameExtractor::extractRenderMatrices(const VuState* state, CameraFrameData& frameData) {
@@ -230,18 +221,136 @@ namespace VuforiaWrapper {
         copyMatrix(frameData.projectionMatrix, renderState.projectionMatrix);
         copyMatrix(frameData.viewMatrix, renderState.viewMatrix);
         
+        // 內參直接對應相機圖像像素，用於把目標投影到圖像座標
+        frameData.hasIntrinsics = (vuStateGetCameraIntrinsics(state, &frameData.intrinsics) == VU_SUCCESS);
+        
         return true;
     }
     
     bool CameraFrameExtractor::getLatestFrame(CameraFrameData& frameData) {
-        std::lock_guard<std::mutex> lock(mFrameMutex);
-        if (!mFrameAvailable) {
+        FrameReadGuard frame = mFrameMailbox.acquireLatest();
+        if (!frame) {
+            return false;
+        }
+        
+        frameData = *frame;
+        return true;
+    }
+    
+    void CameraFrameExtractor::setLumaPyramidLevels(int levels) {
+        mLumaPyramids->setLevelCount(levels);
+    }
+    
+    int CameraFrameExtractor::getLumaPyramidLevels() const {
+        return mLumaPyramids->getLevelCount();
+    }
+    
+    std::shared_ptr<const LumaPyramid> CameraFrameExtractor::getLumaPyramid(const CameraFrameData& frameData) {
+        return mLumaPyramids->acquire(frameData);
+    }
+    
+    std::shared_ptr<const LumaPyramid> CameraFrameExtractor::getLatestLumaPyramid() {
+        FrameReadGuard frame = mFrameMailbox.acquireLatest();
+        if (!frame) {
+            return nullptr;
+        }
+        return mLumaPyramids->acquire(*frame);
+    }
+    
+    void CameraFrameExtractor::reset() {
+        mLumaPyramids->clear();
+        mFrameMailbox.clear();
+    }
+}
+
+// ==================== CameraFrameLeaseTable 實現 ====================
+namespace VuforiaWrapper {
+    
+    int CameraFrameLeaseTable::acquire(const CameraFrameExtractor& extractor, uint64_t lastSeenSequence) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        for (int i = 0; i < MAX_LEASES; ++i) {
+            if (mLeases[i]) {
+                continue;
+            }
+            
+            CameraFrameExtractor::FrameReadGuard frame = extractor.acquireLatestFrame(lastSeenSequence);
+            if (!frame || !frame->hasImage()) {
+                return -1;
+            }
+            
+            mLeases[i] = std::move(frame);
+            mHandles[i] = makeHandle(++mGeneration, i);
+            return mHandles[i];
+        }
+        
+        LOGW("⚠️ All %d camera frame leases are in use, release a frame first", MAX_LEASES);
+        return -1;
+    }
+    
+    const CameraFrameExtractor::FrameReadGuard* CameraFrameLeaseTable::findLease(int handle) const {
+        if (handle < 0) {
+            return nullptr;
+        }
+        const int index = handle & 0xF;
+        if (index >= MAX_LEASES || mHandles[index] != handle || !mLeases[index]) {
+            return nullptr;
+        }
+        return &mLeases[index];
+    }
+    
+    bool CameraFrameLeaseTable::getInfo(int handle, CameraFrameLeaseInfo& info) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        const CameraFrameExtractor::FrameReadGuard* lease = findLease(handle);
+        if (lease == nullptr) {
+            return false;
+        }
+        
+        const CameraFrameData& frame = **lease;
+        info.buffer = frame.buffer;
+        info.bufferSize = static_cast<size_t>(frame.bufferSize);
+        info.width = frame.width;
+        info.height = frame.height;
+        info.stride = frame.stride;
+        info.format = frame.format;
+        info.timestamp = frame.timestamp;
+        info.sequence = lease->sequence();
+        return true;
+    }
+    
+    bool CameraFrameLeaseTable::release(int handle) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        if (findLease(handle) == nullptr) {
+            LOGW("⚠️ Ignoring release of stale camera frame handle %d", handle);
             return false;
         }
         
-        frameData = mLatestFrame;
+        const int index = handle & 0xF;
+        mLeases[index].release();
+        mHandles[index] = -1;
         return true;
     }
+    
+    void CameraFrameLeaseTable::releaseAll() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (int i = 0; i < MAX_LEASES; ++i) {
+            mLeases[i].release();
+            mHandles[i] = -1;
+        }
+    }
+    
+    int CameraFrameLeaseTable::getActiveLeaseCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        int count = 0;
+        for (int i = 0; i < MAX_LEASES; ++i) {
+            if (mLeases[i]) {
+                ++count;
+            }
+        }
+        return count;
+    }
 }
 
 // ==================== VuforiaEngineWrapper 主要實現 ====================
@@ -257,6 +366,13 @@ namespace VuforiaWrapper {
         , mEngineState(EngineState::NOT_INITIALIZED)
         , mImageTrackingActive(false)
         , mDeviceTrackingEnabled(false)
+        , mObservationList(nullptr)
+        , mArenaFrameCount(0)
+        , mFrameAllocationViolations(0)
+        , mPredictionLeadNs(DEFAULT_PREDICTION_LEAD_NS)
+        , mDisplayLeadNs(DEFAULT_DISPLAY_LEAD_NS)
+        , mPredictionLeadFrames(0)
+        , mPendingSnapshot(nullptr)
         , mJVM(nullptr)
         , mTargetCallback(nullptr)
         // ✅ 新增的成员变量初始化
@@ -280,7 +396,14 @@ namespace VuforiaWrapper {
         , mRenderingQuality(1) // 默认中等质量        
     {
         mEventManager = std::make_unique<TargetEventManager>();
+        mEventDispatcher = std::make_unique<TargetEventDispatcher>(mEventManager.get());
         mFrameExtractor = std::make_unique<CameraFrameExtractor>();
+        mFormatRegistry = std::make_unique<CameraFormatRegistry>();
+        mTargetBounds = std::make_unique<TargetBoundsTable>();
+        WorkerThread::Callbacks controlCallbacks;
+        controlCallbacks.work = [this]() { applyPendingVideoMode(); };
+        mControlThread = std::make_unique<WorkerThread>("Engine control thread", ENGINE_CONTROL_IDLE_WAIT_MS,
+                                                        std::move(controlCallbacks));
         mLastFrameTime = std::chrono::steady_clock::now();
         memset(&mSavedGLState, 0, sizeof(mSavedGLState));
         LOGI("VuforiaEngineWrapper created with rendering support");
@@ -431,9 +554,17 @@ namespace VuforiaWrapper {
         
         LOGI("✅ RenderController obtained successfully: %p", mController);
         
+        // 相機控制器用於註冊像素格式，取得失敗不影響其他功能
+        result = vuEngineGetCameraController(mEngine, &mCameraController);
+        if (result != VU_SUCCESS || mCameraController == nullptr) {
+            LOGW("⚠️ Failed to get CameraController: %d", result);
+            mCameraController = nullptr;
+        } else {
+            LOGI("✅ CameraController obtained successfully: %p", mCameraController);
+        }
+        
         // ✅ 其他控制器在 11.3.4 中可能不需要
         mRenderController = nullptr;  // 這個可能不需要了
-        mCameraController = nullptr;
         mRecorderController = nullptr;
         
         return true;
@@ -462,6 +593,19 @@ namespace VuforiaWrapper {
             
             mEngineState = EngineState::STARTED;
             
+            // 引擎停止後相機控制器的格式註冊會失效，下一幀重新同步
+            if (mFormatRegistry) {
+                mFormatRegistry->invalidateRegistrations();
+            }
+            
+            // 引擎啟動後相機已打開，讀取可用視頻模式不會額外訪問相機
+            if (mCameraController) {
+                mVideoModeGovernor.refreshVideoModes(mCameraController);
+            }
+            if (!mControlThread->start()) {
+                LOGW("⚠️ Engine control thread unavailable, video mode governor inactive");
+            }
+            
             // 如果surface已经准备好，激活相机和渲染
             if (mSurfaceReady) {
                 mCameraActive = true;
@@ -503,10 +647,16 @@ namespace VuforiaWrapper {
         
         if (mEngineState == EngineState::PAUSED) {
             LOGI("Resuming Vuforia Engine...");
+            // 暫停期間引擎已停止，相機控制器的格式註冊失效；重新啟動後的第一幀重新同步
+            if (mFormatRegistry) {
+                mFormatRegistry->invalidateRegistrations();
+            }
             VuResult result = vuEngineStart(mEngine);
             if (checkVuResult(result, "vuEngineStart")) {
                 mEngineState = EngineState::STARTED;
             }
+            // 暫停前的幀時間不代表恢復後的負載，重新開始統計窗口
+            mVideoModeGovernor.resetWindow();
         }
     }
     
@@ -521,6 +671,9 @@ namespace VuforiaWrapper {
     }
     
     void VuforiaEngineWrapper::deinitialize() {
+        // 控制線程的工作會取 mEngineMutex，必須在取鎖之前停止
+        mControlThread->stop();
+        
         std::lock_guard<std::mutex> lock(mEngineMutex);
         
         if (mEngineState == EngineState::NOT_INITIALIZED) {
@@ -557,7 +710,13 @@ namespace VuforiaWrapper {
     }
     
     void VuforiaEngineWrapper::cleanup() {
-        // 清理回調
+        mFrameScheduler.stop();
+        
+        // 先停止分發線程（它在退出前釋放自己的 JNI 資源），再清理回調
+        if (mEventDispatcher) {
+            mEventDispatcher->stop();
+            mEventDispatcher->setCallback(nullptr);
+        }
         if (mTargetCallback != nullptr && mJVM != nullptr) {
             JNIEnv* env = nullptr;
             if (mJVM->AttachCurrentThread(&env, nullptr) == JNI_OK && env != nullptr) {
@@ -566,6 +725,12 @@ namespace VuforiaWrapper {
             mTargetCallback = nullptr;
         }
         
+        // 清理跨幀重用的觀察列表
+        if (mObservationList != nullptr) {
+            vuObservationListDestroy(mObservationList);
+            mObservationList = nullptr;
+        }
+        
         // 清理 Observers
         cleanupObservers();
         
@@ -576,6 +741,24 @@ namespace VuforiaWrapper {
         if (mEventManager) {
             mEventManager->clearEvents();
         }
+        // 姿態流內存由 Java 共享，不釋放，只標記所有目標為未觀察
+        getPoseStreamTable().reset();
+        mPoseExtrapolator.resetAll();
+        // 撤銷快照發佈，讀者之後拿到空守衛；仍被持有的槽位由讀者釋放後自然重用
+        mTrackingSnapshots.clear();
+        
+        // 釋放相機圖像引用（引擎銷毀後 VuImage 不再有效）
+        // Java 端租借的幀也必須歸還，否則郵箱槽位會繼續持有圖像
+        mCameraFrameLeases.releaseAll();
+        if (mFrameExtractor) {
+            mFrameExtractor->reset();
+        }
+        if (mFormatRegistry) {
+            mFormatRegistry->clearCache();
+        }
+        if (mTargetBounds) {
+            mTargetBounds->clear();
+        }
         
         // 重置控制器指針
         mController = nullptr;
@@ -594,6 +777,9 @@ namespace VuforiaWrapper {
             }
         }
         mImageTargetObservers.clear();
+        if (mEventManager) {
+            mEventManager->clearObserverIds();
+        }
     }
     
     void VuforiaEngineWrapper::cleanupDatabases() {
@@ -694,6 +880,11 @@ namespace VuforiaWrapper {
         
         // 存儲觀察器
         mImageTargetObservers.push_back(observer);
+        
+        // 登記名稱與 observer ID，名稱表隨下一批事件一次性發送給 Java
+        if (mEventManager) {
+            mEventManager->registerTarget(targetName.c_str(), vuObserverGetId(observer));
+        }
         LOGI("Image target observer created successfully: %s", targetName.c_str());
         return true;
     }
@@ -719,31 +910,147 @@ namespace VuforiaWrapper {
             return;
         }
         
+        // 統計本幀熱路徑的堆分配（僅 ENABLE_FRAME_ALLOC_CHECK 構建）
+        FrameAllocationScope allocationScope;
+        mLatencyTracker.beginFrame();
+        const auto frameStart = std::chrono::steady_clock::now();
+        
         try {
             // 获取最新状态
             VuState* state = nullptr;
             VuResult result = vuEngineAcquireLatestState(mEngine, &state);  // ✅ 直接使用 mEngine
             if (result != VU_SUCCESS || state == nullptr) {
+                mLatencyTracker.discardFrame();
                 return;
             }
+            mLatencyTracker.stamp(LatencyStage::STATE_ACQUIRED);
+            mLatencyTracker.stampCapture(state);
+            
+            // 处理状态数据（先提取觀察結果，背景繪製是本幀最後一步）
+            // 觀察結果同時寫入本幀快照，與相機矩陣一起發佈
+            mPendingSnapshot = mTrackingSnapshots.beginWrite();
+            if (mPendingSnapshot != nullptr) {
+                mPendingSnapshot->targetCount = 0;
+            }
+            processVuforiaState(state);
+            publishTrackingSnapshot(state);
+            mLatencyTracker.stamp(LatencyStage::OBSERVATIONS);
             
             // ✅ 简化版本：只清除屏幕并显示基本渲染
             renderCameraBackgroundSimple(state);
-            
-            // 处理状态数据
-            processVuforiaState(state);
+            mLatencyTracker.stamp(LatencyStage::BACKGROUND);
+            recordFrameProcessingTime(std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - frameStart).count());
             
             // 释放状态
             vuStateRelease(state);
             
-            // 处理事件回调
-            if (mEventManager && mTargetCallback != nullptr) {
-                mEventManager->processEvents(env, mTargetCallback);
+            // 喚醒分發線程調用 Java 回調，渲染線程不等待
+            if (mEventDispatcher) {
+                mEventDispatcher->notify();
             }
             
         } catch (const std::exception& e) {
             LOGE("Exception during frame rendering: %s", e.what());
         }
+        
+        // 幀結束：回收本幀所有臨時分配
+        mLatencyTracker.endFrame();
+        mFrameArena.reset();
+        checkFrameAllocations(allocationScope.getAllocationCount());
+    }
+    
+    // ==================== 相機視頻模式 ====================
+    
+    VideoModeSwitchResult VuforiaEngineWrapper::setCameraVideoMode(VuCameraVideoModePreset preset) {
+        std::lock_guard<std::mutex> lock(mEngineMutex);
+        
+        if (mEngine == nullptr || mCameraController == nullptr) {
+            LOGE("❌ Cannot set video mode: camera controller not available");
+            return VideoModeSwitchResult::FAILED;
+        }
+        
+        VuCameraVideoModePreset previous = VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT;
+        const bool hasPrevious = vuCameraControllerGetActiveVideoMode(mCameraController, &previous) == VU_SUCCESS;
+        
+        // 視頻模式只能在引擎停止時設置，運行中需要先停止再重新啟動
+        const bool wasRunning = (mEngineState == EngineState::STARTED);
+        if (wasRunning && !checkVuResult(vuEngineStop(mEngine), "vuEngineStop")) {
+            return VideoModeSwitchResult::FAILED;
+        }
+        
+        VuResult result = vuCameraControllerSetActiveVideoMode(mCameraController, preset);
+        bool modeSet = checkVuResult(result, "vuCameraControllerSetActiveVideoMode");
+        bool modeRejected = !modeSet;
+        
+        if (wasRunning) {
+            bool restarted = checkVuResult(vuEngineStart(mEngine), "vuEngineStart");
+            
+            // 新模式無法啟動：回滾到之前的模式再啟動一次
+            if (!restarted && modeSet && hasPrevious) {
+                LOGW("⚠️ Engine failed to start with %s, rolling back to %s",
+                     VideoModeGovernor::presetName(preset), VideoModeGovernor::presetName(previous));
+                modeSet = false;
+                if (checkVuResult(vuCameraControllerSetActiveVideoMode(mCameraController, previous),
+                                  "vuCameraControllerSetActiveVideoMode (rollback)")) {
+                    restarted = checkVuResult(vuEngineStart(mEngine), "vuEngineStart (rollback)");
+                }
+                // 之前的模式可以啟動，問題在新模式本身
+                modeRejected = restarted;
+            }
+            
+            // 回滾後仍無法啟動：視為暫停，resume() 可以重試，不把會話留在 ERROR_STATE
+            if (!restarted) {
+                LOGE("❌ Engine could not be restarted after video mode change, pausing");
+                mRenderingLoopActive = false;
+                mCameraActive = false;
+                mEngineState = EngineState::PAUSED;
+                return modeRejected ? VideoModeSwitchResult::REJECTED : VideoModeSwitchResult::FAILED;
+            }
+            if (mFormatRegistry) {
+                mFormatRegistry->invalidateRegistrations();
+            }
+        }
+        
+        if (modeSet) {
+            LOGI("📷 Camera video mode set to %s", VideoModeGovernor::presetName(preset));
+            return VideoModeSwitchResult::APPLIED;
+        }
+        return modeRejected ? VideoModeSwitchResult::REJECTED : VideoModeSwitchResult::FAILED;
+    }
+    
+    void VuforiaEngineWrapper::recordFrameProcessingTime(float processingMs) {
+        if (mVideoModeGovernor.recordFrame(processingMs)) {
+            mControlThread->notify();
+        }
+    }
+    
+    bool VuforiaEngineWrapper::applyPendingVideoMode() {
+        VuCameraVideoModePreset preset = VU_CAMERA_VIDEO_MODE_PRESET_DEFAULT;
+        if (!mVideoModeGovernor.takePendingSwitch(preset)) {
+            return false;
+        }
+        
+        // 失敗時 setCameraVideoMode 已回滾；只有相機拒絕的模式才由調節器標記為不可用
+        const VideoModeSwitchResult result = setCameraVideoMode(preset);
+        mVideoModeGovernor.onSwitchApplied(preset, result);
+        mVideoModeGovernor.resetWindow();
+        return result == VideoModeSwitchResult::APPLIED;
+    }
+    
+    void VuforiaEngineWrapper::checkFrameAllocations(uint64_t allocationCount) {
+        // 前幾幀允許緩衝區擴容（arena 合併、事件緩衝區增長等）
+        static const uint64_t kWarmupFrames = 60;
+        
+        if (++mArenaFrameCount <= kWarmupFrames || allocationCount == 0) {
+            return;
+        }
+        
+        ++mFrameAllocationViolations;
+        LOGE("❌ Frame loop allocated %llu times in steady state (frame %llu, violations %llu)",
+             static_cast<unsigned long long>(allocationCount),
+             static_cast<unsigned long long>(mArenaFrameCount),
+             static_cast<unsigned long long>(mFrameAllocationViolations));
     }
 
     // ==================== 完整的 renderVideoBackgroundWithTexture 函數實現 ====================
@@ -867,38 +1174,61 @@ namespace VuforiaWrapper {
 }
 
     void VuforiaEngineWrapper::processVuforiaState(const VuState* state) {
+        // 同步消費者聲明的像素格式（只在聲明變化時訪問相機控制器）
+        if (mFormatRegistry && mCameraController && mFormatRegistry->needsSync()) {
+            mFormatRegistry->applyPending(mCameraController);
+        }
+        
         // 提取相機幀數據
         if (mFrameExtractor) {
             mFrameExtractor->extractFrameData(state);
         }
         
-        // 提取目標觀察結果
+        // 提取目標觀察結果；追蹤停止時仍提交姿態流與包圍盒表，所有目標標記為失效
         if (mImageTrackingActive) {
             extractTargetObservations(state);
+        } else {
+            getPoseStreamTable().commitFrame(
+                mFrameExtractor ? mFrameExtractor->getLatestFrameSequence() : 0,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            if (mTargetBounds) {
+                mTargetBounds->commitFrame();
+            }
         }
     }
     
     void VuforiaEngineWrapper::extractTargetObservations(const VuState* state) {
-        // 修正：使用專門的 Image Target 觀察獲取函數
-        VuObservationList* observations = nullptr;
-        VuResult result = vuObservationListCreate(&observations);
-        if (result != VU_SUCCESS || observations == nullptr) {
-            return;
+        // 觀察結果對應剛提取的相機幀
+        const uint64_t frameSequence = mFrameExtractor ? mFrameExtractor->getLatestFrameSequence() : 0;
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        
+        // 觀察列表跨幀重用，vuStateGet*Observations 每次都會覆寫列表內容
+        if (mObservationList == nullptr) {
+            VuResult result = vuObservationListCreate(&mObservationList);
+            if (result != VU_SUCCESS || mObservationList == nullptr) {
+                mObservationList = nullptr;
+            }
         }
         
         // 修正：使用 vuStateGetImageTargetObservations 而不是通用的觀察獲取
-        result = vuStateGetImageTargetObservations(state, observations);
-        if (result != VU_SUCCESS) {
-            vuObservationListDestroy(observations);
-            return;
+        // 取不到觀察結果時按空列表處理：姿態流仍要提交本幀，把消失的目標標記為 NO_POSE
+        int32_t numObservations = 0;
+        if (mObservationList != nullptr &&
+            vuStateGetImageTargetObservations(state, mObservationList) == VU_SUCCESS) {
+            vuObservationListGetSize(mObservationList, &numObservations);
         }
         
-        int32_t numObservations = 0;
-        vuObservationListGetSize(observations, &numObservations);
+        // 本幀的觀察結果放在 arena 中，幀結束時一併回收
+        ArenaVector<TargetObservation> frameObservations{ArenaAllocator<TargetObservation>(&mFrameArena)};
+        if (numObservations > 0) {
+            frameObservations.reserve(static_cast<size_t>(numObservations));
+        }
         
         for (int32_t i = 0; i < numObservations; i++) {
             VuObservation* observation = nullptr;
-            vuObservationListGetElement(observations, i, &observation);
+            vuObservationListGetElement(mObservationList, i, &observation);
             if (observation == nullptr) {
                 continue;
             }
@@ -937,14 +1267,159 @@ namespace VuforiaWrapper {
                     continue;
             }
             
-            // 修正：使用正確的矩陣成員名稱和大寫後綴
-            if (mEventManager) {
-                mEventManager->addEvent(targetInfo.name, eventType, poseInfo.pose, 1.0F);
+            // 名稱指向 VuState 內部數據，在本函數返回前使用完畢（只有未登記的 observer 才會讀取）
+            TargetObservation targetObservation;
+            targetObservation.observerId = vuObservationGetObserverId(observation);
+            targetObservation.targetId = -1;
+            targetObservation.targetName = targetInfo.name;
+            targetObservation.eventType = eventType;
+            targetObservation.poseStatus = static_cast<int32_t>(poseInfo.poseStatus);
+            copyMatrix(targetObservation.poseMatrix, poseInfo.pose);
+            targetObservation.bbox = targetInfo.bbox;
+            targetObservation.confidence = 1.0F;
+            frameObservations.push_back(targetObservation);
+        }
+        
+        // 一次加鎖提交整幀的觀察結果，同時解析目標 ID（未解析的目標 ID 為 -1，姿態流忽略）
+        if (mEventManager && !frameObservations.empty()) {
+            mEventManager->addEvents(frameObservations.data(), frameObservations.size());
+        }
+        
+        // 姿態對應相機曝光時刻：樣本以曝光時間記錄，預計顯示時間 = 曝光 + 端到端延遲（capture->swap）。
+        // 不能以當前時間為基準再加端到端延遲，否則曝光到觀察這一段會被重複外推。
+        // 相機時間戳不可用時退回觀察時間，只外推觀察之後的階段（observations->background->swap）
+        const int64_t captureNs = mLatencyTracker.getCaptureTimeNs();
+        if (++mPredictionLeadFrames >= PREDICTION_LEAD_REFRESH_FRAMES) {
+            mPredictionLeadFrames = 0;
+            const LatencySummary endToEnd = mLatencyTracker.getSummary(LatencyMetric::END_TO_END);
+            if (endToEnd.count > 0) {
+                mPredictionLeadNs = static_cast<int64_t>(endToEnd.p50 * 1e6f);
+            }
+            const LatencySummary toBackground = mLatencyTracker.getSummary(LatencyMetric::OBSERVATIONS_TO_BACKGROUND);
+            const LatencySummary toSwap = mLatencyTracker.getSummary(LatencyMetric::BACKGROUND_TO_SWAP);
+            if (toBackground.count > 0 && toSwap.count > 0) {
+                mDisplayLeadNs = static_cast<int64_t>((toBackground.p50 + toSwap.p50) * 1e6f);
+            }
+        }
+        const int64_t sampleTimeNs = captureNs > 0 ? captureNs : nowNs;
+        const int64_t displayTimeNs = captureNs > 0 ? captureNs + mPredictionLeadNs : nowNs + mDisplayLeadNs;
+        for (const TargetObservation& targetObservation : frameObservations) {
+            mPoseExtrapolator.addSample(targetObservation.targetId, targetObservation.poseStatus,
+                                        targetObservation.poseMatrix, sampleTimeNs);
+        }
+        mPoseExtrapolator.predict(displayTimeNs);
+        
+        // 事件只在狀態變化時分發，姿態流則每幀原地更新所有觀察到的目標（外推後的姿態），
+        // 沒有觀察到的目標在提交時標記為 NO_POSE
+        PoseStreamTable& poseStream = getPoseStreamTable();
+        for (const TargetObservation& targetObservation : frameObservations) {
+            VuMatrix44F predictedPose;
+            int64_t predictedTimeNs = sampleTimeNs;
+            float confidence = 0.0f;
+            if (!mPoseExtrapolator.getPredicted(targetObservation.targetId, predictedPose,
+                                                predictedTimeNs, confidence)) {
+                copyMatrix(predictedPose, targetObservation.poseMatrix);
+                predictedTimeNs = sampleTimeNs;
             }
+            poseStream.write(targetObservation.targetId, targetObservation.poseStatus,
+                             predictedPose, predictedTimeNs, frameSequence);
         }
+        poseStream.commitFrame(frameSequence, nowNs);
         
-        // 清理資源
-        vuObservationListDestroy(observations);
+        // 正在追蹤的目標寫入本幀快照（觀察到的原始姿態，與快照中的相機矩陣同屬一幀）
+        if (mPendingSnapshot != nullptr) {
+            for (const TargetObservation& targetObservation : frameObservations) {
+                const uint32_t index = mPendingSnapshot->targetCount;
+                if (index >= TRACKING_SNAPSHOT_MAX_TARGETS) {
+                    break;
+                }
+                if (targetObservation.poseStatus != VU_OBSERVATION_POSE_STATUS_TRACKED &&
+                    targetObservation.poseStatus != VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED) {
+                    continue;
+                }
+                mPendingSnapshot->targetIds[index] = targetObservation.targetId;
+                mPendingSnapshot->poseStatus[index] = targetObservation.poseStatus;
+                memcpy(&mPendingSnapshot->poses[index * 16], targetObservation.poseMatrix.data,
+                       sizeof(targetObservation.poseMatrix.data));
+                mPendingSnapshot->targetCount = index + 1;
+            }
+        }
+        
+        // 記錄姿態與包圍盒，供 ROI 裁剪按需投影
+        if (mTargetBounds) {
+            for (const TargetObservation& targetObservation : frameObservations) {
+                const bool tracked = (targetObservation.eventType == TargetEventType::TARGET_FOUND ||
+                                      targetObservation.eventType == TargetEventType::TARGET_EXTENDED_TRACKING);
+                mTargetBounds->update(targetObservation.targetId, targetObservation.poseMatrix,
+                                      targetObservation.bbox, frameSequence, tracked);
+            }
+            // 不在本幀觀察列表中的目標不再提供包圍盒，ROI 不會裁剪到過期位置
+            mTargetBounds->commitFrame();
+        }
+    }
+    
+    void VuforiaEngineWrapper::publishTrackingSnapshot(const VuState* state) {
+        TrackingSnapshot* snapshot = mPendingSnapshot;
+        mPendingSnapshot = nullptr;
+        if (snapshot == nullptr) {
+            return;
+        }
+        
+        VuRenderState renderState;
+        if (vuStateGetRenderState(state, &renderState) != VU_SUCCESS) {
+            mTrackingSnapshots.abortWrite();
+            return;
+        }
+        copyMatrix(snapshot->projectionMatrix, renderState.projectionMatrix);
+        copyMatrix(snapshot->viewMatrix, renderState.viewMatrix);
+        snapshot->frameSequence = mFrameExtractor ? mFrameExtractor->getLatestFrameSequence() : 0;
+        snapshot->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        
+        // 發佈後快照不再修改；舊快照在最後一個讀者釋放後才會被重用
+        mTrackingSnapshots.commitWrite();
+    }
+    
+    std::vector<TargetEvent> VuforiaEngineWrapper::getDetectedTargets() {
+        std::vector<TargetEvent> targets;
+        TrackingSnapshotGuard snapshot = acquireTrackingSnapshot();
+        if (!snapshot) {
+            return targets;
+        }
+        
+        targets.resize(snapshot->targetCount);
+        for (uint32_t i = 0; i < snapshot->targetCount; ++i) {
+            TargetEvent& target = targets[i];
+            target.targetId = snapshot->targetIds[i];
+            target.eventType = snapshot->poseStatus[i] == VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED ?
+                               TargetEventType::TARGET_EXTENDED_TRACKING : TargetEventType::TARGET_FOUND;
+            memcpy(target.poseMatrix.data, &snapshot->poses[i * 16], sizeof(target.poseMatrix.data));
+            target.timestampNs = snapshot->timestampNs;
+            target.confidence = 1.0F;
+        }
+        return targets;
+    }
+    
+    VuMatrix44F VuforiaEngineWrapper::getProjectionMatrix() const {
+        VuMatrix44F matrix;
+        TrackingSnapshotGuard snapshot = acquireTrackingSnapshot();
+        if (snapshot) {
+            copyMatrix(matrix, snapshot->projectionMatrix);
+        } else {
+            setIdentityMatrix(matrix);
+        }
+        return matrix;
+    }
+    
+    VuMatrix44F VuforiaEngineWrapper::getViewMatrix() const {
+        VuMatrix44F matrix;
+        TrackingSnapshotGuard snapshot = acquireTrackingSnapshot();
+        if (snapshot) {
+            copyMatrix(matrix, snapshot->viewMatrix);
+        } else {
+            setIdentityMatrix(matrix);
+        }
+        return matrix;
     }
     
     bool VuforiaEngineWrapper::checkVuResult(VuResult result, const char* operation) const {
@@ -991,11 +1466,27 @@ namespace VuforiaWrapper {
     
     void VuforiaEngineWrapper::setTargetCallback(JNIEnv* env, jobject callback) {
         if (env != nullptr && callback != nullptr) {
-            env->GetJavaVM(&mJVM);
-            if (mTargetCallback != nullptr) {
-                env->DeleteGlobalRef(mTargetCallback);
+            // 回調方法 ID 按 TargetEventBatchCallback 接口緩存，其他類型的對象無法分發
+            const JniRegistry& jni = getJniRegistry();
+            if (jni.targetCallbackClass != nullptr &&
+                env->IsInstanceOf(callback, jni.targetCallbackClass) == JNI_FALSE) {
+                LOGE("❌ Target callback does not implement TargetEventBatchCallback");
+                return;
             }
+            env->GetJavaVM(&mJVM);
+            jobject previousCallback = mTargetCallback;
             mTargetCallback = env->NewGlobalRef(callback);
+            if (mEventManager) {
+                mEventManager->resendTargetNames();
+            }
+            // setCallback 等待進行中的分發結束，之後舊引用不再被使用
+            if (mEventDispatcher) {
+                mEventDispatcher->setCallback(mTargetCallback);
+                mEventDispatcher->start(mJVM);
+            }
+            if (previousCallback != nullptr) {
+                env->DeleteGlobalRef(previousCallback);
+            }
             LOGI("Target detection callback set");
         }
     }
@@ -1041,6 +1532,102 @@ namespace VuforiaWrapper {
         }
         return false;
     }
+    
+    CameraFrameExtractor::FrameReadGuard VuforiaEngineWrapper::acquireCameraFrame(uint64_t lastSeenSequence) const {
+        if (mFrameExtractor) {
+            return mFrameExtractor->acquireLatestFrame(lastSeenSequence);
+        }
+        return CameraFrameExtractor::FrameReadGuard();
+    }
+    
+    std::shared_ptr<const LumaPyramid> VuforiaEngineWrapper::getCameraLumaPyramid() {
+        if (mFrameExtractor) {
+            return mFrameExtractor->getLatestLumaPyramid();
+        }
+        return nullptr;
+    }
+    
+    uint64_t VuforiaEngineWrapper::getLatestCameraFrameSequence() const {
+        if (mFrameExtractor) {
+            return mFrameExtractor->getLatestFrameSequence();
+        }
+        return 0;
+    }
+    
+    int VuforiaEngineWrapper::leaseCameraFrame(uint64_t lastSeenSequence) {
+        if (mFrameExtractor) {
+            return mCameraFrameLeases.acquire(*mFrameExtractor, lastSeenSequence);
+        }
+        return -1;
+    }
+    
+    void VuforiaEngineWrapper::setCameraLumaPyramidLevels(int levels) {
+        if (mFrameExtractor) {
+            mFrameExtractor->setLumaPyramidLevels(levels);
+        }
+    }
+    
+    bool VuforiaEngineWrapper::requestCameraFormat(VuImagePixelFormat format) {
+        return mFormatRegistry && mFormatRegistry->requestFormat(format);
+    }
+    
+    void VuforiaEngineWrapper::releaseCameraFormat(VuImagePixelFormat format) {
+        if (mFormatRegistry) {
+            mFormatRegistry->releaseFormat(format);
+        }
+    }
+    
+    bool VuforiaEngineWrapper::getTargetCropRect(const std::string& targetName, float padding, CropRect& rect) {
+        if (!mFrameExtractor || !mTargetBounds) {
+            return false;
+        }
+        
+        TargetBoundsTable::Entry target;
+        const int32_t targetId = mEventManager ? mEventManager->findTarget(targetName.c_str()) : -1;
+        if (!mTargetBounds->find(targetId, target)) {
+            return false;
+        }
+        // 姿態必須與投影用的視圖矩陣、內參同屬一幀；最新幀已前進而目標尚未更新時不投影
+        CameraFrameExtractor::FrameReadGuard frame = mFrameExtractor->acquireLatestFrame(0);
+        if (!frame || frame.sequence() != target.frameSequence) {
+            return false;
+        }
+        return projectTargetCrop(*frame, target.pose, target.bbox, padding, rect);
+    }
+    
+    bool VuforiaEngineWrapper::getTargetSubView(const std::string& targetName, float padding, CameraSubView& view) {
+        if (!mFrameExtractor || !mTargetBounds) {
+            return false;
+        }
+        
+        TargetBoundsTable::Entry target;
+        const int32_t targetId = mEventManager ? mEventManager->findTarget(targetName.c_str()) : -1;
+        if (!mTargetBounds->find(targetId, target)) {
+            return false;
+        }
+        CameraFrameExtractor::FrameReadGuard frame = mFrameExtractor->acquireLatestFrame(0);
+        if (!frame || frame.sequence() != target.frameSequence) {
+            return false;
+        }
+        
+        // 姿態、矩形與子視圖都屬於同一幀，keepAlive 保證緩衝區在使用期間有效
+        CropRect rect;
+        if (!projectTargetCrop(*frame, target.pose, target.bbox, padding, rect)) {
+            return false;
+        }
+        return makeCameraSubView(*frame, rect, view);
+    }
+    
+    bool VuforiaEngineWrapper::getCameraImage(VuImagePixelFormat format, FormatImageView& view) {
+        if (!mFrameExtractor || !mFormatRegistry) {
+            return false;
+        }
+        CameraFrameExtractor::FrameReadGuard frame = mFrameExtractor->acquireLatestFrame(0);
+        if (!frame) {
+            return false;
+        }
+        return mFormatRegistry->getImage(*frame, format, view);
+    }
 
     // ==================== 渲染循环控制方法实现 ====================
     
@@ -1049,6 +1636,7 @@ namespace VuforiaWrapper {
         
         if (mRenderingLoopActive) {
             LOGW("Rendering loop already active");
+            mFrameScheduler.start();
             return true;
         }
         
@@ -1064,6 +1652,11 @@ namespace VuforiaWrapper {
         LOGI("Starting rendering loop...");
         mRenderingLoopActive = true;
         
+        // 渲染線程的 vsync 節拍只在這裡啟動一次
+        if (!mFrameScheduler.start()) {
+            LOGW("⚠️ Frame scheduler failed to start, waitForNextFrame will not pace frames");
+        }
+        
         // 在Vuforia 11.x中，渲染循环通常由引擎内部管理
         // 这里主要是设置状态标志和确保相机激活
         mCameraActive = true;
@@ -1073,6 +1666,9 @@ namespace VuforiaWrapper {
     }
     
     void VuforiaEngineWrapper::stopRenderingLoop() {
+        // 無論循環標誌如何都停止節拍線程；之後 waitForNextFrame 立即返回 false
+        mFrameScheduler.stop();
+        
         std::lock_guard<std::mutex> lock(mEngineMutex);
         
         if (!mRenderingLoopActive) {
@@ -1216,8 +1812,47 @@ namespace VuforiaWrapper {
         status << "Target Observers: " << mImageTargetObservers.size() << "\n";
         
         if (mEventManager) {
-            status << "Pending Events: " << mEventManager->getEventCount() << "\n";
+            static const char* const kQueueModeNames[] = {"drop-newest", "drop-oldest", "latest-state"};
+            status << "Pending Events: " << mEventManager->getEventCount()
+                   << " / " << mEventManager->getQueueCapacity()
+                   << " (" << kQueueModeNames[static_cast<int>(mEventManager->getQueueMode())]
+                   << "), high-water " << mEventManager->getHighWaterMark() << "\n";
+            status << "Dropped Events: " << mEventManager->getDroppedOldestCount() << " oldest, "
+                   << mEventManager->getDroppedNewestCount() << " newest, "
+                   << mEventManager->getSupersededCount() << " superseded\n";
+            if (mEventDispatcher) {
+                status << "Event Dispatcher: " << mEventDispatcher->getStatus() << "\n";
+            }
+            status << "Suppressed Events: " << mEventManager->getSuppressedCount()
+                   << " flaps, " << mEventManager->getCoalescedCount() << " coalesced\n";
+        }
+        
+        {
+            TrackingSnapshotGuard snapshot = acquireTrackingSnapshot();
+            status << "Tracking Snapshot: ";
+            if (snapshot) {
+                status << "frame " << snapshot->frameSequence << ", " << snapshot->targetCount << " targets";
+            } else {
+                status << "none";
+            }
+            status << ", skipped " << mTrackingSnapshots.getDroppedFrameCount() << "\n";
+        }
+        
+        status << "Frame Pacing: " << mFrameScheduler.getStatus() << "\n";
+        status << "Frame Arena: " << mFrameArena.getCapacity() << " bytes, peak "
+               << mFrameArena.getHighWaterMark() << " bytes, overflows "
+               << mFrameArena.getOverflowCount() << "\n";
+        if (FrameAllocationScope::isEnabled()) {
+            status << "Frame Allocation Violations: " << mFrameAllocationViolations << "\n";
+        }
+        if (mFormatRegistry) {
+            status << mFormatRegistry->getStatus();
         }
+        status << "Video Mode: " << VideoModeGovernor::presetName(mVideoModeGovernor.getActivePreset())
+               << (mVideoModeGovernor.isEnabled() ? " (governed)" : " (fixed)") << "\n";
+        status << "Pose Prediction: " << (mPoseExtrapolator.isEnabled() ? "on" : "off")
+               << ", lead " << std::fixed << std::setprecision(1) << mPredictionLeadNs / 1e6
+               << " ms from capture (" << mDisplayLeadNs / 1e6 << " ms from observation)\n";
         
         return status.str();
     }
@@ -1376,10 +2011,8 @@ namespace VuforiaWrapper {
         bool hasPermission = false;
         try {
             // 检查相机权限
+            jmethodID checkPermissionMethod = getJniRegistry().contextCheckSelfPermission;
             if (gAndroidContext != nullptr) {
-                jclass contextClass = env->GetObjectClass(gAndroidContext);
-                jmethodID checkPermissionMethod = env->GetMethodID(contextClass, "checkSelfPermission", "(Ljava/lang/String;)I");
-                
                 if (checkPermissionMethod != nullptr) {
                     jstring cameraPermission = env->NewStringUTF("android.permission.CAMERA");
                     jint result = env->CallIntMethod(gAndroidContext, checkPermissionMethod, cameraPermission);
@@ -1390,7 +2023,6 @@ namespace VuforiaWrapper {
                     
                     env->DeleteLocalRef(cameraPermission);
                 }
-                env->DeleteLocalRef(contextClass);
             }
         } catch (...) {
             LOGE("Exception during permission check");
@@ -1554,19 +2186,22 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setAndroidCon
     LOGI("setAndroidContextNative called");
     
     if (context != nullptr) {
-        jclass contextClass = env->GetObjectClass(context);
-        jmethodID getClassMethod = env->GetMethodID(contextClass, "getClass", "()Ljava/lang/Class;");
-        jobject classObj = env->CallObjectMethod(context, getClassMethod);
-        jclass classClass = env->GetObjectClass(classObj);
-        jmethodID getNameMethod = env->GetMethodID(classClass, "getName", "()Ljava/lang/String;");
-        jstring className = (jstring)env->CallObjectMethod(classObj, getNameMethod);
-        const char* classNameStr = env->GetStringUTFChars(className, nullptr);
+        const VuforiaWrapper::JniRegistry& jni = VuforiaWrapper::getJniRegistry();
         
-        LOGI("📋 Context class: %s", classNameStr);
+        // 類名只用於日誌
+        jclass contextClass = env->GetObjectClass(context);
+        if (jni.classGetName != nullptr) {
+            jstring className = (jstring)env->CallObjectMethod(contextClass, jni.classGetName);
+            if (className != nullptr) {
+                const char* classNameStr = env->GetStringUTFChars(className, nullptr);
+                LOGI("📋 Context class: %s", classNameStr);
+                env->ReleaseStringUTFChars(className, classNameStr);
+                env->DeleteLocalRef(className);
+            }
+        }
         
         // ✅ 修復 JNI 布爾值比較
-        jclass activityClass = env->FindClass("android/app/Activity");
-        if (env->IsInstanceOf(context, activityClass) != 0u) {  // ✅ 添加 != 0u
+        if (jni.activityClass != nullptr && env->IsInstanceOf(context, jni.activityClass) != 0u) {  // ✅ 添加 != 0u
             LOGI("✅ Context is Activity instance");
         } else {
             LOGE("❌ Context is NOT Activity instance");
@@ -1582,12 +2217,7 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setAndroidCon
         LOGI("✅ Android context set successfully");
         
         // 清理
-        env->ReleaseStringUTFChars(className, classNameStr);
-        env->DeleteLocalRef(className);
-        env->DeleteLocalRef(classObj);
-        env->DeleteLocalRef(classClass);
         env->DeleteLocalRef(contextClass);
-        env->DeleteLocalRef(activityClass);
     } else {
         LOGE("❌ Android context is null");
     }
@@ -1662,15 +2292,349 @@ Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitializa
     return (status > 0) ? JNI_TRUE : JNI_FALSE;
 }
 
-/*
+// 以下三個方法與 VuforiaCoreManager 的實現一致，直接轉發
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_initVuforiaEngineNative(
+    JNIEnv* env, jobject thiz, jstring license_key) {
+    
+    return Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initVuforiaEngineNative(
+        env, thiz, license_key);
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_getVuforiaVersionNative(
+    JNIEnv* env, jobject thiz) {
+    
+    return Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getVuforiaVersionNative(env, thiz);
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_setAndroidContextNative(
     JNIEnv* env, jobject thiz, jobject context) {
     
     LOGI("VuforiaInitialization setAndroidContextNative called");
-    // 可以和 VuforiaCoreManager 的實現一樣
+    Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setAndroidContextNative(env, thiz, context);
+}
+
+// ==================== 相機幀 DirectByteBuffer 導出 ====================
+// Java 通過 acquire / release 顯式租借郵箱槽位，租借期間槽位不會被回收
+// frameInfo 佈局：[sequence, timestamp, width, height, stride, format, bufferSize]
+
+static const jsize kCameraFrameInfoLength = 7;
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_acquireCameraFrameNative(
+    JNIEnv* env, jobject thiz, jlong last_seen_sequence, jlongArray frame_info) {
+    
+    try {
+        VuforiaWrapper::VuforiaEngineWrapper& wrapper = VuforiaWrapper::getInstance();
+        int handle = wrapper.leaseCameraFrame(static_cast<uint64_t>(last_seen_sequence));
+        if (handle < 0) {
+            return -1;
+        }
+        
+        VuforiaWrapper::CameraFrameLeaseInfo info;
+        if (!wrapper.getCameraFrameLeases().getInfo(handle, info)) {
+            wrapper.getCameraFrameLeases().release(handle);
+            return -1;
+        }
+        
+        if (frame_info != nullptr && env->GetArrayLength(frame_info) >= kCameraFrameInfoLength) {
+            jlong values[kCameraFrameInfoLength] = {
+                static_cast<jlong>(info.sequence),
+                static_cast<jlong>(info.timestamp),
+                static_cast<jlong>(info.width),
+                static_cast<jlong>(info.height),
+                static_cast<jlong>(info.stride),
+                static_cast<jlong>(info.format),
+                static_cast<jlong>(info.bufferSize)
+            };
+            env->SetLongArrayRegion(frame_info, 0, kCameraFrameInfoLength, values);
+        }
+        return handle;
+    } catch (const std::exception& e) {
+        LOGE("❌ Error in acquireCameraFrameNative: %s", e.what());
+        return -1;
+    }
+}
+
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getCameraFrameBufferNative(
+    JNIEnv* env, jobject thiz, jint handle) {
+    
+    VuforiaWrapper::CameraFrameLeaseInfo info;
+    if (!VuforiaWrapper::getInstance().getCameraFrameLeases().getInfo(handle, info) ||
+        info.buffer == nullptr || info.bufferSize == 0) {
+        return nullptr;
+    }
+    
+    // 直接包裝相機緩衝區，不做拷貝；Java 端只能在 release 之前讀取
+    return env->NewDirectByteBuffer(const_cast<uint8_t*>(info.buffer),
+                                    static_cast<jlong>(info.bufferSize));
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_releaseCameraFrameNative(
+    JNIEnv* env, jobject thiz, jint handle) {
+    
+    bool released = VuforiaWrapper::getInstance().getCameraFrameLeases().release(handle);
+    return released ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatestCameraFrameSequenceNative(
+    JNIEnv* env, jobject thiz) {
+    
+    return static_cast<jlong>(VuforiaWrapper::getInstance().getLatestCameraFrameSequence());
+}
+
+// ==================== 相機像素格式聲明 ====================
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_requestCameraFormatNative(
+    JNIEnv* env, jobject thiz, jint format) {
+    
+    bool requested = VuforiaWrapper::getInstance().requestCameraFormat(static_cast<VuImagePixelFormat>(format));
+    return requested ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_releaseCameraFormatNative(
+    JNIEnv* env, jobject thiz, jint format) {
+    
+    VuforiaWrapper::getInstance().releaseCameraFormat(static_cast<VuImagePixelFormat>(format));
+}
+
+// ==================== 目標 ROI 裁剪 ====================
+// rect 佈局：[x, y, width, height]（相機圖像像素座標）
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getTargetCropRectNative(
+    JNIEnv* env, jobject thiz, jstring targetName, jfloat padding, jintArray rect) {
+    
+    if (targetName == nullptr || rect == nullptr || env->GetArrayLength(rect) < 4) {
+        return JNI_FALSE;
+    }
+    
+    try {
+        const char* nameChars = env->GetStringUTFChars(targetName, nullptr);
+        if (nameChars == nullptr) {
+            return JNI_FALSE;
+        }
+        std::string name(nameChars);
+        env->ReleaseStringUTFChars(targetName, nameChars);
+        
+        VuforiaWrapper::CropRect cropRect;
+        if (!VuforiaWrapper::getInstance().getTargetCropRect(name, padding, cropRect)) {
+            return JNI_FALSE;
+        }
+        
+        const jint values[4] = {cropRect.x, cropRect.y, cropRect.width, cropRect.height};
+        env->SetIntArrayRegion(rect, 0, 4, values);
+        return JNI_TRUE;
+    } catch (const std::exception& e) {
+        LOGE("Exception in getTargetCropRectNative: %s", e.what());
+        return JNI_FALSE;
+    }
+}
+
+// ==================== 目標事件遲滯 ====================
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetEventHysteresisNative(
+    JNIEnv* env, jobject thiz, jint frames, jint milliseconds) {
+    
+    VuforiaWrapper::TargetEventManager* eventManager = VuforiaWrapper::getInstance().getEventManager();
+    if (eventManager != nullptr) {
+        eventManager->setHysteresis(static_cast<uint32_t>(std::max(frames, 1)),
+                                    static_cast<uint32_t>(std::max(milliseconds, 0)));
+    }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetEventQueuePolicyNative(
+    JNIEnv* env, jobject thiz, jint mode, jint capacity) {
+    
+    if (mode < static_cast<jint>(VuforiaWrapper::EventQueueMode::DROP_NEWEST) ||
+        mode > static_cast<jint>(VuforiaWrapper::EventQueueMode::LATEST_STATE_ONLY)) {
+        LOGE("❌ Invalid target event queue mode: %d", mode);
+        return;
+    }
+    VuforiaWrapper::TargetEventManager* eventManager = VuforiaWrapper::getInstance().getEventManager();
+    if (eventManager != nullptr) {
+        eventManager->setQueuePolicy(static_cast<VuforiaWrapper::EventQueueMode>(mode),
+                                     static_cast<size_t>(std::max(capacity, 1)));
+    }
+}
+
+// ==================== 連續姿態流 ====================
+
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getPoseStreamBufferNative(
+    JNIEnv* env, jobject thiz) {
+    
+    // 進程級內存，Java 端只需獲取一次並長期持有
+    VuforiaWrapper::PoseStreamTable& table = VuforiaWrapper::getPoseStreamTable();
+    return env->NewDirectByteBuffer(table.data(), static_cast<jlong>(table.size()));
+}
+
+extern "C" JNIEXPORT jfloatArray JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getModelMatrixNative(
+    JNIEnv* env, jobject thiz) {
+    
+    // 兼容接口：返回第一個正在追蹤的目標姿態；每幀讀取應使用姿態流，避免分配
+    const VuforiaWrapper::PoseStreamTable& table = VuforiaWrapper::getPoseStreamTable();
+    const uint32_t count = table.getTargetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t poseStatus = 0;
+        VuMatrix44F pose;
+        int64_t timestampNs = 0;
+        uint64_t frameSequence = 0;
+        if (!table.read(static_cast<int32_t>(i), poseStatus, pose, timestampNs, frameSequence) ||
+            (poseStatus != VU_OBSERVATION_POSE_STATUS_TRACKED &&
+             poseStatus != VU_OBSERVATION_POSE_STATUS_EXTENDED_TRACKED)) {
+            continue;
+        }
+        jfloatArray result = env->NewFloatArray(16);
+        if (result != nullptr) {
+            env->SetFloatArrayRegion(result, 0, 16, pose.data);
+        }
+        return result;
+    }
+    return nullptr;
+}
+
+// ==================== 追蹤快照 ====================
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getTrackingSnapshotNative(
+    JNIEnv* env, jobject thiz, jfloatArray matrices, jintArray targetIds, jintArray poseStatus,
+    jlongArray frameInfo) {
+    
+    // 數組由調用者預先分配並跨幀重用，這裡只做區段複製
+    if (matrices == nullptr || targetIds == nullptr || poseStatus == nullptr || frameInfo == nullptr ||
+        env->GetArrayLength(matrices) < 32 || env->GetArrayLength(frameInfo) < 2) {
+        return -1;
+    }
+    
+    VuforiaWrapper::VuforiaEngineWrapper::TrackingSnapshotGuard snapshot =
+        VuforiaWrapper::getInstance().acquireTrackingSnapshot();
+    if (!snapshot) {
+        return -1;
+    }
+    
+    // 放不下的目標截斷，返回實際寫入的數量
+    const jsize poseCapacity = (env->GetArrayLength(matrices) - 32) / 16;
+    const jsize count = std::min({static_cast<jsize>(snapshot->targetCount), poseCapacity,
+                                  env->GetArrayLength(targetIds), env->GetArrayLength(poseStatus)});
+    
+    env->SetFloatArrayRegion(matrices, 0, 16, snapshot->projectionMatrix.data);
+    env->SetFloatArrayRegion(matrices, 16, 16, snapshot->viewMatrix.data);
+    if (count > 0) {
+        env->SetFloatArrayRegion(matrices, 32, count * 16, snapshot->poses);
+        env->SetIntArrayRegion(targetIds, 0, count, snapshot->targetIds);
+        env->SetIntArrayRegion(poseStatus, 0, count, snapshot->poseStatus);
+    }
+    const jlong info[2] = {
+        static_cast<jlong>(snapshot->frameSequence),
+        static_cast<jlong>(snapshot->timestampNs)
+    };
+    env->SetLongArrayRegion(frameInfo, 0, 2, info);
+    return count;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setPoseExtrapolationEnabledNative(
+    JNIEnv* env, jobject thiz, jboolean enabled) {
+    
+    VuforiaWrapper::getInstance().setPoseExtrapolationEnabled(enabled == JNI_TRUE);
+}
+
+// ==================== 視頻模式調節器 ====================
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setVideoModeGovernorEnabledNative(
+    JNIEnv* env, jobject thiz, jboolean enabled) {
+    
+    VuforiaWrapper::getInstance().getVideoModeGovernor().setEnabled(enabled == JNI_TRUE);
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getVideoModeGovernorReportNative(
+    JNIEnv* env, jobject thiz) {
+    
+    try {
+        std::string report = VuforiaWrapper::getInstance().getVideoModeGovernor().getReport();
+        return env->NewStringUTF(report.c_str());
+    } catch (const std::exception& e) {
+        LOGE("Exception in getVideoModeGovernorReportNative: %s", e.what());
+        return env->NewStringUTF("Error getting video mode governor report");
+    }
+}
+
+// ==================== 延遲統計查詢 ====================
+// stats 佈局：每個區間 5 個值 [count, p50, p90, p99, max]（毫秒），
+// 區間順序與 LatencyMetric 相同
+
+extern "C" JNIEXPORT jfloatArray JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatencyStatsNative(
+    JNIEnv* env, jobject thiz) {
+    
+    using VuforiaWrapper::LatencyMetric;
+    static const jsize kValuesPerMetric = 5;
+    const jsize metricCount = static_cast<jsize>(LatencyMetric::COUNT);
+    
+    const VuforiaWrapper::FrameLatencyTracker& tracker = VuforiaWrapper::getInstance().getLatencyTracker();
+    jfloat values[kValuesPerMetric * static_cast<size_t>(LatencyMetric::COUNT)];
+    for (jsize i = 0; i < metricCount; ++i) {
+        VuforiaWrapper::LatencySummary summary = tracker.getSummary(static_cast<LatencyMetric>(i));
+        values[i * kValuesPerMetric + 0] = static_cast<jfloat>(summary.count);
+        values[i * kValuesPerMetric + 1] = summary.p50;
+        values[i * kValuesPerMetric + 2] = summary.p90;
+        values[i * kValuesPerMetric + 3] = summary.p99;
+        values[i * kValuesPerMetric + 4] = summary.max;
+    }
+    
+    jfloatArray result = env->NewFloatArray(kValuesPerMetric * metricCount);
+    if (result != nullptr) {
+        env->SetFloatArrayRegion(result, 0, kValuesPerMetric * metricCount, values);
+    }
+    return result;
+}
+
+extern "C" JNIEXPORT jintArray JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatencyHistogramNative(
+    JNIEnv* env, jobject thiz, jint metric) {
+    
+    using VuforiaWrapper::FrameLatencyTracker;
+    if (metric < 0 || metric >= static_cast<jint>(VuforiaWrapper::LatencyMetric::COUNT)) {
+        return nullptr;
+    }
+    
+    uint32_t counts[FrameLatencyTracker::BUCKET_COUNT];
+    VuforiaWrapper::getInstance().getLatencyTracker().getHistogram(
+        static_cast<VuforiaWrapper::LatencyMetric>(metric), counts);
+    
+    jint values[FrameLatencyTracker::BUCKET_COUNT];
+    for (size_t i = 0; i < FrameLatencyTracker::BUCKET_COUNT; ++i) {
+        values[i] = static_cast<jint>(counts[i]);
+    }
+    
+    const jsize length = static_cast<jsize>(FrameLatencyTracker::BUCKET_COUNT);
+    jintArray result = env->NewIntArray(length);
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, length, values);
+    }
+    return result;
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatencyReportNative(
+    JNIEnv* env, jobject thiz) {
+    
+    std::string report = VuforiaWrapper::getInstance().getLatencyTracker().getReport();
+    return env->NewStringUTF(report.c_str());
 }
-*/
 
 // ==================== 全局相机权限检查函数 ====================
 
@@ -1740,9 +2704,95 @@ Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getPermission
 
 // ==================== Vuforia Engine 生命周期函数 ====================
 
+// ==================== Native 方法註冊表 ====================
+// 由 JNI_OnLoad 通過 RegisterNatives 綁定；新增 native 方法時需同步加入此表，
+// 名稱與簽名必須與 Java 端聲明一致（沒有 Java 聲明的導出函數不能加入）
 
+namespace VuforiaWrapper {
 
+    bool registerWrapperNatives(JNIEnv* env, jclass coreManagerClass, jclass initializationClass) {
+        static const JNINativeMethod kCoreManagerMethods[] = {
+            {"setAssetManagerNative", "(Ljava/lang/Object;)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setAssetManagerNative)},
+            {"setTargetDetectionCallbackNative", "(Ljava/lang/Object;)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetDetectionCallbackNative)},
+            {"renderFrameNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_renderFrameNative)},
+            {"loadImageTargetsNative", "(Ljava/lang/String;)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_loadImageTargetsNative)},
+            {"getVuforiaVersionNative", "()Ljava/lang/String;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getVuforiaVersionNative)},
+            {"setAndroidContextNative", "(Ljava/lang/Object;)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setAndroidContextNative)},
+            {"initRenderingNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initRenderingNative)},
+            {"loadGLBModelNative", "(Ljava/lang/String;)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_loadGLBModelNative)},
+            {"initVuforiaEngineNative", "(Ljava/lang/String;)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_initVuforiaEngineNative)},
+            {"acquireCameraFrameNative", "(J[J)I",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_acquireCameraFrameNative)},
+            {"getCameraFrameBufferNative", "(I)Ljava/nio/ByteBuffer;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getCameraFrameBufferNative)},
+            {"releaseCameraFrameNative", "(I)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_releaseCameraFrameNative)},
+            {"getLatestCameraFrameSequenceNative", "()J",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatestCameraFrameSequenceNative)},
+            {"requestCameraFormatNative", "(I)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_requestCameraFormatNative)},
+            {"releaseCameraFormatNative", "(I)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_releaseCameraFormatNative)},
+            {"getTargetCropRectNative", "(Ljava/lang/String;F[I)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getTargetCropRectNative)},
+            {"getPoseStreamBufferNative", "()Ljava/nio/ByteBuffer;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getPoseStreamBufferNative)},
+            {"getModelMatrixNative", "()[F",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getModelMatrixNative)},
+            {"setTargetEventHysteresisNative", "(II)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetEventHysteresisNative)},
+            {"setTargetEventQueuePolicyNative", "(II)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setTargetEventQueuePolicyNative)},
+            {"getTrackingSnapshotNative", "([F[I[I[J)I",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getTrackingSnapshotNative)},
+            {"setPoseExtrapolationEnabledNative", "(Z)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setPoseExtrapolationEnabledNative)},
+            {"setVideoModeGovernorEnabledNative", "(Z)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_setVideoModeGovernorEnabledNative)},
+            {"getVideoModeGovernorReportNative", "()Ljava/lang/String;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getVideoModeGovernorReportNative)},
+            {"getLatencyStatsNative", "()[F",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatencyStatsNative)},
+            {"getLatencyHistogramNative", "(I)[I",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatencyHistogramNative)},
+            {"getLatencyReportNative", "()Ljava/lang/String;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_VuforiaCoreManager_getLatencyReportNative)},
+        };
 
+        static const JNINativeMethod kInitializationMethods[] = {
+            {"initVuforiaEngineNative", "(Ljava/lang/String;)Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_initVuforiaEngineNative)},
+            {"deinitVuforiaEngineNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_deinitVuforiaEngineNative)},
+            {"pauseVuforiaEngineNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_pauseVuforiaEngineNative)},
+            {"resumeVuforiaEngineNative", "()V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_resumeVuforiaEngineNative)},
+            {"isVuforiaInitializedNative", "()Z",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_isVuforiaInitializedNative)},
+            {"getVuforiaVersionNative", "()Ljava/lang/String;",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_getVuforiaVersionNative)},
+            {"setAndroidContextNative", "(Ljava/lang/Object;)V",
+             reinterpret_cast<void*>(Java_com_example_ibm_1ai_1weather_1art_1android_initialization_VuforiaInitialization_setAndroidContextNative)},
+        };
 
-
-
+        bool registered = registerNativeMethods(env, coreManagerClass, kCoreManagerMethods,
+                                                sizeof(kCoreManagerMethods) / sizeof(kCoreManagerMethods[0]),
+                                                "VuforiaCoreManager (wrapper)");
+        if (initializationClass != nullptr) {
+            registered = registerNativeMethods(env, initializationClass, kInitializationMethods,
+                                               sizeof(kInitializationMethods) / sizeof(kInitializationMethods[0]),
+                                               "VuforiaInitialization") && registered;
+        }
+        return registered;
+    }
+}
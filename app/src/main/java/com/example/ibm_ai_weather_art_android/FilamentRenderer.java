@@ -6,6 +6,7 @@ import android.view.SurfaceView;
 import android.util.Log;
 import android.os.Handler;
 import android.os.Looper;
+import java.nio.ByteBuffer;
 
 import com.google.android.filament.Engine;
 import com.google.android.filament.EntityManager;
@@ -36,6 +37,7 @@ public class FilamentRenderer {
     private boolean isRendering = false;
     private Handler renderHandler;
     private Context context;
+    private long lastCameraFrameSequence = 0;
 
     public FilamentRenderer(Context context) {
         this.context = context;
@@ -143,11 +145,17 @@ public class FilamentRenderer {
 
     /**
      * ⭐ 用於接收 Vuforia 相機數據的方法
+     * cameraData 是 VuforiaCoreManager.CameraFrame 的 DirectByteBuffer，
+     * 只在該幀 close() 之前有效，上傳紋理時直接讀取，不要保留引用
      */
-    public void updateCameraTexture(byte[] cameraData, int width, int height) {
+    public void updateCameraTexture(ByteBuffer cameraData, int width, int height, int stride, long sequence) {
         // 這個方法用於接收 Vuforia 的相機數據並作為背景紋理
         // 具體實現需要創建紋理並應用到背景材質上
-        Log.d(TAG, "📷 Received camera data: " + width + "x" + height);
+        if (sequence <= lastCameraFrameSequence) {
+            return;
+        }
+        lastCameraFrameSequence = sequence;
+        Log.d(TAG, "📷 Received camera frame #" + sequence + ": " + width + "x" + height + " stride " + stride);
     }
     
     /**
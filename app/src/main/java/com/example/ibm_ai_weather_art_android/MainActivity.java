@@ -103,6 +103,7 @@ public class MainActivity extends AppCompatActivity implements GLSurfaceView.Ren
             glSurfaceView.setRenderer(this); // MainActivity 實現 GLSurfaceView.Renderer
             
             // ✅ 關鍵修復：改回 CONTINUOUSLY 連續渲染模式
+            // GL 線程是唯一的渲染驅動，幀率由 renderFrameSafely 中的 vsync 節拍控制
             glSurfaceView.setRenderMode(GLSurfaceView.RENDERMODE_CONTINUOUSLY);
             
             // 將 GLSurfaceView 添加到容器
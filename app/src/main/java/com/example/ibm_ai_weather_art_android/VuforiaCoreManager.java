@@ -2,7 +2,12 @@ package com.example.ibm_ai_weather_art_android;
 
 import android.content.Context;
 import android.util.Log;
+import java.io.File;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+import java.util.Arrays;
 import android.os.Handler;
 import android.view.Surface;
 import android.view.SurfaceView;
@@ -30,14 +35,20 @@ public class VuforiaCoreManager {
     private boolean vuforiaReady = false;
         // OpenGL 渲染相關
     private native boolean initializeOpenGLResourcesNative();
+    // 著色器程序二進制緩存目錄（必須已存在），需在 initializeOpenGLResourcesNative 之前設置
+    private native void setShaderCacheDirectoryNative(String directory);
     private native boolean setupVideoBackgroundRenderingNative();
     private native boolean validateRenderingSetupNative();
     private native void renderFrameWithVideoBackgroundNative();
     
+    // 幀節拍：阻塞到下一個 vsync（按目標幀率取整），超時或節拍停止時返回 false
+    private native boolean waitForNextFrameNative();
+    private native void setTargetFrameRateNative(int fps);
+    private native int[] getFrameTimeHistogramNative();
+    
     // Surface 管理相關
     private native void onSurfaceChangedNative(int width, int height);
     // 🔧 添加：渲染相關變量
-    private Thread renderingThread;
     private volatile boolean isRenderingActive = false;
     
     // 回調接口
@@ -47,6 +58,82 @@ public class VuforiaCoreManager {
         void onTargetTracking(String targetName, float[] modelViewMatrix);
     }
     
+    // 目標事件類型（與 native TargetEventType 一致）
+    public static final int TARGET_EVENT_FOUND = 0;
+    public static final int TARGET_EVENT_TRACKING = 1;
+    public static final int TARGET_EVENT_LOST = 2;
+    public static final int TARGET_EVENT_EXTENDED_TRACKING = 3;
+    
+    /**
+     * 每幀一次的批次目標事件回調（渲染線程調用）
+     * 數組由 native 層跨幀重用，只在回調期間有效，需要保留時請複製
+     */
+    public interface TargetEventBatchCallback {
+        /**
+         * 目標登記時發送一次的名稱表，ids[i] 對應 names[i]
+         */
+        void onTargetNamesRegistered(int[] ids, String[] names);
+        
+        /**
+         * @param count 本批事件數量，只有前 count 個元素有效
+         * @param targetIds 目標 ID（見 onTargetNamesRegistered）
+         * @param eventTypes TARGET_EVENT_* 常量
+         * @param timestampsNanos 事件時間，與 System.nanoTime() 同一時基
+         * @param poses 每個事件 16 個 float 的姿態矩陣（列主序），第 i 個從 i * 16 開始
+         */
+        void onTargetEventBatch(int count, int[] targetIds, int[] eventTypes,
+                                long[] timestampsNanos, float[] poses);
+    }
+    
+    /**
+     * 把批次事件拆成逐個 TargetDetectionCallback 調用的適配器
+     */
+    public static class TargetDetectionAdapter implements TargetEventBatchCallback {
+        private final TargetDetectionCallback callback;
+        private final ArrayList<String> names = new ArrayList<>();
+        
+        public TargetDetectionAdapter(TargetDetectionCallback callback) {
+            this.callback = callback;
+        }
+        
+        @Override
+        public void onTargetNamesRegistered(int[] ids, String[] names) {
+            for (int i = 0; i < ids.length; i++) {
+                while (this.names.size() <= ids[i]) {
+                    this.names.add(null);
+                }
+                this.names.set(ids[i], names[i]);
+            }
+        }
+        
+        @Override
+        public void onTargetEventBatch(int count, int[] targetIds, int[] eventTypes,
+                                       long[] timestampsNanos, float[] poses) {
+            for (int i = 0; i < count; i++) {
+                int id = targetIds[i];
+                String name = (id >= 0 && id < names.size()) ? names.get(id) : null;
+                if (name == null) {
+                    continue;
+                }
+                switch (eventTypes[i]) {
+                    case TARGET_EVENT_FOUND:
+                        callback.onTargetFound(name);
+                        break;
+                    case TARGET_EVENT_LOST:
+                        callback.onTargetLost(name);
+                        break;
+                    case TARGET_EVENT_TRACKING:
+                    case TARGET_EVENT_EXTENDED_TRACKING:
+                        // 批次數組會被重用，逐個回調的接收者可能保留矩陣，因此複製
+                        callback.onTargetTracking(name, Arrays.copyOfRange(poses, i * 16, i * 16 + 16));
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+    
     public interface InitializationCallback {
         void onVuforiaInitialized(boolean success);
     }
@@ -56,6 +143,7 @@ public class VuforiaCoreManager {
     }
     
     private TargetDetectionCallback targetCallback;
+    private TargetEventBatchCallback targetEventBatchCallback;
     private InitializationCallback initializationCallback;
     private ModelLoadingCallback modelLoadingCallback;
     
@@ -142,6 +230,369 @@ public class VuforiaCoreManager {
     private native String getEngineStatusDetailNative();
     private native String getMemoryUsageNative();
     
+    // ==================== 相機幀零拷貝導出 ====================
+    private native int acquireCameraFrameNative(long lastSeenSequence, long[] frameInfo);
+    private native ByteBuffer getCameraFrameBufferNative(int handle);
+    private native boolean releaseCameraFrameNative(int handle);
+    private native long getLatestCameraFrameSequenceNative();
+    
+    // ==================== 相機像素格式聲明 ====================
+    // 只有被聲明的格式才會在相機註冊；相機不支持時由 native 端按幀轉換
+    private native boolean requestCameraFormatNative(int format);
+    private native void releaseCameraFormatNative(int format);
+    
+    // 與 VuImagePixelFormat 相同的值
+    public static final int PIXEL_FORMAT_GRAYSCALE = 0x4;
+    public static final int PIXEL_FORMAT_RGB888 = 0x3;
+    public static final int PIXEL_FORMAT_RGBA8888 = 0x5;
+    public static final int PIXEL_FORMAT_NV21 = 0x6;
+    public static final int PIXEL_FORMAT_NV12 = 0x7;
+    
+    /**
+     * 聲明需要某個相機像素格式（引用計數，與 releaseCameraFormat 成對調用）
+     */
+    public boolean requestCameraFormat(int format) {
+        return libraryLoaded && requestCameraFormatNative(format);
+    }
+    
+    public void releaseCameraFormat(int format) {
+        if (libraryLoaded) {
+            releaseCameraFormatNative(format);
+        }
+    }
+    
+    // ==================== 目標 ROI 裁剪 ====================
+    private native boolean getTargetCropRectNative(String targetName, float padding, int[] rect);
+    
+    /**
+     * 目標在最新相機幀中的裁剪矩形，配合 acquireCameraFrame 只處理目標附近的像素
+     * @param padding 邊距，相對矩形尺寸的比例（0.1 = 每邊擴展 10%）
+     * @return [x, y, width, height]（相機圖像像素座標），目標未追蹤時返回 null
+     */
+    public int[] getTargetCropRect(String targetName, float padding) {
+        if (!libraryLoaded || targetName == null) {
+            return null;
+        }
+        int[] rect = new int[4];
+        return getTargetCropRectNative(targetName, padding, rect) ? rect : null;
+    }
+    
+    // ==================== 視頻模式調節器 ====================
+    private native void setVideoModeGovernorEnabledNative(boolean enabled);
+    private native String getVideoModeGovernorReportNative();
+    
+    /**
+     * 啟用 / 停用根據幀處理時間自動切換相機視頻模式（默認啟用）
+     */
+    public void setVideoModeGovernorEnabled(boolean enabled) {
+        if (libraryLoaded) {
+            setVideoModeGovernorEnabledNative(enabled);
+        }
+    }
+    
+    /**
+     * 可用視頻模式、當前模式與切換決定日誌
+     */
+    public String getVideoModeGovernorReport() {
+        return libraryLoaded ? getVideoModeGovernorReportNative() : "Native library not loaded";
+    }
+    
+    // ==================== 延遲統計 ====================
+    // 每個區間 5 個值 [count, p50, p90, p99, max]（毫秒），區間順序：
+    // capture->state, state->observations, observations->background, background->swap, capture->swap
+    private native float[] getLatencyStatsNative();
+    private native int[] getLatencyHistogramNative(int metric);
+    private native String getLatencyReportNative();
+    
+    public static final int LATENCY_CAPTURE_TO_STATE = 0;
+    public static final int LATENCY_STATE_TO_OBSERVATIONS = 1;
+    public static final int LATENCY_OBSERVATIONS_TO_BACKGROUND = 2;
+    public static final int LATENCY_BACKGROUND_TO_SWAP = 3;
+    public static final int LATENCY_END_TO_END = 4;
+    
+    /**
+     * 相機到畫面延遲統計，見 getLatencyStatsNative 的數組佈局
+     */
+    public float[] getLatencyStats() {
+        return libraryLoaded ? getLatencyStatsNative() : null;
+    }
+    
+    /**
+     * 指定區間的滾動直方圖桶計數
+     */
+    public int[] getLatencyHistogram(int metric) {
+        return libraryLoaded ? getLatencyHistogramNative(metric) : null;
+    }
+    
+    public String getLatencyReport() {
+        return libraryLoaded ? getLatencyReportNative() : "Native library not loaded";
+    }
+    
+    // ==================== 幀節拍 ====================
+    
+    /**
+     * 渲染線程的目標幀率，按整數個 vsync 取整（120Hz 面板上 60 = 每 2 個 vsync 一幀）
+     * @param fps 0 表示每個 vsync 渲染一幀（默認）
+     */
+    public void setTargetFrameRate(int fps) {
+        if (libraryLoaded) {
+            setTargetFrameRateNative(fps);
+        }
+    }
+    
+    /**
+     * 相鄰幀開始時間間隔的直方圖桶計數，桶上界（毫秒）：
+     * 7.5, 9.5, 12, 17.5, 25, 34, 50.5, 67.5, 100, 200, 其餘
+     */
+    public int[] getFrameTimeHistogram() {
+        return libraryLoaded ? getFrameTimeHistogramNative() : null;
+    }
+    
+    /**
+     * 租借中的相機幀 - buffer 直接指向 native 幀緩衝區（DirectByteBuffer，無拷貝）
+     * 讀取完畢必須調用 close() 歸還，之後 buffer 不可再使用
+     */
+    public final class CameraFrame implements AutoCloseable {
+        public final long sequence;
+        public final long timestamp;
+        public final int width;
+        public final int height;
+        public final int stride;
+        public final int format;
+        private final int handle;
+        private ByteBuffer buffer;
+        
+        private CameraFrame(int handle, long[] info, ByteBuffer buffer) {
+            this.handle = handle;
+            this.sequence = info[0];
+            this.timestamp = info[1];
+            this.width = (int) info[2];
+            this.height = (int) info[3];
+            this.stride = (int) info[4];
+            this.format = (int) info[5];
+            this.buffer = buffer;
+        }
+        
+        public ByteBuffer getBuffer() {
+            return buffer;
+        }
+        
+        /**
+         * 是否已有更新的幀（本幀已過期）
+         */
+        public boolean isStale() {
+            return getLatestCameraFrameSequenceNative() > sequence;
+        }
+        
+        @Override
+        public void close() {
+            if (buffer != null) {
+                buffer = null;
+                releaseCameraFrameNative(handle);
+            }
+        }
+    }
+    
+    private final long[] cameraFrameInfo = new long[7];
+    
+    /**
+     * 租借最新相機幀
+     * @param lastSeenSequence 上一次處理的幀序號，沒有更新的幀時返回 null
+     */
+    public synchronized CameraFrame acquireCameraFrame(long lastSeenSequence) {
+        if (!libraryLoaded) {
+            return null;
+        }
+        int handle = acquireCameraFrameNative(lastSeenSequence, cameraFrameInfo);
+        if (handle < 0) {
+            return null;
+        }
+        ByteBuffer buffer = getCameraFrameBufferNative(handle);
+        if (buffer == null) {
+            releaseCameraFrameNative(handle);
+            return null;
+        }
+        return new CameraFrame(handle, cameraFrameInfo, buffer);
+    }
+    
+    // ==================== 連續姿態流 ====================
+    private native ByteBuffer getPoseStreamBufferNative();
+    
+    // 與 VuObservationPoseStatus 相同的值，0 表示從未觀察到
+    public static final int POSE_STATUS_NONE = 0;
+    public static final int POSE_STATUS_NO_POSE = 1;
+    public static final int POSE_STATUS_LIMITED = 2;
+    public static final int POSE_STATUS_TRACKED = 3;
+    public static final int POSE_STATUS_EXTENDED_TRACKED = 4;
+    
+    /**
+     * native 姿態共享表的只讀視圖（佈局見 PoseStreamTable.h）
+     * 每幀由渲染線程原地更新，讀取不經過 JNI、不分配對象；槽位索引即目標 ID
+     * （見 TargetEventBatchCallback.onTargetNamesRegistered）
+     */
+    public static final class PoseStream {
+        private static final int MAGIC = 0x50534554;
+        private static final int VERSION = 1;
+        private static final int HEADER_SIZE = 64;
+        private static final int OFFSET_CAPACITY = 8;
+        private static final int OFFSET_SLOT_SIZE = 12;
+        private static final int OFFSET_TARGET_COUNT = 16;
+        private static final int OFFSET_FRAME_SEQUENCE = 24;
+        private static final int SLOT_SEQUENCE = 0;
+        private static final int SLOT_STATUS = 4;
+        private static final int SLOT_TIMESTAMP = 8;
+        private static final int SLOT_FRAME_SEQUENCE = 16;
+        private static final int SLOT_POSE = 24;
+        private static final int MAX_READ_RETRIES = 8;
+        
+        // ByteBuffer 讀取沒有內存序保證；ART 上 volatile 讀寫會生成內存屏障，
+        // 用來分隔序號與字段的讀取（minSdk 24 沒有 VarHandle 可用）
+        private static volatile int sFence;
+        
+        private final ByteBuffer buffer;
+        private final int capacity;
+        private final int slotSize;
+        
+        private PoseStream(ByteBuffer buffer) {
+            this.buffer = buffer.order(ByteOrder.nativeOrder());
+            this.capacity = this.buffer.getInt(OFFSET_CAPACITY);
+            this.slotSize = this.buffer.getInt(OFFSET_SLOT_SIZE);
+        }
+        
+        private static PoseStream wrap(ByteBuffer buffer) {
+            if (buffer == null) {
+                return null;
+            }
+            PoseStream stream = new PoseStream(buffer);
+            if (stream.buffer.getInt(0) != MAGIC || stream.buffer.getInt(4) != VERSION) {
+                Log.e(TAG, "Pose stream layout mismatch");
+                return null;
+            }
+            return stream;
+        }
+        
+        private static void loadFence() {
+            sFence = sFence + 1;
+        }
+        
+        /**
+         * 已使用的槽位數（最大目標 ID + 1）
+         */
+        public int getTargetCount() {
+            loadFence();
+            return Math.min(buffer.getInt(OFFSET_TARGET_COUNT), capacity);
+        }
+        
+        /**
+         * 最近一次更新對應的相機幀序號，可用來判斷是否有新姿態
+         */
+        public long getFrameSequence() {
+            loadFence();
+            return buffer.getLong(OFFSET_FRAME_SEQUENCE);
+        }
+        
+        /**
+         * 一致地讀取一個目標的最新姿態
+         * 本幀沒有觀察到的目標返回 POSE_STATUS_NO_POSE，姿態與幀序號保留最後一次觀察的值
+         * @param outPose 至少 16 個元素，寫入列主序姿態矩陣
+         * @param outInfo 至少 2 個元素：[0] 姿態時間（System.nanoTime 時基），[1] 相機幀序號
+         * @return POSE_STATUS_* 常量；目標 ID 無效或與寫入持續衝突時返回 -1
+         */
+        public int readPose(int targetId, float[] outPose, long[] outInfo) {
+            if (targetId < 0 || targetId >= getTargetCount()) {
+                return -1;
+            }
+            int base = HEADER_SIZE + targetId * slotSize;
+            for (int attempt = 0; attempt < MAX_READ_RETRIES; attempt++) {
+                int before = buffer.getInt(base + SLOT_SEQUENCE);
+                if ((before & 1) != 0) {
+                    continue;
+                }
+                loadFence();
+                int status = buffer.getInt(base + SLOT_STATUS);
+                long timestamp = buffer.getLong(base + SLOT_TIMESTAMP);
+                long frameSequence = buffer.getLong(base + SLOT_FRAME_SEQUENCE);
+                for (int i = 0; i < 16; i++) {
+                    outPose[i] = buffer.getFloat(base + SLOT_POSE + i * 4);
+                }
+                loadFence();
+                if (buffer.getInt(base + SLOT_SEQUENCE) == before) {
+                    outInfo[0] = timestamp;
+                    outInfo[1] = frameSequence;
+                    return status;
+                }
+            }
+            return -1;
+        }
+    }
+    
+    private native void setPoseExtrapolationEnabledNative(boolean enabled);
+    
+    /**
+     * 啟用 / 停用姿態外推（默認啟用）
+     * 啟用時姿態流中的姿態已按相機到顯示的延遲外推，時間戳為預計顯示時間
+     */
+    public void setPoseExtrapolationEnabled(boolean enabled) {
+        if (libraryLoaded) {
+            setPoseExtrapolationEnabledNative(enabled);
+        }
+    }
+    
+    private PoseStream poseStream;
+    
+    /**
+     * 取得姿態共享表（獲取一次後長期持有即可）
+     */
+    public synchronized PoseStream getPoseStream() {
+        if (poseStream == null && libraryLoaded) {
+            poseStream = PoseStream.wrap(getPoseStreamBufferNative());
+        }
+        return poseStream;
+    }
+    
+    // ==================== 追蹤快照 ====================
+    private native int getTrackingSnapshotNative(float[] matrices, int[] targetIds, int[] poseStatus, long[] frameInfo);
+    
+    /**
+     * 單幀追蹤快照 - 同一幀的相機矩陣與所有正在追蹤的目標姿態
+     * 數組預先分配，可跨幀重複傳給 readTrackingSnapshot，讀取不分配對象
+     */
+    public static final class TrackingSnapshot {
+        public static final int MAX_TARGETS = 32;
+        
+        // [0, 16) 投影矩陣，[16, 32) 視圖矩陣，之後每個目標 16 個 float（列主序）
+        public final float[] matrices = new float[32 + MAX_TARGETS * 16];
+        public final int[] targetIds = new int[MAX_TARGETS];
+        public final int[] poseStatus = new int[MAX_TARGETS];   // POSE_STATUS_TRACKED / EXTENDED_TRACKED
+        private final long[] frameInfo = new long[2];
+        
+        public int targetCount;
+        public long frameSequence;     // 相機幀序號
+        public long timestampNs;       // System.nanoTime 時基
+        
+        public int getPoseOffset(int index) {
+            return 32 + index * 16;
+        }
+    }
+    
+    /**
+     * 讀取最新一幀的追蹤快照到 out（不經過引擎鎖，任意線程可調用）
+     * @return 尚無快照時返回 false
+     */
+    public boolean readTrackingSnapshot(TrackingSnapshot out) {
+        if (!libraryLoaded || out == null) {
+            return false;
+        }
+        int count = getTrackingSnapshotNative(out.matrices, out.targetIds, out.poseStatus, out.frameInfo);
+        if (count < 0) {
+            return false;
+        }
+        out.targetCount = count;
+        out.frameSequence = out.frameInfo[0];
+        out.timestampNs = out.frameInfo[1];
+        return true;
+    }
+    
     // ==================== 相机权限检查方法 ====================
     private boolean mPermissionChecked = false;
     
@@ -615,8 +1066,9 @@ public class VuforiaCoreManager {
                 return false;
             }
             
-            // 設置目標檢測回調
-            setTargetDetectionCallbackNative(new TargetDetectionCallback() {
+            // 設置目標檢測回調：已設置批次回調時直接接收批次，否則經適配器逐個分發
+            setTargetDetectionCallbackNative(targetEventBatchCallback != null ? targetEventBatchCallback
+                    : new TargetDetectionAdapter(new TargetDetectionCallback() {
                 @Override
                 public void onTargetFound(String targetName) {
                     Log.d(TAG, "🎯 Target found: " + targetName);
@@ -634,7 +1086,7 @@ public class VuforiaCoreManager {
                     Log.d(TAG, "📡 Target tracking: " + targetName);
                     handleTargetTracking(targetName, modelViewMatrix);
                 }
-            });
+            }));
             
             // ✅ 安全地嘗試啟動目標檢測
             try {
@@ -747,6 +1199,7 @@ public class VuforiaCoreManager {
         
         try {
             // 1. 初始化 OpenGL 資源
+            configureShaderCache();
             boolean glInit = initializeOpenGLResourcesNative();
             Log.d(TAG, "OpenGL initialized: " + glInit);
             
@@ -780,30 +1233,10 @@ public class VuforiaCoreManager {
         
         isRenderingActive = true;
         
-        // 創建渲染線程
-        if (renderingThread == null || !renderingThread.isAlive()) {
-            renderingThread = new Thread(() -> {
-                Log.d(TAG, "📸 Vuforia rendering thread started");
-                
-                while (isRenderingActive && isVuforiaEngineRunningNative()) {
-                    try {
-                        // ⭐ 關鍵：持續調用 Vuforia 渲染
-                        renderFrameWithVideoBackgroundNative();
-                        Thread.sleep(16); // 60 FPS
-                    } catch (InterruptedException e) {
-                        Log.d(TAG, "Rendering thread interrupted");
-                        break;
-                    } catch (Exception e) {
-                        Log.e(TAG, "Rendering error: " + e.getMessage());
-                        // 繼續運行，不要停止
-                    }
-                }
-                
-                Log.d(TAG, "📸 Vuforia rendering thread stopped");
-            });
-            
-            renderingThread.start();
-        }
+        // native 渲染循環負責啟動 vsync 節拍。實際繪製只由 GLSurfaceView 的 GL 線程
+        // （onDrawFrame → renderFrameSafely）完成，它持有 EGL 上下文，並在每幀開始前等待節拍；
+        // 這裡不再另開線程調用 native 渲染
+        startRenderingLoopNative();
     }
     
     private boolean isVuforiaRunning() {
@@ -892,11 +1325,50 @@ public class VuforiaCoreManager {
         }
     }
     
+    // ==================== 目標事件遲滯 ====================
+    private native void setTargetEventHysteresisNative(int frames, int milliseconds);
+    
+    /**
+     * 目標狀態變化需連續出現 frames 幀或持續 milliseconds 毫秒才發出事件（默認 3 幀 / 100ms）
+     * 抑制目標在畫面邊緣反覆 found / lost；frames 為 1 時停用
+     */
+    public void setTargetEventHysteresis(int frames, int milliseconds) {
+        if (libraryLoaded) {
+            setTargetEventHysteresisNative(frames, milliseconds);
+        }
+    }
+    
+    // ==================== 目標事件隊列 ====================
+    public static final int EVENT_QUEUE_DROP_NEWEST = 0;
+    public static final int EVENT_QUEUE_DROP_OLDEST = 1;
+    public static final int EVENT_QUEUE_LATEST_STATE_ONLY = 2;
+    
+    private native void setTargetEventQueuePolicyNative(int mode, int capacity);
+    
+    /**
+     * 設置目標事件隊列的模式與容量（默認 DROP_OLDEST / 256）
+     * LATEST_STATE_ONLY 每個目標只保留最新一個未分發事件，適合長時間無人值守運行
+     * @param capacity 1..256，LATEST_STATE_ONLY 時忽略
+     */
+    public void setTargetEventQueuePolicy(int mode, int capacity) {
+        if (libraryLoaded) {
+            setTargetEventQueuePolicyNative(mode, capacity);
+        }
+    }
+    
     // ==================== 設置回調方法 ====================
     public void setTargetDetectionCallback(TargetDetectionCallback callback) {
         this.targetCallback = callback;
     }
     
+    /**
+     * 設置批次目標事件回調（需在 startTargetDetection 之前調用）
+     * 設置後不再經過 TargetDetectionCallback 逐個分發
+     */
+    public void setTargetEventBatchCallback(TargetEventBatchCallback callback) {
+        this.targetEventBatchCallback = callback;
+    }
+    
     public void setInitializationCallback(InitializationCallback callback) {
         this.initializationCallback = callback;
     }
@@ -948,17 +1420,8 @@ public class VuforiaCoreManager {
         try {
             // 调用native方法停止渲染循环
             stopRenderingLoopNative();
+            // 節拍停止後 GL 線程中的 waitForNextFrameNative 立即返回，不會阻塞 onDrawFrame
             isRenderingActive = false;
-            // 中断Java层的渲染线程（如果存在）
-            if (renderingThread != null && renderingThread.isAlive()) {
-                renderingThread.interrupt();
-                try {
-                    renderingThread.join(1000); // 等待最多1秒
-                } catch (InterruptedException e) {
-                    Log.w(TAG, "Interrupted while stopping rendering thread", e);
-                }
-                renderingThread = null;
-            }
             Log.d(TAG, "✅ Rendering loop stopped successfully");
         } catch (UnsatisfiedLinkError e) {
             Log.e(TAG, "❌ Native method not found: stopRenderingLoopNative", e);
@@ -1052,11 +1515,16 @@ public class VuforiaCoreManager {
     }
 
     /**
-     * 安全渲染方法
+     * 安全渲染方法：只在 GLSurfaceView 的 GL 線程（onDrawFrame）中調用
      */
     public void renderFrameSafely() {
         // ✅ 移除每幀檢查，直接渲染
         try {
+            // 由 native vsync 節拍控制幀率；超時或節拍未運行時照常繪製，
+            // 因為 onDrawFrame 返回後 GLSurfaceView 一定會 swap
+            if (isRenderingActive) {
+                waitForNextFrameNative();
+            }
             // 🔥 關鍵：這會渲染相機背景 + AR 內容  
             renderFrameWithVideoBackgroundNative();
         } catch (Exception e) {
@@ -1144,6 +1612,18 @@ public class VuforiaCoreManager {
     }
 }
 
+    private void configureShaderCache() {
+        if (context == null) {
+            return;
+        }
+        File shaderCacheDir = new File(context.getCacheDir(), "shaders");
+        if (shaderCacheDir.isDirectory() || shaderCacheDir.mkdirs()) {
+            setShaderCacheDirectoryNative(shaderCacheDir.getAbsolutePath());
+        } else {
+            Log.w(TAG, "⚠️ Cannot create shader cache directory, compiling shaders from source");
+        }
+    }
+    
 /**
  * 初始化 OpenGL 資源 - 解決 MainActivity 第261行編譯錯誤
  * 這個方法被 MainActivity.java:261 調用
@@ -1158,7 +1638,8 @@ public class VuforiaCoreManager {
                 return false;
             }
             
-            // 1. 初始化 OpenGL 資源
+            // 1. 初始化 OpenGL 資源（著色器優先從二進制緩存載入）
+            configureShaderCache();
             boolean glResourcesInit = initializeOpenGLResourcesNative();
             Log.d(TAG, "OpenGL resources initialized: " + glResourcesInit);
             